@@ -0,0 +1,92 @@
+// Compares the exact barometric altitude (std::pow) against the polynomial
+// approximation (barometric.h), converting 1M pressures between 300 and
+// 1100 hPa to altitudes, one at a time and as spans.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/barometric.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 1000 * 1000;
+
+const Pressure kSeaLevel = PressureInHectoPascals(1013.25f);
+const Temperature kTemperature = TemperatureDegCelcius(15.0f);
+
+const std::vector<Pressure>& Pressures() {
+  static std::vector<Pressure> pressures = [] {
+    std::vector<Pressure> v(kCount);
+    uint32_t seed = 12345;
+    for (Pressure& p : v) {
+      seed = seed * 1664525 + 1013904223;
+      p = PressureInHectoPascals(300.0f +
+                                 (float)(seed >> 8) * (800.0f / 16777216.0f));
+    }
+    return v;
+  }();
+  return pressures;
+}
+
+void BM_AltitudeExact(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const Pressure& p : Pressures()) {
+      benchmark::DoNotOptimize(
+          AltitudeFromPressure(p, kSeaLevel, kTemperature));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_AltitudeExact);
+
+void BM_AltitudeFast(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const Pressure& p : Pressures()) {
+      benchmark::DoNotOptimize(
+          FastAltitudeFromPressure(p, kSeaLevel, kTemperature));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_AltitudeFast);
+
+void BM_AltitudeExactSpan(benchmark::State& state) {
+  std::vector<Length> out(kCount);
+  for (auto _ : state) {
+    AltitudeFromPressure(
+        QuantitySpan<const Pressure>(Pressures().data(), kCount), kSeaLevel,
+        kTemperature, QuantitySpan<Length>(out.data(), kCount));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_AltitudeExactSpan);
+
+void BM_AltitudeFastSpan(benchmark::State& state) {
+  std::vector<Length> out(kCount);
+  for (auto _ : state) {
+    FastAltitudeFromPressure(
+        QuantitySpan<const Pressure>(Pressures().data(), kCount), kSeaLevel,
+        kTemperature, QuantitySpan<Length>(out.data(), kCount));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_AltitudeFastSpan);
+
+void BM_SeaLevelPressureSpan(benchmark::State& state) {
+  std::vector<Pressure> out(kCount);
+  for (auto _ : state) {
+    SeaLevelPressure(QuantitySpan<const Pressure>(Pressures().data(), kCount),
+                     LengthInMeters(420.0f), kTemperature,
+                     QuantitySpan<Pressure>(out.data(), kCount));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_SeaLevelPressureSpan);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,73 @@
+// Compares lookups in CalibrationTable (binary search) and
+// UniformCalibrationTable (O(1)) (calibration.h), with 33 points, mapping 1M
+// 12-bit ADC readings to voltages.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/calibration.h"
+#include "roo_quantity/voltage.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 1000 * 1000;
+constexpr size_t kPoints = 33;
+
+const std::vector<uint16_t>& Counts() {
+  static std::vector<uint16_t> counts = [] {
+    std::vector<uint16_t> v(kCount);
+    uint32_t seed = 12345;
+    for (uint16_t& c : v) {
+      seed = seed * 1664525 + 1013904223;
+      c = seed >> 20;
+    }
+    return v;
+  }();
+  return counts;
+}
+
+// A mildly nonlinear curve, one point every 128 counts.
+struct Curve {
+  Voltage values[kPoints];
+  CalibrationPoint<Voltage> points[kPoints];
+
+  Curve() {
+    for (size_t i = 0; i < kPoints; ++i) {
+      float x = (float)i / (kPoints - 1);
+      values[i] = VoltageInVolts(3.3f * x * (1.0f + 0.05f * x));
+      points[i] = CalibrationPoint<Voltage>{(float)(i * 128), values[i]};
+    }
+  }
+};
+
+const Curve& GetCurve() {
+  static Curve curve;
+  return curve;
+}
+
+void BM_BinarySearch(benchmark::State& state) {
+  CalibrationTable<Voltage> table(GetCurve().points);
+  std::vector<Voltage> out(kCount);
+  for (auto _ : state) {
+    table.apply(Counts().data(), QuantitySpan<Voltage>(out.data(), kCount));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_BinarySearch)->Unit(benchmark::kMillisecond);
+
+void BM_Uniform(benchmark::State& state) {
+  UniformCalibrationTable<Voltage> table(0.0f, 128.0f, GetCurve().values);
+  std::vector<Voltage> out(kCount);
+  for (auto _ : state) {
+    table.apply(Counts().data(), QuantitySpan<Voltage>(out.data(), kCount));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_Uniform)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,156 @@
+// Measures the compression ratio and the throughput of SeriesEncoder and
+// SeriesDecoder (compression.h) on an hour of synthetic per-second sensor
+// readings: a slowly drifting temperature with sensor noise, a noisy supply
+// voltage, and a barometric pressure. Reports bits per sample, and the ratio
+// against storing each sample as a 64-bit timestamp and a float.
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/compression.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/voltage.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 3600;
+
+// Uniform noise in [-1, 1).
+float Noise(uint32_t& seed) {
+  seed = seed * 1664525 + 1013904223;
+  return (float)(seed >> 8) / 8388608.0f - 1.0f;
+}
+
+// Once a second, with up to 2 ms of jitter.
+const std::vector<roo_time::Uptime>& Timestamps() {
+  static std::vector<roo_time::Uptime> timestamps = [] {
+    std::vector<roo_time::Uptime> v(kCount);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < kCount; ++i) {
+      v[i] = roo_time::Uptime::Start() +
+             roo_time::Micros(i * 1000000 + (int64_t)(1000 * Noise(seed)));
+    }
+    return v;
+  }();
+  return timestamps;
+}
+
+// Quantized to the 0.0625 C resolution of a DS18B20.
+const std::vector<Temperature>& Temperatures() {
+  static std::vector<Temperature> temperatures = [] {
+    std::vector<Temperature> v(kCount);
+    uint32_t seed = 2;
+    for (size_t i = 0; i < kCount; ++i) {
+      float c = 21.0f + 2.0f * std::sin((float)i / 1000.0f) +
+                0.1f * Noise(seed);
+      v[i] = TemperatureDegCelcius(std::round(c * 16.0f) / 16.0f);
+    }
+    return v;
+  }();
+  return temperatures;
+}
+
+const std::vector<Voltage>& Voltages() {
+  static std::vector<Voltage> voltages = [] {
+    std::vector<Voltage> v(kCount);
+    uint32_t seed = 3;
+    for (size_t i = 0; i < kCount; ++i) {
+      v[i] = VoltageInVolts(3.3f + 0.01f * Noise(seed));
+    }
+    return v;
+  }();
+  return voltages;
+}
+
+const std::vector<Pressure>& Pressures() {
+  static std::vector<Pressure> pressures = [] {
+    std::vector<Pressure> v(kCount);
+    uint32_t seed = 4;
+    for (size_t i = 0; i < kCount; ++i) {
+      v[i] = PressureInPascals(101325.0f + 50.0f * std::sin((float)i / 700.0f) +
+                               2.0f * Noise(seed));
+    }
+    return v;
+  }();
+  return pressures;
+}
+
+template <typename Q>
+void Encode(benchmark::State& state, const std::vector<Q>& values,
+            const internal::DeltaType<Q>& resolution) {
+  std::vector<uint8_t> buffer(kCount * 16);
+  size_t size = 0;
+  for (auto _ : state) {
+    SeriesEncoder<Q> encoder(buffer.data(), buffer.size(),
+                             roo_time::Millis(10), resolution);
+    for (size_t i = 0; i < kCount; ++i) {
+      encoder.append(Timestamps()[i], values[i]);
+    }
+    size = encoder.size();
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+  state.counters["bits_per_sample"] = 8.0 * size / kCount;
+  state.counters["ratio"] = 12.0 * kCount / size;
+}
+
+template <typename Q>
+void Decode(benchmark::State& state, const std::vector<Q>& values,
+            const internal::DeltaType<Q>& resolution) {
+  std::vector<uint8_t> buffer(kCount * 16);
+  SeriesEncoder<Q> encoder(buffer.data(), buffer.size(), roo_time::Millis(10),
+                           resolution);
+  for (size_t i = 0; i < kCount; ++i) {
+    encoder.append(Timestamps()[i], values[i]);
+  }
+  std::vector<roo_time::Uptime> t(kCount);
+  std::vector<Q> q(kCount);
+  for (auto _ : state) {
+    SeriesDecoder<Q> decoder(buffer.data(), encoder.size(), encoder.count());
+    benchmark::DoNotOptimize(
+        decoder.next(t.data(), QuantitySpan<Q>(q.data(), kCount)));
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+void BM_EncodeTemperature(benchmark::State& state) {
+  Encode(state, Temperatures(), TemperatureDelta());
+}
+BENCHMARK(BM_EncodeTemperature);
+
+void BM_EncodeVoltage(benchmark::State& state) {
+  Encode(state, Voltages(), Voltage());
+}
+BENCHMARK(BM_EncodeVoltage);
+
+void BM_EncodeVoltageQuantized(benchmark::State& state) {
+  Encode(state, Voltages(), VoltageInMilliVolts(1.0f));
+}
+BENCHMARK(BM_EncodeVoltageQuantized);
+
+void BM_EncodePressure(benchmark::State& state) {
+  Encode(state, Pressures(), Pressure());
+}
+BENCHMARK(BM_EncodePressure);
+
+void BM_EncodePressureQuantized(benchmark::State& state) {
+  Encode(state, Pressures(), PressureInPascals(1.0f));
+}
+BENCHMARK(BM_EncodePressureQuantized);
+
+void BM_DecodeTemperature(benchmark::State& state) {
+  Decode(state, Temperatures(), TemperatureDelta());
+}
+BENCHMARK(BM_DecodeTemperature);
+
+void BM_DecodeVoltage(benchmark::State& state) {
+  Decode(state, Voltages(), Voltage());
+}
+BENCHMARK(BM_DecodeVoltage);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,57 @@
+#include <cmath>
+#include <new>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity.h"
+
+namespace roo_quantity {
+namespace {
+
+// Mimics how quantity classes used to initialize their 'unknown' state.
+struct NanfInitialized {
+  NanfInitialized() : val(std::nanf("")) {}
+  float val;
+};
+
+// A typical sensor record.
+struct SensorRecord {
+  Temperature temperature;
+  Pressure pressure;
+  Voltage battery;
+  Current load;
+};
+
+constexpr size_t kCount = 100000;
+
+void BM_DefaultConstructVectorOfTemperature(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<Temperature> readings(kCount);
+    benchmark::DoNotOptimize(readings.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DefaultConstructVectorOfTemperature);
+
+void BM_DefaultConstructVectorOfNanf(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<NanfInitialized> readings(kCount);
+    benchmark::DoNotOptimize(readings.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DefaultConstructVectorOfNanf);
+
+void BM_DefaultConstructSensorRecords(benchmark::State& state) {
+  static SensorRecord records[kCount];
+  for (auto _ : state) {
+    for (SensorRecord& r : records) new (&r) SensorRecord();
+    benchmark::DoNotOptimize(records);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DefaultConstructSensorRecords);
+
+}  // namespace
+}  // namespace roo_quantity
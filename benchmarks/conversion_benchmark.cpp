@@ -0,0 +1,112 @@
+// Compares the float-only unit conversions against their previous
+// implementations, which promoted to double. On the host, double arithmetic is
+// done in hardware, so the difference shows mostly in the instruction count;
+// run with --benchmark_perf_counters=INSTRUCTIONS (requires libpfm) to see it.
+// On targets without a double-precision FPU (ESP32, ESP8266), the double
+// variants run in software emulation.
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/frequency.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr int kCount = 1024;
+
+float* Celsius() {
+  static float values[kCount];
+  for (int i = 0; i < kCount; ++i) values[i] = -40.0f + 0.125f * i;
+  return values;
+}
+
+void BM_DegFahrenheit(benchmark::State& state) {
+  const float* c = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(TemperatureDegCelcius(c[i]).degFahrenheit());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DegFahrenheit);
+
+void BM_DegFahrenheitDouble(benchmark::State& state) {
+  const float* c = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize((float)(c[i] * 1.8 + 32.0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DegFahrenheitDouble);
+
+void BM_DegKelvin(benchmark::State& state) {
+  const float* c = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(TemperatureDegCelcius(c[i]).degKelvin());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DegKelvin);
+
+void BM_DegKelvinDouble(benchmark::State& state) {
+  const float* c = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize((float)(c[i] + 273.15));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DegKelvinDouble);
+
+void BM_TemperatureDegFahrenheit(benchmark::State& state) {
+  const float* f = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(TemperatureDegFahrenheit(f[i]).degCelcius());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_TemperatureDegFahrenheit);
+
+void BM_TemperatureDegFahrenheitDouble(benchmark::State& state) {
+  const float* f = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize((float)((f[i] - 32.0) / 1.8));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_TemperatureDegFahrenheitDouble);
+
+void BM_RadiansPerSecond(benchmark::State& state) {
+  const float* f = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(FrequencyInHertz(f[i]).inRadiansPerSecond());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_RadiansPerSecond);
+
+void BM_RadiansPerSecondDouble(benchmark::State& state) {
+  const float* f = Celsius();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize((float)(f[i] * 2.0f * M_PI));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_RadiansPerSecondDouble);
+
+}  // namespace
+}  // namespace roo_quantity
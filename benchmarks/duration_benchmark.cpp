@@ -0,0 +1,107 @@
+// Compares the integer conversions between Time and roo_time::Duration against
+// the previous float path (Duration::inSecondsFloat(), and scaling float
+// seconds by 1e6 on the way back). The float path is cheaper on the host, where
+// float division is done in hardware; on targets without an FPU (ESP8266) it
+// runs in software emulation. Accuracy: the float path loses up to a
+// microsecond on every round trip, and its error grows with the magnitude; the
+// integer path rounds correctly.
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/frequency.h"
+#include "roo_quantity/time.h"
+#include "roo_time.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr int kCount = 1024;
+
+const roo_time::Duration* Durations() {
+  static roo_time::Duration values[kCount];
+  uint32_t seed = 12345;
+  for (int i = 0; i < kCount; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    // 0 .. ~70 minutes.
+    values[i] = roo_time::Micros(seed);
+  }
+  return values;
+}
+
+const Time* Times() {
+  static Time values[kCount];
+  const roo_time::Duration* d = Durations();
+  for (int i = 0; i < kCount; ++i) values[i] = d[i];
+  return values;
+}
+
+void BM_TimeFromDuration(benchmark::State& state) {
+  const roo_time::Duration* d = Durations();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(Time(d[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_TimeFromDuration);
+
+void BM_TimeFromDurationFloat(benchmark::State& state) {
+  const roo_time::Duration* d = Durations();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(TimeInSeconds(d[i].inSecondsFloat()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_TimeFromDurationFloat);
+
+void BM_TimeToDuration(benchmark::State& state) {
+  const Time* t = Times();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(t[i].toDuration());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_TimeToDuration);
+
+void BM_TimeToDurationFloat(benchmark::State& state) {
+  const Time* t = Times();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(
+          roo_time::Micros((int64_t)(t[i].inSeconds() * 1000000.0f)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_TimeToDurationFloat);
+
+void BM_FrequencyFromPeriod(benchmark::State& state) {
+  const roo_time::Duration* d = Durations();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(FrequencyFromPeriod(d[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_FrequencyFromPeriod);
+
+void BM_FrequencyFromPeriodViaTime(benchmark::State& state) {
+  const roo_time::Duration* d = Durations();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(1.0f / TimeInSeconds(d[i].inSecondsFloat()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_FrequencyFromPeriodViaTime);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,86 @@
+// Compares FilterBank (filter.h) against one Biquad object per channel, and
+// against a hand-written EMA on raw floats, smoothing many channels of
+// temperature readings. Reports channels x samples per second.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/filter.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kSteps = 1000;
+
+// kSteps consecutive samples of `channels` channels.
+std::vector<Temperature> Readings(size_t channels) {
+  std::vector<Temperature> v(kSteps * channels);
+  uint32_t seed = 12345;
+  for (Temperature& t : v) {
+    seed = seed * 1664525 + 1013904223;
+    t = TemperatureDegCelcius(20.0f + (float)(seed >> 20) * 0.001f);
+  }
+  return v;
+}
+
+BiquadCoefficients Design() {
+  return BiquadLowPass(FrequencyInHertz(1.0f), FrequencyInHertz(50.0f));
+}
+
+void BM_RawEma(benchmark::State& state) {
+  size_t channels = state.range(0);
+  std::vector<Temperature> readings = Readings(channels);
+  std::vector<float> ema(channels, 20.0f);
+  for (auto _ : state) {
+    for (size_t step = 0; step < kSteps; ++step) {
+      const Temperature* in = &readings[step * channels];
+      for (size_t c = 0; c < channels; ++c) {
+        ema[c] += 0.1f * (in[c].degCelcius() - ema[c]);
+      }
+    }
+    benchmark::DoNotOptimize(ema.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kSteps * channels);
+}
+BENCHMARK(BM_RawEma)->Arg(8)->Arg(64)->Arg(256);
+
+void BM_BiquadPerChannel(benchmark::State& state) {
+  size_t channels = state.range(0);
+  std::vector<Temperature> readings = Readings(channels);
+  std::vector<Temperature> out(channels);
+  for (auto _ : state) {
+    std::vector<Biquad<Temperature>> filters(channels,
+                                             Biquad<Temperature>(Design()));
+    for (size_t step = 0; step < kSteps; ++step) {
+      const Temperature* in = &readings[step * channels];
+      for (size_t c = 0; c < channels; ++c) out[c] = filters[c].update(in[c]);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kSteps * channels);
+}
+BENCHMARK(BM_BiquadPerChannel)->Arg(8)->Arg(64)->Arg(256);
+
+template <size_t kChannels>
+void BM_FilterBank(benchmark::State& state) {
+  std::vector<Temperature> readings = Readings(kChannels);
+  Temperature out[kChannels];
+  for (auto _ : state) {
+    FilterBank<Temperature, kChannels> bank(Design());
+    for (size_t step = 0; step < kSteps; ++step) {
+      bank.update(QuantitySpan<const Temperature>(
+                      &readings[step * kChannels], kChannels),
+                  out);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kSteps * kChannels);
+}
+BENCHMARK_TEMPLATE(BM_FilterBank, 8);
+BENCHMARK_TEMPLATE(BM_FilterBank, 64);
+BENCHMARK_TEMPLATE(BM_FilterBank, 256);
+
+}  // namespace
+}  // namespace roo_quantity
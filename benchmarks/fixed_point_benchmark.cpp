@@ -0,0 +1,313 @@
+// Compares the float and fixed-point representations of electrical quantities.
+//
+// On the ESP8266, float arithmetic is emulated in software. To approximate
+// that on the host, the SoftFloat variants route every float operation through
+// a (non-inlined) software implementation of IEEE-754 single precision, similar
+// in structure to the libgcc routines that the compiler calls on FPU-less
+// targets.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/current.h"
+#include "roo_quantity/fixed_point.h"
+#include "roo_quantity/power.h"
+#include "roo_quantity/resistance.h"
+#include "roo_quantity/time.h"
+#include "roo_quantity/voltage.h"
+#include "roo_quantity/work.h"
+
+namespace roo_quantity {
+namespace {
+
+// Minimal software single-precision arithmetic: round to nearest even;
+// subnormals flush to zero; no NaN handling. Sufficient for the finite, normal
+// values used below.
+
+uint32_t Bits(float f) {
+  uint32_t b;
+  memcpy(&b, &f, sizeof(b));
+  return b;
+}
+
+float FromBits(uint32_t b) {
+  float f;
+  memcpy(&f, &b, sizeof(f));
+  return f;
+}
+
+uint32_t Pack(uint32_t sign, int exp, uint32_t mantissa) {
+  if (exp <= 0) return sign;
+  if (exp >= 255) return sign | 0x7F800000u;
+  return sign | ((uint32_t)exp << 23) | (mantissa & 0x7FFFFFu);
+}
+
+__attribute__((noinline)) uint32_t SoftMul(uint32_t a, uint32_t b) {
+  uint32_t sign = (a ^ b) & 0x80000000u;
+  int ea = (a >> 23) & 0xFF;
+  int eb = (b >> 23) & 0xFF;
+  if (ea == 0 || eb == 0) return sign;
+  uint64_t m = (uint64_t)((a & 0x7FFFFFu) | 0x800000u) *
+               ((b & 0x7FFFFFu) | 0x800000u);
+  int exp = ea + eb - 127;
+  int shift = 23;
+  if (m & (1ULL << 47)) {
+    shift = 24;
+    ++exp;
+  }
+  uint64_t rem = m & ((1ULL << shift) - 1);
+  uint64_t half = 1ULL << (shift - 1);
+  m >>= shift;
+  if (rem > half || (rem == half && (m & 1))) {
+    if (++m == (1ULL << 24)) {
+      m >>= 1;
+      ++exp;
+    }
+  }
+  return Pack(sign, exp, (uint32_t)m);
+}
+
+__attribute__((noinline)) uint32_t SoftDiv(uint32_t a, uint32_t b) {
+  uint32_t sign = (a ^ b) & 0x80000000u;
+  int ea = (a >> 23) & 0xFF;
+  int eb = (b >> 23) & 0xFF;
+  if (ea == 0) return sign;
+  if (eb == 0) return sign | 0x7F800000u;
+  uint64_t n = (uint64_t)((a & 0x7FFFFFu) | 0x800000u) << 26;
+  uint64_t d = (b & 0x7FFFFFu) | 0x800000u;
+  uint64_t q = n / d;
+  bool sticky = (n % d) != 0;
+  int exp = ea - eb + 127;
+  int shift = 3;
+  if (q < (1ULL << 26)) {
+    shift = 2;
+    --exp;
+  }
+  uint64_t rem = q & ((1ULL << shift) - 1);
+  uint64_t half = 1ULL << (shift - 1);
+  q >>= shift;
+  if (rem > half || (rem == half && (sticky || (q & 1)))) {
+    if (++q == (1ULL << 24)) {
+      q >>= 1;
+      ++exp;
+    }
+  }
+  return Pack(sign, exp, (uint32_t)q);
+}
+
+__attribute__((noinline)) uint32_t SoftAdd(uint32_t a, uint32_t b) {
+  if ((a & 0x7FFFFFFFu) < (b & 0x7FFFFFFFu)) {
+    uint32_t t = a;
+    a = b;
+    b = t;
+  }
+  int ea = (a >> 23) & 0xFF;
+  int eb = (b >> 23) & 0xFF;
+  if (eb == 0) return a;
+  uint32_t sign = a & 0x80000000u;
+  // Three guard bits.
+  uint32_t ma = ((a & 0x7FFFFFu) | 0x800000u) << 3;
+  uint32_t mb = ((b & 0x7FFFFFu) | 0x800000u) << 3;
+  int d = ea - eb;
+  if (d > 26) {
+    mb = 1;
+  } else if (d > 0) {
+    uint32_t sticky = (mb & ((1u << d) - 1)) != 0;
+    mb = (mb >> d) | sticky;
+  }
+  uint32_t m;
+  if ((a ^ b) & 0x80000000u) {
+    m = ma - mb;
+    if (m == 0) return 0;
+    while (!(m & (1u << 26))) {
+      m <<= 1;
+      --ea;
+    }
+  } else {
+    m = ma + mb;
+    if (m & (1u << 27)) {
+      m = (m >> 1) | (m & 1);
+      ++ea;
+    }
+  }
+  uint32_t guard = m & 7;
+  m >>= 3;
+  if (guard > 4 || (guard == 4 && (m & 1))) {
+    if (++m == (1u << 24)) {
+      m >>= 1;
+      ++ea;
+    }
+  }
+  return Pack(sign, ea, m);
+}
+
+constexpr int kCount = 1024;
+
+struct Readings {
+  Readings() {
+    uint32_t seed = 12345;
+    for (int i = 0; i < kCount; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      int32_t mv = 3000 + (int32_t)(seed >> 23);  // 3 .. 3.5 V.
+      int32_t ma = 1 + (int32_t)((seed >> 8) & 0x3FF);  // 1 .. 1024 mA.
+      voltage.push_back(VoltageInMilliVolts((float)mv));
+      current.push_back(CurrentInMilliAmperes((float)ma));
+      fixed_voltage.push_back(FixedVoltage::FromScaled<-3>(mv));
+      fixed_current.push_back(FixedCurrent::FromScaled<-3>(ma));
+    }
+  }
+
+  std::vector<Voltage> voltage;
+  std::vector<Current> current;
+  std::vector<FixedVoltage> fixed_voltage;
+  std::vector<FixedCurrent> fixed_current;
+};
+
+const Readings& GetReadings() {
+  static Readings readings;
+  return readings;
+}
+
+void BM_PowerFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(r.voltage[i] * r.current[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_PowerFloat);
+
+void BM_PowerSoftFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(PowerInWatts(FromBits(SoftMul(
+          Bits(r.voltage[i].inVolts()), Bits(r.current[i].inAmperes())))));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_PowerSoftFloat);
+
+void BM_PowerFixed(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(r.fixed_voltage[i] * r.fixed_current[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_PowerFixed);
+
+void BM_ResistanceFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(r.voltage[i] / r.current[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ResistanceFloat);
+
+void BM_ResistanceSoftFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(ResistanceInOhms(FromBits(SoftDiv(
+          Bits(r.voltage[i].inVolts()), Bits(r.current[i].inAmperes())))));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ResistanceSoftFloat);
+
+void BM_ResistanceFixed(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(r.fixed_voltage[i] / r.fixed_current[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ResistanceFixed);
+
+// Metering loop: accumulates energy from power samples taken every 10 ms.
+
+void BM_EnergyFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  Time dt = TimeInMilliseconds(10.0f);
+  for (auto _ : state) {
+    Work energy = WorkInJoules(0.0f);
+    for (int i = 0; i < kCount; ++i) {
+      energy += r.voltage[i] * r.current[i] * dt;
+    }
+    benchmark::DoNotOptimize(energy);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_EnergyFloat);
+
+void BM_EnergySoftFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  uint32_t dt = Bits(0.01f);
+  for (auto _ : state) {
+    uint32_t energy = 0;
+    for (int i = 0; i < kCount; ++i) {
+      uint32_t p = SoftMul(Bits(r.voltage[i].inVolts()),
+                           Bits(r.current[i].inAmperes()));
+      energy = SoftAdd(energy, SoftMul(p, dt));
+    }
+    benchmark::DoNotOptimize(energy);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_EnergySoftFloat);
+
+void BM_EnergyFixed(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  FixedTime dt = FixedTime::FromScaled<-3>(10);
+  for (auto _ : state) {
+    FixedWork energy = FixedWork::FromCount(0);
+    for (int i = 0; i < kCount; ++i) {
+      energy += r.fixed_voltage[i] * r.fixed_current[i] * dt;
+    }
+    benchmark::DoNotOptimize(energy);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_EnergyFixed);
+
+void BM_FormatFloat(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  char out[16];
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize((r.voltage[i] * r.current[i]).formatTo(out, 16));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_FormatFloat);
+
+void BM_FormatFixed(benchmark::State& state) {
+  const Readings& r = GetReadings();
+  char out[16];
+  for (auto _ : state) {
+    for (int i = 0; i < kCount; ++i) {
+      benchmark::DoNotOptimize(
+          (r.fixed_voltage[i] * r.fixed_current[i]).formatTo(out, 16));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_FormatFixed);
+
+}  // namespace
+}  // namespace roo_quantity
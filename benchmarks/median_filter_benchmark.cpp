@@ -0,0 +1,111 @@
+// Compares MedianFilter and HampelFilter (median_filter.h) against sorting a
+// copy of the window for every sample, on 100k spiky pressure readings.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/median_filter.h"
+#include "roo_quantity/pressure.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 100 * 1000;
+
+const std::vector<Pressure>& Readings() {
+  static std::vector<Pressure> readings = [] {
+    std::vector<Pressure> v(kCount);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < kCount; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      float pa = 101325.0f + (float)(seed >> 24) * 0.1f;
+      // About 1% spikes.
+      if ((seed & 0xFF) < 3) pa += 5000.0f;
+      v[i] = PressureInPascals(pa);
+    }
+    return v;
+  }();
+  return readings;
+}
+
+template <size_t N>
+void BM_NaiveMedian(benchmark::State& state) {
+  const std::vector<Pressure>& readings = Readings();
+  float window[N];
+  for (auto _ : state) {
+    for (size_t i = N; i <= kCount; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        window[j] = readings[i - N + j].inPascals();
+      }
+      std::sort(window, window + N);
+      benchmark::DoNotOptimize(PressureInPascals(window[N / 2]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK_TEMPLATE(BM_NaiveMedian, 5);
+BENCHMARK_TEMPLATE(BM_NaiveMedian, 9);
+BENCHMARK_TEMPLATE(BM_NaiveMedian, 31);
+BENCHMARK_TEMPLATE(BM_NaiveMedian, 101);
+
+template <size_t N>
+void BM_MedianFilter(benchmark::State& state) {
+  const std::vector<Pressure>& readings = Readings();
+  for (auto _ : state) {
+    MedianFilter<Pressure, N> filter;
+    for (const Pressure& p : readings) {
+      benchmark::DoNotOptimize(filter.update(p));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK_TEMPLATE(BM_MedianFilter, 5);
+BENCHMARK_TEMPLATE(BM_MedianFilter, 9);
+BENCHMARK_TEMPLATE(BM_MedianFilter, 31);
+BENCHMARK_TEMPLATE(BM_MedianFilter, 101);
+
+// Hampel filter that sorts the window, and then the deviations, per sample.
+template <size_t N>
+void BM_NaiveHampel(benchmark::State& state) {
+  const std::vector<Pressure>& readings = Readings();
+  float window[N];
+  float deviations[N];
+  for (auto _ : state) {
+    for (size_t i = N; i <= kCount; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        window[j] = readings[i - N + j].inPascals();
+      }
+      float x = window[N - 1];
+      std::sort(window, window + N);
+      float m = window[N / 2];
+      for (size_t j = 0; j < N; ++j) deviations[j] = std::fabs(window[j] - m);
+      std::sort(deviations, deviations + N);
+      float sigma = 1.4826f * deviations[N / 2];
+      benchmark::DoNotOptimize(
+          PressureInPascals(std::fabs(x - m) > 3.0f * sigma ? m : x));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK_TEMPLATE(BM_NaiveHampel, 7);
+BENCHMARK_TEMPLATE(BM_NaiveHampel, 31);
+
+template <size_t N>
+void BM_HampelFilter(benchmark::State& state) {
+  const std::vector<Pressure>& readings = Readings();
+  for (auto _ : state) {
+    HampelFilter<Pressure, N> filter;
+    for (const Pressure& p : readings) {
+      benchmark::DoNotOptimize(filter.update(p));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK_TEMPLATE(BM_HampelFilter, 7);
+BENCHMARK_TEMPLATE(BM_HampelFilter, 31);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,78 @@
+// Measures the per-pulse cost of recording pulses (what an interrupt handler
+// would do) with PulseCounter and PulsePeriodMeter (pulse_counter.h),
+// compared to computing the frequency with a float division on every pulse.
+// The state is forced to memory after every pulse, as it would be between
+// interrupts.
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/pulse_counter.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr int kPulses = 1000;
+
+// Pulses at roughly 1 kHz, with jitter.
+roo_time::Uptime Timestamp(int i) {
+  return roo_time::Uptime::Start() +
+         roo_time::Micros(1000000 + i * 1000 + (i * 7919) % 37);
+}
+
+void BM_FloatFrequencyPerPulse(benchmark::State& state) {
+  roo_time::Uptime previous = roo_time::Uptime::Start();
+  Frequency frequency;
+  for (auto _ : state) {
+    for (int i = 0; i < kPulses; ++i) {
+      roo_time::Uptime now = Timestamp(i);
+      frequency = FrequencyFromPeriod(now - previous);
+      previous = now;
+      benchmark::DoNotOptimize(frequency);
+      benchmark::DoNotOptimize(previous);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPulses);
+}
+BENCHMARK(BM_FloatFrequencyPerPulse);
+
+void BM_PulseCounter(benchmark::State& state) {
+  PulseCounter counter;
+  for (auto _ : state) {
+    for (int i = 0; i < kPulses; ++i) {
+      counter.pulse();
+      benchmark::DoNotOptimize(counter);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPulses);
+}
+BENCHMARK(BM_PulseCounter);
+
+void BM_PulsePeriodMeter(benchmark::State& state) {
+  PulsePeriodMeter meter;
+  for (auto _ : state) {
+    for (int i = 0; i < kPulses; ++i) {
+      meter.pulse(Timestamp(i));
+      benchmark::DoNotOptimize(meter);
+    }
+    meter.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kPulses);
+}
+BENCHMARK(BM_PulsePeriodMeter);
+
+// The conversion, done once per sample rather than per pulse.
+void BM_SampleFlowRate(benchmark::State& state) {
+  PulsePeriodMeter meter;
+  int i = 0;
+  for (auto _ : state) {
+    meter.pulse(Timestamp(i++));
+    meter.pulse(Timestamp(i));
+    benchmark::DoNotOptimize(meter.sample(Timestamp(i)).flowRate(450.0f));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SampleFlowRate);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,73 @@
+// Measures the insert rate of RollupHistory (rollup_history.h), with three
+// levels (seconds, minutes, hours) of 60 buckets, for sensors sampled at
+// 1 Hz and at 100 Hz, and the cost of querying the hourly view. Reports the
+// memory per channel ("bytes").
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/rollup_history.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+namespace {
+
+using History = RollupHistory<Temperature, 3, 60>;
+
+constexpr size_t kCount = 100000;
+
+History MakeHistory() {
+  return History(
+      {roo_time::Seconds(1), roo_time::Minutes(1), roo_time::Hours(1)});
+}
+
+const std::vector<Temperature>& Temperatures() {
+  static std::vector<Temperature> temperatures = [] {
+    std::vector<Temperature> v(kCount);
+    uint32_t seed = 12345;
+    for (Temperature& t : v) {
+      seed = seed * 1664525 + 1013904223;
+      t = TemperatureDegCelcius(20.0f + (float)(seed >> 8) / 16777216.0f);
+    }
+    return v;
+  }();
+  return temperatures;
+}
+
+void BM_Insert(benchmark::State& state) {
+  int64_t interval_micros = state.range(0);
+  History history = MakeHistory();
+  int64_t micros = 0;
+  for (auto _ : state) {
+    for (const Temperature& t : Temperatures()) {
+      history.add(roo_time::Uptime::Start() + roo_time::Micros(micros), t);
+      micros += interval_micros;
+    }
+    benchmark::DoNotOptimize(history);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+  state.counters["bytes"] = sizeof(History);
+}
+BENCHMARK(BM_Insert)->Arg(1000000)->Arg(10000);
+
+void BM_QueryHours(benchmark::State& state) {
+  History history = MakeHistory();
+  int64_t micros = 0;
+  for (int i = 0; i < 3; ++i) {
+    for (const Temperature& t : Temperatures()) {
+      history.add(roo_time::Uptime::Start() + roo_time::Micros(micros), t);
+      micros += 1000000;
+    }
+  }
+  roo_time::Uptime now = roo_time::Uptime::Start() + roo_time::Micros(micros);
+  Rollup<Temperature> out[60];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(history.query(
+        2, roo_time::Uptime::Start(), now, out, 60));
+  }
+}
+BENCHMARK(BM_QueryHours);
+
+}  // namespace
+}  // namespace roo_quantity
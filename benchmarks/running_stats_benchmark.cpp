@@ -0,0 +1,106 @@
+// Measures the throughput of RunningStats::add() on a stream of 1M readings,
+// against a naive (uncompensated) Welford loop, and the cost of merging
+// per-block aggregators.
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/running_stats.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 1000 * 1000;
+
+const std::vector<Temperature>& Readings() {
+  static std::vector<Temperature> readings = [] {
+    std::vector<Temperature> v(kCount);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < kCount; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      float celsius = 15.0f + (float)(seed >> 20) * 0.01f;
+      v[i] = (seed >> 24) < 3 ? UnknownTemperature()
+                              : TemperatureDegCelcius(celsius);
+    }
+    return v;
+  }();
+  return readings;
+}
+
+void BM_NaiveWelford(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  for (auto _ : state) {
+    size_t count = 0;
+    float mean = 0.0f;
+    float m2 = 0.0f;
+    for (const Temperature& t : readings) {
+      if (t.isUnknown()) continue;
+      float x = t.degCelcius();
+      ++count;
+      float delta = x - mean;
+      mean += delta / (float)count;
+      m2 += delta * (x - mean);
+    }
+    benchmark::DoNotOptimize(mean);
+    benchmark::DoNotOptimize(std::sqrt(m2 / (float)(count - 1)));
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_NaiveWelford)->Unit(benchmark::kMillisecond);
+
+void BM_RunningStatsAdd(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  for (auto _ : state) {
+    RunningStats<Temperature> stats;
+    for (const Temperature& t : readings) stats.add(t);
+    benchmark::DoNotOptimize(stats.mean());
+    benchmark::DoNotOptimize(stats.stddev());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_RunningStatsAdd)->Unit(benchmark::kMillisecond);
+
+void BM_RunningStatsAddDouble(benchmark::State& state) {
+  std::vector<DoubleLength> readings;
+  readings.reserve(kCount);
+  for (const Temperature& t : Readings()) {
+    readings.push_back(DoubleLengthInMeters(t.degCelcius()));
+  }
+  for (auto _ : state) {
+    RunningStats<DoubleLength> stats;
+    for (const DoubleLength& l : readings) stats.add(l);
+    benchmark::DoNotOptimize(stats.mean());
+    benchmark::DoNotOptimize(stats.stddev());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_RunningStatsAddDouble)->Unit(benchmark::kMillisecond);
+
+// Aggregates blocks of the given size separately, then merges them, as in a
+// parallel reduction.
+void BM_RunningStatsMerge(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  size_t block = state.range(0);
+  for (auto _ : state) {
+    RunningStats<Temperature> total;
+    for (size_t begin = 0; begin < kCount; begin += block) {
+      RunningStats<Temperature> stats;
+      size_t end = begin + block < kCount ? begin + block : kCount;
+      for (size_t i = begin; i < end; ++i) stats.add(readings[i]);
+      total.merge(stats);
+    }
+    benchmark::DoNotOptimize(total.mean());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_RunningStatsMerge)
+    ->Arg(16)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace roo_quantity
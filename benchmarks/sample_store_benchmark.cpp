@@ -0,0 +1,164 @@
+// Measures SampleStore (sample_store.h): the append rate, the memory per
+// sample ("bytes_per_sample"), and the throughput of scanning a range of
+// samples, per sample and as runs of values, compared with a plain array of
+// (roo_time::Uptime, Voltage) rows.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/sample_store.h"
+#include "roo_quantity/statistics.h"
+#include "roo_quantity/voltage.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kBlockSize = 1024;
+constexpr size_t kBlocks = 64;
+constexpr size_t kCount = kBlockSize * kBlocks;
+
+using Store = SampleStore<Voltage, kBlockSize, kBlocks>;
+
+struct Row {
+  roo_time::Uptime time;
+  Voltage value;
+};
+
+roo_time::Uptime At(int64_t micros) {
+  return roo_time::Uptime::Start() + roo_time::Micros(micros);
+}
+
+const std::vector<Voltage>& Voltages() {
+  static std::vector<Voltage> voltages = [] {
+    std::vector<Voltage> v(kCount);
+    uint32_t seed = 12345;
+    for (Voltage& x : v) {
+      seed = seed * 1664525 + 1013904223;
+      x = VoltageInVolts(3.3f * (float)(seed >> 8) / 16777216.0f);
+    }
+    return v;
+  }();
+  return voltages;
+}
+
+// A store filled with samples at 1 kHz.
+const Store& FilledStore() {
+  static Store* store = [] {
+    Store* s = new Store();
+    int64_t micros = 0;
+    for (const Voltage& v : Voltages()) {
+      s->append(At(micros), v);
+      micros += 1000;
+    }
+    return s;
+  }();
+  return *store;
+}
+
+const std::vector<Row>& FilledRows() {
+  static std::vector<Row> rows = [] {
+    std::vector<Row> r;
+    int64_t micros = 0;
+    for (const Voltage& v : Voltages()) {
+      r.push_back(Row{At(micros), v});
+      micros += 1000;
+    }
+    return r;
+  }();
+  return rows;
+}
+
+void BM_Append(benchmark::State& state) {
+  Store* store = new Store();
+  int64_t micros = 0;
+  for (auto _ : state) {
+    for (const Voltage& v : Voltages()) {
+      store->append(At(micros), v);
+      micros += 1000;
+    }
+    benchmark::DoNotOptimize(store);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+  state.counters["bytes_per_sample"] = (double)sizeof(Store) / kCount;
+  delete store;
+}
+BENCHMARK(BM_Append);
+
+void BM_AppendRows(benchmark::State& state) {
+  std::vector<Row> rows(kCount);
+  int64_t micros = 0;
+  for (auto _ : state) {
+    size_t i = 0;
+    for (const Voltage& v : Voltages()) {
+      rows[i++] = Row{At(micros), v};
+      micros += 1000;
+    }
+    benchmark::DoNotOptimize(rows.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+  state.counters["bytes_per_sample"] = sizeof(Row);
+}
+BENCHMARK(BM_AppendRows);
+
+// Finds the maximum over the whole store, one sample at a time.
+void BM_ScanForEach(benchmark::State& state) {
+  const Store& store = FilledStore();
+  for (auto _ : state) {
+    float max = 0.0f;
+    store.forEach(At(0), At(kCount * 1000),
+                  [&max](roo_time::Uptime, const Voltage& v) {
+                    if (v.inVolts() > max) max = v.inVolts();
+                  });
+    benchmark::DoNotOptimize(max);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ScanForEach);
+
+// Same, as runs of values.
+void BM_ScanRuns(benchmark::State& state) {
+  const Store& store = FilledStore();
+  for (auto _ : state) {
+    float max = 0.0f;
+    store.forEachRun(At(0), At(kCount * 1000),
+                     [&max](QuantitySpan<const Voltage> run) {
+                       float m = Max(run).inVolts();
+                       if (m > max) max = m;
+                     });
+    benchmark::DoNotOptimize(max);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ScanRuns);
+
+// Same, over the array of rows.
+void BM_ScanRows(benchmark::State& state) {
+  const std::vector<Row>& rows = FilledRows();
+  for (auto _ : state) {
+    float max = 0.0f;
+    for (const Row& row : rows) {
+      if (row.value.inVolts() > max) max = row.value.inVolts();
+    }
+    benchmark::DoNotOptimize(max);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ScanRows);
+
+// Copies a range of 100 samples, starting at a varying position.
+void BM_Query(benchmark::State& state) {
+  const Store& store = FilledStore();
+  Sample<Voltage> out[100];
+  int64_t from = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        store.query(At(from), At(from + 100000), out, 100));
+    from = (from + 7919000) % ((kCount - 100) * 1000);
+  }
+  state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_Query);
+
+}  // namespace
+}  // namespace roo_quantity
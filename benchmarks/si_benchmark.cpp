@@ -0,0 +1,119 @@
+#include <cmath>
+#include <cstdio>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/format.h"
+#include "roo_quantity/si.h"
+
+namespace roo_quantity {
+namespace {
+
+// The printf-based implementation that FormatSimpleSiValue used to have; kept
+// here as the baseline.
+void FormatSimpleSiValueSnprintf(float val, const char* base_unit, char* out,
+                                 int maxlen) {
+  if (std::isnan(val)) {
+    snprintf(out, maxlen, "? %s", base_unit);
+    return;
+  }
+  if (val == 0.0f) {
+    snprintf(out, maxlen, "0 %s", base_unit);
+    return;
+  }
+  const char* prefix;
+  const char* sign = "";
+  if (val < 0.0f) {
+    sign = "-";
+    val = -val;
+  }
+  if (std::isinf(val)) {
+    snprintf(out, maxlen, "%s∞ %s", sign, base_unit);
+    return;
+  }
+  if (val >= 1000000000000000.0f) {
+    prefix = "P";
+    val *= 0.000000000000001;
+  } else if (val >= 1000000000000.0f) {
+    prefix = "T";
+    val *= 0.000000000001;
+  } else if (val >= 1000000000.0f) {
+    prefix = "G";
+    val *= 0.000000001;
+  } else if (val >= 1000000.0f) {
+    prefix = "M";
+    val *= 0.000001;
+  } else if (val >= 1000.0f) {
+    prefix = "k";
+    val *= 0.001;
+  } else if (val >= 1.0f) {
+    prefix = "";
+  } else if (val >= 0.001f) {
+    prefix = "m";
+    val *= 1000.0f;
+  } else if (val >= 0.000001f) {
+    prefix = "µ";
+    val *= 1000000.0f;
+  } else if (val >= 0.000000001f) {
+    prefix = "n";
+    val *= 1000000000.0f;
+  } else {
+    prefix = "p";
+    val *= 1000000000000.0f;
+  }
+  snprintf(out, maxlen, "%s%g %s%s", sign, val, prefix, base_unit);
+}
+
+// A mix of magnitudes typical for voltage, current, and power readings.
+const float kValues[] = {3.3f,   0.0155f, 1243.3f,   -0.032f,  0.0000047f,
+                         230.0f, 4.18e-6f, 54.3e9f,   1.0f / 3, 0.0f,
+                         12.05f, 0.5f,    -543222.f, 2.2e-12f, 998.5f,
+                         7.0e3f};
+
+constexpr int kValueCount = sizeof(kValues) / sizeof(kValues[0]);
+
+void BM_FormatSimpleSiValue(benchmark::State& state) {
+  char out[32];
+  int i = 0;
+  for (auto _ : state) {
+    FormatSimpleSiValue(kValues[i], "V", out, 32);
+    benchmark::DoNotOptimize(out);
+    i = (i + 1) % kValueCount;
+  }
+}
+BENCHMARK(BM_FormatSimpleSiValue);
+
+void BM_FormatSimpleSiValueSnprintf(benchmark::State& state) {
+  char out[32];
+  int i = 0;
+  for (auto _ : state) {
+    FormatSimpleSiValueSnprintf(kValues[i], "V", out, 32);
+    benchmark::DoNotOptimize(out);
+    i = (i + 1) % kValueCount;
+  }
+}
+BENCHMARK(BM_FormatSimpleSiValueSnprintf);
+
+void BM_FormatFloat(benchmark::State& state) {
+  char out[32];
+  int i = 0;
+  for (auto _ : state) {
+    FormatFloat(kValues[i], out, 32);
+    benchmark::DoNotOptimize(out);
+    i = (i + 1) % kValueCount;
+  }
+}
+BENCHMARK(BM_FormatFloat);
+
+void BM_FormatFloatSnprintf(benchmark::State& state) {
+  char out[32];
+  int i = 0;
+  for (auto _ : state) {
+    snprintf(out, 16, "%g", (double)kValues[i]);
+    benchmark::DoNotOptimize(out);
+    i = (i + 1) % kValueCount;
+  }
+}
+BENCHMARK(BM_FormatFloatSnprintf);
+
+}  // namespace
+}  // namespace roo_quantity
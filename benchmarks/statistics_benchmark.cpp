@@ -0,0 +1,99 @@
+// Compares the span reductions (statistics.h) against hand-written loops over
+// quantity objects that skip unknown values, on 10M readings (about 1% of
+// them unknown).
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/statistics.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 10 * 1000 * 1000;
+
+const std::vector<Temperature>& Readings() {
+  static std::vector<Temperature> readings = [] {
+    std::vector<Temperature> v(kCount);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < kCount; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      float celsius = 15.0f + (float)(seed >> 20) * 0.01f;
+      v[i] = (seed >> 24) < 3 ? UnknownTemperature()
+                              : TemperatureDegCelcius(celsius);
+    }
+    return v;
+  }();
+  return readings;
+}
+
+void BM_MeanLoop(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  for (auto _ : state) {
+    float sum = 0.0f;
+    size_t count = 0;
+    for (const Temperature& t : readings) {
+      if (t.isUnknown()) continue;
+      sum += t.degCelcius();
+      ++count;
+    }
+    benchmark::DoNotOptimize(TemperatureDegCelcius(sum / (float)count));
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_MeanLoop)->Unit(benchmark::kMillisecond);
+
+void BM_MeanSpan(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  QuantitySpan<const Temperature> span(readings.data(), readings.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Mean(span));
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_MeanSpan)->Unit(benchmark::kMillisecond);
+
+void BM_SummaryLoop(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  for (auto _ : state) {
+    float sum = 0.0f;
+    size_t count = 0;
+    Temperature min = UnknownTemperature();
+    Temperature max = UnknownTemperature();
+    for (const Temperature& t : readings) {
+      if (t.isUnknown()) continue;
+      if (min.isUnknown() || t < min) min = t;
+      if (max.isUnknown() || t > max) max = t;
+      sum += t.degCelcius();
+      ++count;
+    }
+    float mean = sum / (float)count;
+    float m2 = 0.0f;
+    for (const Temperature& t : readings) {
+      if (t.isUnknown()) continue;
+      float d = t.degCelcius() - mean;
+      m2 += d * d;
+    }
+    benchmark::DoNotOptimize(min);
+    benchmark::DoNotOptimize(max);
+    benchmark::DoNotOptimize(std::sqrt(m2 / (float)(count - 1)));
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_SummaryLoop)->Unit(benchmark::kMillisecond);
+
+void BM_SummarySpan(benchmark::State& state) {
+  const std::vector<Temperature>& readings = Readings();
+  QuantitySpan<const Temperature> span(readings.data(), readings.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Summarize(span));
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_SummarySpan)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -0,0 +1,105 @@
+// Compares the exact thermistor models (with a logarithm per sample) against
+// lookup tables of various sizes generated from them (thermistor.h),
+// converting 100k resistances of 10 kOhm NTC thermistors over -40..125 C.
+// Table benchmarks report the maximum error relative to the model, in C
+// ("max_error").
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "roo_quantity/thermistor.h"
+
+namespace roo_quantity {
+namespace {
+
+constexpr size_t kCount = 100 * 1000;
+
+constexpr BetaThermistor kBeta(ResistanceInKiloOhms(10.0f),
+                               TemperatureDegCelcius(25.0f), 3950.0f);
+
+constexpr SteinhartHartThermistor kSteinhartHart(1.009249522e-03f,
+                                                 2.378405444e-04f,
+                                                 2.019202697e-07f);
+
+// Resistances of the modeled thermistor at random temperatures in -40..125 C.
+template <typename Model>
+const std::vector<Resistance>& Resistances(const Model& model) {
+  static std::vector<Resistance> resistances = [&model] {
+    std::vector<Resistance> v(kCount);
+    uint32_t seed = 12345;
+    for (Resistance& r : v) {
+      seed = seed * 1664525 + 1013904223;
+      float celsius = -40.0f + (float)(seed >> 8) * (165.0f / 16777216.0f);
+      r = model.resistance(TemperatureDegCelcius(celsius));
+    }
+    return v;
+  }();
+  return resistances;
+}
+
+void BM_BetaExact(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const Resistance& r : Resistances(kBeta)) {
+      benchmark::DoNotOptimize(kBeta.temperature(r));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_BetaExact);
+
+void BM_SteinhartHartExact(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const Resistance& r : Resistances(kSteinhartHart)) {
+      benchmark::DoNotOptimize(kSteinhartHart.temperature(r));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_SteinhartHartExact);
+
+// Converts the resistances with the table, and reports its maximum error
+// relative to the model.
+template <size_t N, typename Model>
+void RunTable(benchmark::State& state, const ThermistorTable<N>& table,
+              const Model& model) {
+  for (auto _ : state) {
+    for (const Resistance& r : Resistances(model)) {
+      benchmark::DoNotOptimize(table.temperature(r));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+  float max_error = 0.0f;
+  for (const Resistance& r : Resistances(model)) {
+    max_error = std::max(max_error,
+                         std::fabs(table.temperature(r).degCelcius() -
+                                   model.temperature(r).degCelcius()));
+  }
+  state.counters["max_error"] = max_error;
+}
+
+template <size_t N>
+void BM_BetaTable(benchmark::State& state) {
+  static constexpr ThermistorTable<N> kTable(
+      kBeta, TemperatureDegCelcius(-40.0f), TemperatureDegCelcius(125.0f));
+  RunTable(state, kTable, kBeta);
+}
+BENCHMARK_TEMPLATE(BM_BetaTable, 34);
+BENCHMARK_TEMPLATE(BM_BetaTable, 67);
+BENCHMARK_TEMPLATE(BM_BetaTable, 166);
+
+template <size_t N>
+void BM_SteinhartHartTable(benchmark::State& state) {
+  static constexpr ThermistorTable<N> kTable(kSteinhartHart,
+                                             TemperatureDegCelcius(-40.0f),
+                                             TemperatureDegCelcius(125.0f));
+  RunTable(state, kTable, kSteinhartHart);
+}
+BENCHMARK_TEMPLATE(BM_SteinhartHartTable, 34);
+BENCHMARK_TEMPLATE(BM_SteinhartHartTable, 67);
+BENCHMARK_TEMPLATE(BM_SteinhartHartTable, 166);
+
+}  // namespace
+}  // namespace roo_quantity
@@ -7,6 +7,7 @@
 /// Base.
 
 #include "roo_quantity/frequency.h"
+#include "roo_quantity/quantity.h"
 #include "roo_quantity/temperature.h"
 #include "roo_quantity/time.h"
 
@@ -1,45 +1,30 @@
 #include "roo_quantity/area.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void AreaToString(const Area& val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? m²", maxlen);
-  } else {
-    const char* format;
-    float num;
-    if (val > AreaInSquareKilometers(1.0f)) {
-      format = "%g km²";
-      num = val.inSquareKilometers();
-    } else if (val > AreaInHectares(1.0f)) {
-      format = "%g ha";
-      num = val.inHectares();
-    } else if (val > AreaInSquareMeters(1.0f)) {
-      format = "%g m²";
-      num = val.inSquareMeters();
-    } else if (val > AreaInSquareDecimeters(1.0f)) {
-      format = "%g dm²";
-      num = val.inSquareDecimeters();
-    } else if (val > AreaInSquareMillimeters(1.0f)) {
-      format = "%g mm²";
-      num = val.inSquareMillimeters();
-    } else {
-      format = "%g µm²";
-      num = val.inSquareMicrometers();
-    }
-    snprintf(out, maxlen, format, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kAreaUnits[] = {
+    {1000000.0f, 0.000001f,        " km²"},
+    {10000.0f,   0.0001f,          " ha"},
+    {1.0f,       1.0f,             " m²"},
+    {0.01f,      100.0f,           " dm²"},
+    {0.000001f,  1000000.0f,       " mm²"},
+    {0.0f,       1000000000000.0f, " µm²"},
+};
 
 }  // namespace
 
+size_t Area::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inSquareMeters(), kAreaUnits, " m²", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Area::asString() const {
-  char out[16];
-  AreaToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -47,18 +32,13 @@ std::string Area::asString() const {
 #if defined(ARDUINO)
 
 String Area::asArduinoString() const {
-  char out[16];
-  AreaToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Area& val) {
-  char out[16];
-  AreaToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
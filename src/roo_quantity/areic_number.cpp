@@ -1,22 +1,20 @@
 #include "roo_quantity/areic_number.h"
 
-#include "roo_quantity/si.h"
+#include "roo_quantity/format.h"
 
 namespace roo_quantity {
-namespace {
 
-void AreicNumberToString(const AreicNumber& val, char* out, int maxlen) {
-  snprintf(out, maxlen, "%.6g/m²", val.inUnitsPerSquareMeter());
+size_t AreicNumber::formatTo(char* out, size_t maxlen) const {
+  internal::StringWriter writer(out, maxlen);
+  writer.appendFloat(inUnitsPerSquareMeter());
+  writer.append("/m²");
+  return writer.finish();
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string AreicNumber::asString() const {
-  char out[16];
-  AreicNumberToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,19 +22,14 @@ std::string AreicNumber::asString() const {
 #if defined(ARDUINO)
 
 String AreicNumber::asArduinoString() const {
-  char out[16];
-  AreicNumberToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os,
                                 const AreicNumber& val) {
-  char out[16];
-  AreicNumberToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -0,0 +1,209 @@
+#include "roo_quantity/barometric.h"
+
+#include "roo_quantity/simd.h"
+
+namespace roo_quantity {
+namespace {
+
+// Process elements [begin, end), computing
+// out[i] = scale * (FastPow(dividend / in[i], exponent) - 1).
+void FastAltitudesScalar(const float* in, float* out, size_t begin,
+                         size_t end, float dividend, float exponent,
+                         float scale) {
+  for (size_t i = begin; i < end; ++i) {
+    out[i] = scale * (internal::FastPow(dividend / in[i], exponent) - 1.0f);
+  }
+}
+
+#ifdef ROO_QUANTITY_X86_SIMD
+
+// The vector kernels process elements from `begin` while whole vectors fit
+// before `end`, and return the first unprocessed one. Operations are the same,
+// and in the same order, as in internal::FastLog() and internal::FastExp().
+
+__m128 LogSse(__m128 x) {
+  __m128i bits = _mm_castps_si128(x);
+  __m128i e =
+      _mm_srai_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(0x3F3504F3)), 23);
+  __m128 m = _mm_castsi128_ps(_mm_sub_epi32(bits, _mm_slli_epi32(e, 23)));
+  __m128 one = _mm_set1_ps(1.0f);
+  __m128 u = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+  __m128 u2 = _mm_mul_ps(u, u);
+  __m128 p = _mm_set1_ps(2.0f / 9.0f);
+  p = _mm_add_ps(_mm_mul_ps(p, u2), _mm_set1_ps(2.0f / 7.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, u2), _mm_set1_ps(2.0f / 5.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, u2), _mm_set1_ps(2.0f / 3.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, u2), _mm_set1_ps(2.0f));
+  __m128 result =
+      _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(e), _mm_set1_ps(0.693147181f)),
+                 _mm_mul_ps(u, p));
+  // x if x is inf; NaN unless x > 0.
+  __m128 infinite = _mm_cmpeq_ps(x, _mm_set1_ps(INFINITY));
+  result = _mm_or_ps(_mm_andnot_ps(infinite, result), _mm_and_ps(infinite, x));
+  __m128 positive = _mm_cmpgt_ps(x, _mm_setzero_ps());
+  return _mm_or_ps(_mm_and_ps(positive, result),
+                   _mm_andnot_ps(positive, _mm_set1_ps(NAN)));
+}
+
+__m128 ExpSse(__m128 y) {
+  __m128 infinite = _mm_cmpeq_ps(y, _mm_set1_ps(INFINITY));
+  // With a NaN operand, min and max return the second one, so NaN propagates.
+  y = _mm_min_ps(_mm_set1_ps(88.0f), _mm_max_ps(_mm_set1_ps(-87.0f), y));
+  __m128 magic = _mm_set1_ps(12582912.0f);
+  __m128 shifted = _mm_add_ps(_mm_mul_ps(y, _mm_set1_ps(1.44269504f)), magic);
+  __m128 kf = _mm_sub_ps(shifted, magic);
+  __m128i k = _mm_cvtps_epi32(kf);
+  __m128 r =
+      _mm_sub_ps(_mm_sub_ps(y, _mm_mul_ps(kf, _mm_set1_ps(0.693145752f))),
+                 _mm_mul_ps(kf, _mm_set1_ps(1.42860677e-6f)));
+  __m128 p = _mm_set1_ps(1.0f / 5040.0f);
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.0f / 720.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.0f / 120.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.0f / 24.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.0f / 6.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(0.5f));
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.0f));
+  p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.0f));
+  __m128 scale = _mm_castsi128_ps(
+      _mm_slli_epi32(_mm_add_epi32(k, _mm_set1_epi32(127)), 23));
+  __m128 result = _mm_mul_ps(p, scale);
+  return _mm_or_ps(_mm_andnot_ps(infinite, result),
+                   _mm_and_ps(infinite, _mm_set1_ps(INFINITY)));
+}
+
+size_t FastAltitudesSse(const float* in, float* out, size_t begin,
+                        size_t end, float dividend, float exponent,
+                        float scale) {
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    __m128 x = _mm_div_ps(_mm_set1_ps(dividend), _mm_loadu_ps(in + i));
+    __m128 pow = ExpSse(_mm_mul_ps(_mm_set1_ps(exponent), LogSse(x)));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_set1_ps(scale),
+                                      _mm_sub_ps(pow, _mm_set1_ps(1.0f))));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) inline __m256 LogAvx2(__m256 x) {
+  __m256i bits = _mm256_castps_si256(x);
+  __m256i e = _mm256_srai_epi32(
+      _mm256_sub_epi32(bits, _mm256_set1_epi32(0x3F3504F3)), 23);
+  __m256 m =
+      _mm256_castsi256_ps(_mm256_sub_epi32(bits, _mm256_slli_epi32(e, 23)));
+  __m256 one = _mm256_set1_ps(1.0f);
+  __m256 u = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+  __m256 u2 = _mm256_mul_ps(u, u);
+  __m256 p = _mm256_set1_ps(2.0f / 9.0f);
+  p = _mm256_add_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(2.0f / 7.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(2.0f / 5.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(2.0f / 3.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(2.0f));
+  __m256 result = _mm256_add_ps(
+      _mm256_mul_ps(_mm256_cvtepi32_ps(e), _mm256_set1_ps(0.693147181f)),
+      _mm256_mul_ps(u, p));
+  __m256 infinite = _mm256_cmp_ps(x, _mm256_set1_ps(INFINITY), _CMP_EQ_OQ);
+  result = _mm256_blendv_ps(result, x, infinite);
+  __m256 positive = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ);
+  return _mm256_blendv_ps(_mm256_set1_ps(NAN), result, positive);
+}
+
+__attribute__((target("avx2"))) inline __m256 ExpAvx2(__m256 y) {
+  __m256 infinite = _mm256_cmp_ps(y, _mm256_set1_ps(INFINITY), _CMP_EQ_OQ);
+  y = _mm256_min_ps(_mm256_set1_ps(88.0f),
+                    _mm256_max_ps(_mm256_set1_ps(-87.0f), y));
+  __m256 magic = _mm256_set1_ps(12582912.0f);
+  __m256 shifted =
+      _mm256_add_ps(_mm256_mul_ps(y, _mm256_set1_ps(1.44269504f)), magic);
+  __m256 kf = _mm256_sub_ps(shifted, magic);
+  __m256i k = _mm256_cvtps_epi32(kf);
+  __m256 r = _mm256_sub_ps(
+      _mm256_sub_ps(y, _mm256_mul_ps(kf, _mm256_set1_ps(0.693145752f))),
+      _mm256_mul_ps(kf, _mm256_set1_ps(1.42860677e-6f)));
+  __m256 p = _mm256_set1_ps(1.0f / 5040.0f);
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 720.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 120.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 24.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 6.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(0.5f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f));
+  p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f));
+  __m256 scale = _mm256_castsi256_ps(
+      _mm256_slli_epi32(_mm256_add_epi32(k, _mm256_set1_epi32(127)), 23));
+  return _mm256_blendv_ps(_mm256_mul_ps(p, scale), _mm256_set1_ps(INFINITY),
+                          infinite);
+}
+
+__attribute__((target("avx2"))) size_t FastAltitudesAvx2(
+    const float* in, float* out, size_t begin, size_t end, float dividend,
+    float exponent, float scale) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m256 x = _mm256_div_ps(_mm256_set1_ps(dividend), _mm256_loadu_ps(in + i));
+    __m256 pow =
+        ExpAvx2(_mm256_mul_ps(_mm256_set1_ps(exponent), LogAvx2(x)));
+    _mm256_storeu_ps(out + i,
+                     _mm256_mul_ps(_mm256_set1_ps(scale),
+                                   _mm256_sub_ps(pow, _mm256_set1_ps(1.0f))));
+  }
+  return i;
+}
+
+#endif  // ROO_QUANTITY_X86_SIMD
+
+}  // namespace
+
+void AltitudeFromPressure(QuantitySpan<const Pressure> pressure,
+                          const Pressure& sea_level,
+                          const Temperature& temperature,
+                          QuantitySpan<Length> out) {
+  for (size_t i = 0; i < pressure.size(); ++i) {
+    out.set(i, AltitudeFromPressure(pressure[i], sea_level, temperature));
+  }
+}
+
+void FastAltitudeFromPressure(QuantitySpan<const Pressure> pressure,
+                              const Pressure& sea_level,
+                              const Temperature& temperature,
+                              QuantitySpan<Length> out) {
+  const float* in = pressure.data();
+  float* result = out.data();
+  size_t n = pressure.size();
+  float dividend = sea_level.inPascals();
+  float exponent = internal::kBarometricExponent;
+  float scale = temperature.degKelvin() / internal::kBarometricLapseRate;
+  size_t i = 0;
+#ifdef ROO_QUANTITY_X86_SIMD
+  if (internal::HasAvx2()) {
+    i = FastAltitudesAvx2(in, result, 0, n, dividend, exponent, scale);
+  }
+  i = FastAltitudesSse(in, result, i, n, dividend, exponent, scale);
+#endif
+  FastAltitudesScalar(in, result, i, n, dividend, exponent, scale);
+}
+
+// The ratio of sea-level to local pressure depends on the altitude and the
+// temperature only, so it is computed once, and applied to all the pressures
+// (vectorized). The results are the same as element-wise.
+
+void SeaLevelPressure(QuantitySpan<const Pressure> pressure,
+                      const Length& altitude, const Temperature& temperature,
+                      QuantitySpan<Pressure> out) {
+  float ratio =
+      SeaLevelPressure(PressureInPascals(1.0f), altitude, temperature)
+          .inPascals();
+  internal::AffineTransform(pressure.data(), out.data(), pressure.size(),
+                            ratio, 0.0f);
+}
+
+void FastSeaLevelPressure(QuantitySpan<const Pressure> pressure,
+                          const Length& altitude,
+                          const Temperature& temperature,
+                          QuantitySpan<Pressure> out) {
+  float ratio =
+      FastSeaLevelPressure(PressureInPascals(1.0f), altitude, temperature)
+          .inPascals();
+  internal::AffineTransform(pressure.data(), out.data(), pressure.size(),
+                            ratio, 0.0f);
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cmath>
+#include <limits>
+
+#include "roo_quantity/length.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/span.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+
+// Barometric altitude, per the standard atmosphere model, in which the
+// temperature decreases linearly with altitude, by 6.5 K per km. Given the
+// local temperature T and the pressure p0 at sea level (the QNH reported by
+// weather services, or 1013.25 hPa for the standard atmosphere), pressure p
+// corresponds to the altitude
+//
+//   h = T / 0.0065 K/m * ((p0 / p)^0.190263 - 1).
+//
+// The power function is slow, particularly on microcontrollers without an
+// FPU. The Fast variants replace it with polynomial approximations of
+// logarithm and exponent. Their relative error is about 1e-6, which
+// translates to an altitude error below 1 cm, and a sea-level pressure error
+// below 0.2 Pa, on top of the rounding of the exact variants.
+
+namespace internal {
+
+/// Temperature lapse rate of the standard atmosphere, in K/m.
+constexpr float kBarometricLapseRate = 0.0065f;
+
+/// The exponent R * L / (g * M) of the barometric formula, where R is the gas
+/// constant, L the lapse rate, g the gravity, and M the molar mass of air.
+constexpr float kBarometricExponent = 0.190263f;
+
+/// Returns ln(x), for x > 0, with a relative error of a few ulp. Returns inf
+/// for inf, and NaN for NaN or x <= 0. Does not support subnormal x.
+inline float FastLog(float x) {
+  if (!(x > 0.0f)) return std::numeric_limits<float>::quiet_NaN();
+  if (x == std::numeric_limits<float>::infinity()) return x;
+  // x = 2^e * m, with m in [sqrt(2) / 2, sqrt(2)). Offsetting the bits by
+  // those of sqrt(2) / 2 makes the exponent field e, without branches.
+  uint32_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  int32_t e = static_cast<int32_t>(bits - 0x3F3504F3) >> 23;
+  bits -= static_cast<uint32_t>(e) << 23;
+  float m;
+  memcpy(&m, &bits, sizeof(m));
+  // ln(m) = 2 atanh(u) = 2 (u + u^3 / 3 + u^5 / 5 + ...), with |u| < 0.172;
+  // truncated after u^9, the error is below 1e-9.
+  float u = (m - 1.0f) / (m + 1.0f);
+  float u2 = u * u;
+  float p = 2.0f / 9.0f;
+  p = p * u2 + 2.0f / 7.0f;
+  p = p * u2 + 2.0f / 5.0f;
+  p = p * u2 + 2.0f / 3.0f;
+  p = p * u2 + 2.0f;
+  return static_cast<float>(e) * 0.693147181f + u * p;
+}
+
+/// Returns e^y, with a relative error of a few ulp. Saturates to 2^-126 and
+/// 2^127 outside of [-87, 88], except that e^inf is inf. Returns NaN for NaN.
+inline float FastExp(float y) {
+  if (y != y || y == std::numeric_limits<float>::infinity()) return y;
+  if (y < -87.0f) y = -87.0f;
+  if (y > 88.0f) y = 88.0f;
+  // e^y = 2^k * e^r, with |r| <= ln(2) / 2. Adding 1.5 * 2^23 rounds to the
+  // nearest integer, without branches. ln(2) is split into a part whose
+  // products with k are exact, and a correction.
+  float shifted = y * 1.44269504f + 12582912.0f;
+  float kf = shifted - 12582912.0f;
+  int k = static_cast<int>(kf);
+  float r = (y - kf * 0.693145752f) - kf * 1.42860677e-6f;
+  // Taylor series, truncated after r^7; the error is below 6e-9.
+  float p = 1.0f / 5040.0f;
+  p = p * r + 1.0f / 720.0f;
+  p = p * r + 1.0f / 120.0f;
+  p = p * r + 1.0f / 24.0f;
+  p = p * r + 1.0f / 6.0f;
+  p = p * r + 0.5f;
+  p = p * r + 1.0f;
+  p = p * r + 1.0f;
+  uint32_t bits = static_cast<uint32_t>(k + 127) << 23;
+  float scale;
+  memcpy(&scale, &bits, sizeof(scale));
+  return p * scale;
+}
+
+/// Returns x^a, for x > 0; see FastLog() and FastExp().
+inline float FastPow(float x, float a) { return FastExp(a * FastLog(x)); }
+
+}  // namespace internal
+
+/// Returns the altitude at which the pressure is `pressure`, given the
+/// pressure at sea level and the local temperature (see above). Unknown if
+/// any argument is unknown.
+inline Length AltitudeFromPressure(const Pressure& pressure,
+                                   const Pressure& sea_level,
+                                   const Temperature& temperature) {
+  return LengthInMeters(
+      temperature.degKelvin() / internal::kBarometricLapseRate *
+      (std::pow(sea_level.inPascals() / pressure.inPascals(),
+                internal::kBarometricExponent) -
+       1.0f));
+}
+
+/// Like AltitudeFromPressure(), but faster and slightly less accurate.
+inline Length FastAltitudeFromPressure(const Pressure& pressure,
+                                       const Pressure& sea_level,
+                                       const Temperature& temperature) {
+  return LengthInMeters(
+      temperature.degKelvin() / internal::kBarometricLapseRate *
+      (internal::FastPow(sea_level.inPascals() / pressure.inPascals(),
+                         internal::kBarometricExponent) -
+       1.0f));
+}
+
+/// Returns the pressure at sea level, given the pressure at the specified
+/// altitude, and the local temperature; the inverse of
+/// AltitudeFromPressure(). Used to calibrate altitude measurements, or to
+/// report weather station readings independently of their altitude. Unknown
+/// if any argument is unknown.
+inline Pressure SeaLevelPressure(const Pressure& pressure,
+                                 const Length& altitude,
+                                 const Temperature& temperature) {
+  return PressureInPascals(
+      pressure.inPascals() *
+      std::pow(1.0f + internal::kBarometricLapseRate * altitude.inMeters() /
+                          temperature.degKelvin(),
+               1.0f / internal::kBarometricExponent));
+}
+
+/// Like SeaLevelPressure(), but faster and slightly less accurate.
+inline Pressure FastSeaLevelPressure(const Pressure& pressure,
+                                     const Length& altitude,
+                                     const Temperature& temperature) {
+  return PressureInPascals(
+      pressure.inPascals() *
+      internal::FastPow(1.0f + internal::kBarometricLapseRate *
+                                   altitude.inMeters() /
+                                   temperature.degKelvin(),
+                        1.0f / internal::kBarometricExponent));
+}
+
+/// Computes the altitudes of all the pressures, writing them to `out`, which
+/// must have pressure.size() elements. See AltitudeFromPressure().
+void AltitudeFromPressure(QuantitySpan<const Pressure> pressure,
+                          const Pressure& sea_level,
+                          const Temperature& temperature,
+                          QuantitySpan<Length> out);
+
+/// Like the above, but using FastAltitudeFromPressure(), with bit-identical
+/// results. Vectorized where possible.
+void FastAltitudeFromPressure(QuantitySpan<const Pressure> pressure,
+                              const Pressure& sea_level,
+                              const Temperature& temperature,
+                              QuantitySpan<Length> out);
+
+/// Computes the sea-level pressures of all the pressures, measured at the
+/// same altitude, writing them to `out`, which must have pressure.size()
+/// elements; `out` may alias `pressure`. See SeaLevelPressure().
+void SeaLevelPressure(QuantitySpan<const Pressure> pressure,
+                      const Length& altitude, const Temperature& temperature,
+                      QuantitySpan<Pressure> out);
+
+/// Like the above, but using FastSeaLevelPressure().
+void FastSeaLevelPressure(QuantitySpan<const Pressure> pressure,
+                          const Length& altitude,
+                          const Temperature& temperature,
+                          QuantitySpan<Pressure> out);
+
+}  // namespace roo_quantity
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "roo_quantity/span.h"
+
+namespace roo_quantity {
+
+/// A point of a calibration curve: the raw sensor reading (e.g. ADC counts),
+/// and the quantity it corresponds to.
+template <typename Q>
+struct CalibrationPoint {
+  float raw = 0.0f;
+  Q value;
+};
+
+namespace internal {
+
+template <typename Q>
+constexpr typename RawTraits<Q>::Rep Interpolate(const Q& a, const Q& b,
+                                                 float t) {
+  using Rep = typename RawTraits<Q>::Rep;
+  Rep va = RawTraits<Q>::ToRaw(a);
+  Rep vb = RawTraits<Q>::ToRaw(b);
+  return va + (vb - va) * static_cast<Rep>(t);
+}
+
+}  // namespace internal
+
+/// Maps raw sensor readings to quantities, by piecewise-linear interpolation
+/// between calibration points with arbitrarily spaced raw values, found by
+/// binary search. Readings outside of the range of the table are extrapolated
+/// from the first or last segment; an unknown (NaN) reading maps to unknown.
+/// Q can be any quantity class, including Temperature.
+///
+/// The table does not copy the points, so it can be constructed at compile
+/// time, with both the points and the table residing in flash:
+///
+///   static constexpr CalibrationPoint<Temperature> kPoints[] = {
+///       {412.0f, TemperatureDegCelcius(-20.0f)},
+///       {1310.0f, TemperatureDegCelcius(25.0f)},
+///       {3390.0f, TemperatureDegCelcius(100.0f)},
+///   };
+///   static constexpr CalibrationTable<Temperature> kCalibration(kPoints);
+///   static_assert(kCalibration.valid(), "");
+///   ...
+///   Temperature t = kCalibration(analogRead(kPin));
+///
+/// See also UniformCalibrationTable, for faster lookups.
+template <typename Q>
+class CalibrationTable {
+ public:
+  /// Creates the table from points with strictly increasing raw values.
+  template <size_t N>
+  constexpr CalibrationTable(const CalibrationPoint<Q> (&points)[N])
+      : points_(points), size_(N) {
+    static_assert(N >= 2, "Calibration needs at least two points");
+  }
+
+  /// Returns whether the raw values of the points are strictly increasing, as
+  /// required.
+  constexpr bool valid() const {
+    for (size_t i = 1; i < size_; ++i) {
+      if (!(points_[i - 1].raw < points_[i].raw)) return false;
+    }
+    return true;
+  }
+
+  /// Returns the quantity corresponding to the raw reading.
+  constexpr Q operator()(float raw) const {
+    // Find the segment [lo, lo + 1] containing raw, or the end one.
+    size_t lo = 0;
+    size_t hi = size_ - 1;
+    while (hi - lo > 1) {
+      size_t mid = (lo + hi) / 2;
+      if (raw < points_[mid].raw) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    const CalibrationPoint<Q>& a = points_[lo];
+    const CalibrationPoint<Q>& b = points_[lo + 1];
+    return internal::RawTraits<Q>::FromRaw(internal::Interpolate(
+        a.value, b.value, (raw - a.raw) / (b.raw - a.raw)));
+  }
+
+  /// Maps out.size() raw readings from `raw`, which can be integer (e.g. ADC
+  /// counts) or floating-point.
+  template <typename T>
+  void apply(const T* raw, QuantitySpan<Q> out) const {
+    for (size_t i = 0; i < out.size(); ++i) {
+      out.set(i, (*this)(static_cast<float>(raw[i])));
+    }
+  }
+
+ private:
+  const CalibrationPoint<Q>* points_;
+  size_t size_;
+};
+
+/// Like CalibrationTable, but for calibration points at uniformly spaced raw
+/// values (raw_first, raw_first + raw_step, ...), which makes lookups O(1):
+/// the segment is found by a multiplication, rather than a binary search.
+/// Useful for dense tables, e.g. one point every 64 ADC counts:
+///
+///   static constexpr Voltage kPoints[] = {VoltageInMilliVolts(0.0f), ...};
+///   static constexpr UniformCalibrationTable<Voltage> kCalibration(
+///       0.0f, 64.0f, kPoints);
+template <typename Q>
+class UniformCalibrationTable {
+ public:
+  /// Creates the table from the values at raw_first + i * raw_step, where
+  /// raw_step > 0.
+  template <size_t N>
+  constexpr UniformCalibrationTable(float raw_first, float raw_step,
+                                    const Q (&values)[N])
+      : values_(values),
+        size_(N),
+        raw_first_(raw_first),
+        raw_step_(raw_step),
+        inv_step_(1.0f / raw_step) {
+    static_assert(N >= 2, "Calibration needs at least two points");
+  }
+
+  /// Returns the quantity corresponding to the raw reading.
+  constexpr Q operator()(float raw) const {
+    float t = (raw - raw_first_) * inv_step_;
+    // Clamp to the first or last segment, for extrapolation. (Also for NaN,
+    // which then propagates to the result.)
+    size_t i = 0;
+    if (t >= static_cast<float>(size_ - 2)) {
+      i = size_ - 2;
+    } else if (t >= 1.0f) {
+      i = static_cast<size_t>(t);
+    }
+    return internal::RawTraits<Q>::FromRaw(internal::Interpolate(
+        values_[i], values_[i + 1], t - static_cast<float>(i)));
+  }
+
+  /// Maps out.size() raw readings from `raw`, which can be integer (e.g. ADC
+  /// counts) or floating-point.
+  template <typename T>
+  void apply(const T* raw, QuantitySpan<Q> out) const {
+    for (size_t i = 0; i < out.size(); ++i) {
+      out.set(i, (*this)(static_cast<float>(raw[i])));
+    }
+  }
+
+  /// Returns the raw value of the first point.
+  constexpr float rawFirst() const { return raw_first_; }
+
+  /// Returns the distance between the raw values of consecutive points.
+  constexpr float rawStep() const { return raw_step_; }
+
+ private:
+  const Q* values_;
+  size_t size_;
+  float raw_first_;
+  float raw_step_;
+  float inv_step_;
+};
+
+}  // namespace roo_quantity
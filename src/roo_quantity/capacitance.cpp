@@ -1,22 +1,18 @@
 #include "roo_quantity/capacitance.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void CapacitanceToString(const Capacitance& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inFarads(), "F", out, maxlen);
+size_t Capacitance::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inFarads(), "F", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Capacitance::asString() const {
-  char out[16];
-  CapacitanceToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,14 @@ std::string Capacitance::asString() const {
 #if defined(ARDUINO)
 
 String Capacitance::asArduinoString() const {
-  char out[16];
-  CapacitanceToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const Capacitance& val) {
-  char out[16];
-  CapacitanceToString(val, out, 16);
-  os << out;
-  return os;
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const Capacitance& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,22 +1,18 @@
 #include "roo_quantity/charge.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void ChargeToString(const Charge& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inCoulombs(), "C", out, maxlen);
+size_t Charge::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inCoulombs(), "C", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Charge::asString() const {
-  char out[16];
-  ChargeToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,38 @@ std::string Charge::asString() const {
 #if defined(ARDUINO)
 
 String Charge::asArduinoString() const {
-  char out[16];
-  ChargeToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Charge& val) {
-  char out[16];
-  ChargeToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
+}
+
+size_t DoubleCharge::formatTo(char* out, size_t maxlen) const {
+  return toFloat().formatTo(out, maxlen);
+}
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+
+std::string DoubleCharge::asString() const {
+  return internal::FormatAsString(*this);
+}
+
+#endif
+
+#if defined(ARDUINO)
+
+String DoubleCharge::asArduinoString() const {
+  return internal::FormatAsArduinoString(*this);
+}
+
+#endif
+
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const DoubleCharge& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
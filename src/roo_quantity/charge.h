@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -16,65 +18,27 @@
 namespace roo_quantity {
 
 /// Representation of charge, internally stored as floating-point Coulombs.
-class Charge {
+class Charge : public internal::QuantityBase<Charge, dimension::Charge, float> {
  public:
   /// Creates a charge object representing an 'unknown' charge.
-  Charge() : charge_(std::nanf("")) {}
+  constexpr Charge() = default;
 
   /// Returns the charge in kiloCoulombs.
-  float inKiloCoulombs() const { return charge_ / 1000.0f; }
+  constexpr float inKiloCoulombs() const { return value_ / 1000.0f; }
 
   /// Returns the charge in Coulombs.
-  float inCoulombs() const { return charge_; }
+  constexpr float inCoulombs() const { return value_; }
 
   /// Returns the charge in milliCoulombs.
-  float inMilliCoulombs() const { return charge_ * 1000.0f; }
+  constexpr float inMilliCoulombs() const { return value_ * 1000.0f; }
 
   /// Returns the charge in microCoulombs.
-  float inMicroCoulombs() const { return charge_ * 1000000.0f; }
+  constexpr float inMicroCoulombs() const { return value_ * 1000000.0f; }
 
-  /// Returns whether the object represents an unknown charge.
-  bool isUnknown() const { return std::isnan(charge_); }
-
-  bool operator<(const Charge& other) const { return charge_ < other.charge_; }
-
-  bool operator==(const Charge& other) const {
-    return charge_ == other.charge_;
-  }
-
-  bool operator>(const Charge& other) const { return other.charge_ < charge_; }
-
-  bool operator<=(const Charge& other) const {
-    return !(other.charge_ < charge_);
-  }
-
-  bool operator>=(const Charge& other) const {
-    return !(charge_ < other.charge_);
-  }
-
-  bool operator!=(const Charge& other) const {
-    return !(charge_ == other.charge_);
-  }
-
-  inline Charge& operator+=(const Charge& other) {
-    charge_ += other.inCoulombs();
-    return *this;
-  }
-
-  inline Charge& operator-=(const Charge& other) {
-    charge_ -= other.inCoulombs();
-    return *this;
-  }
-
-  inline Charge& operator*=(float multi) {
-    charge_ *= multi;
-    return *this;
-  }
-
-  inline Charge& operator/=(float div) {
-    charge_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the charge into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the charge.
@@ -86,69 +50,125 @@ class Charge {
 #endif
 
  private:
-  friend Charge UnknownCharge();
-
-  friend Charge ChargeInCoulombs(float);
+  friend constexpr Charge UnknownCharge();
 
-  explicit Charge(float charge) : charge_(charge) {}
+  friend constexpr Charge ChargeInCoulombs(float);
 
-  /// Stored in Coulombs.
-  float charge_;
+  explicit constexpr Charge(float charge) : QuantityBase(charge) {}
 };
 
-inline Charge ChargeInCoulombs(float charge);
+constexpr Charge ChargeInCoulombs(float charge);
 
 /// Returns a charge object representing an unknown charge.
-inline Charge UnknownCharge() { return Charge(); }
+constexpr Charge UnknownCharge() { return Charge(); }
 
 /// Returns a charge object equivalent to the specified charge
 /// expressed in kiloCoulombs.
-inline Charge ChargeInKiloCoulombs(float charge) {
+constexpr Charge ChargeInKiloCoulombs(float charge) {
   return ChargeInCoulombs(charge * 1000.0f);
 }
 
 /// Returns a charge object equivalent to the specified charge
 /// expressed in Coulombs.
-inline Charge ChargeInCoulombs(float charge) { return Charge(charge); }
+constexpr Charge ChargeInCoulombs(float charge) { return Charge(charge); }
 
 /// Returns a charge object equivalent to the specified charge
 /// expressed in milliCoulombs.
-inline Charge ChargeInMilliCoulombs(float charge) {
+constexpr Charge ChargeInMilliCoulombs(float charge) {
   return ChargeInCoulombs(charge * 0.001f);
 }
 
 /// Returns a charge object equivalent to the specified charge
 /// expressed in microCoulombs.
-inline Charge ChargeInMicroCoulombs(float charge) {
+constexpr Charge ChargeInMicroCoulombs(float charge) {
   return ChargeInCoulombs(charge * 0.000001f);
 }
 
-inline Charge operator+(Charge a, Charge b) {
-  return ChargeInCoulombs(a.inCoulombs() + b.inCoulombs());
-}
+roo_logging::Stream& operator<<(roo_logging::Stream& os, const Charge& val);
 
-inline Charge operator-(Charge a, Charge b) {
-  return ChargeInCoulombs(a.inCoulombs() - b.inCoulombs());
-}
+/// Representation of charge, internally stored as double-precision Coulombs.
+/// Use instead of Charge where float precision is insufficient, e.g. for long-
+/// running accumulations. Converts implicitly from Charge, and can be mixed
+/// with it in arithmetic; the results are double-precision.
+class DoubleCharge
+    : public internal::QuantityBase<DoubleCharge, dimension::Charge, double> {
+ public:
+  /// Creates a charge object representing an 'unknown' charge.
+  constexpr DoubleCharge() = default;
+
+  /// Converts from the single-precision charge. The conversion is exact.
+  constexpr DoubleCharge(const Charge& charge)
+      : QuantityBase(static_cast<double>(charge.inSiUnits())) {}
+
+  /// Returns the charge in kiloCoulombs.
+  constexpr double inKiloCoulombs() const { return value_ / 1000.0; }
+
+  /// Returns the charge in Coulombs.
+  constexpr double inCoulombs() const { return value_; }
+
+  /// Returns the charge in milliCoulombs.
+  constexpr double inMilliCoulombs() const { return value_ * 1000.0; }
+
+  /// Returns the charge in microCoulombs.
+  constexpr double inMicroCoulombs() const { return value_ * 1000000.0; }
+
+  /// Returns the charge, rounded to single precision.
+  constexpr Charge toFloat() const {
+    return Charge::FromSiUnits(static_cast<float>(value_));
+  }
+
+  /// Writes the string representation of the charge into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+  /// Returns the string representation of the charge.
+  std::string asString() const;
+#endif
 
-inline Charge operator-(Charge a) { return ChargeInCoulombs(-a.inCoulombs()); }
+#if defined(ARDUINO)
+  String asArduinoString() const;
+#endif
+
+ private:
+  friend constexpr DoubleCharge UnknownDoubleCharge();
 
-inline Charge operator*(Charge a, float b) {
-  return ChargeInCoulombs(a.inCoulombs() * b);
+  friend constexpr DoubleCharge DoubleChargeInCoulombs(double);
+
+  explicit constexpr DoubleCharge(double charge) : QuantityBase(charge) {}
+};
+
+constexpr DoubleCharge DoubleChargeInCoulombs(double charge);
+
+/// Returns a double-precision charge object representing an unknown charge.
+constexpr DoubleCharge UnknownDoubleCharge() { return DoubleCharge(); }
+
+/// Returns a double-precision charge object equivalent to the specified
+/// charge expressed in kiloCoulombs.
+constexpr DoubleCharge DoubleChargeInKiloCoulombs(double charge) {
+  return DoubleChargeInCoulombs(charge * 1000.0);
 }
 
-inline Charge operator*(float a, Charge b) {
-  return ChargeInCoulombs(a * b.inCoulombs());
+/// Returns a double-precision charge object equivalent to the specified
+/// charge expressed in Coulombs.
+constexpr DoubleCharge DoubleChargeInCoulombs(double charge) {
+  return DoubleCharge(charge);
 }
 
-inline Charge operator/(Charge a, float b) {
-  return ChargeInCoulombs(a.inCoulombs() / b);
+/// Returns a double-precision charge object equivalent to the specified
+/// charge expressed in milliCoulombs.
+constexpr DoubleCharge DoubleChargeInMilliCoulombs(double charge) {
+  return DoubleChargeInCoulombs(charge / 1000.0);
 }
 
-inline float operator/(Charge a, Charge b) {
-  return a.inCoulombs() / b.inCoulombs();
+/// Returns a double-precision charge object equivalent to the specified
+/// charge expressed in microCoulombs.
+constexpr DoubleCharge DoubleChargeInMicroCoulombs(double charge) {
+  return DoubleChargeInCoulombs(charge / 1000000.0);
 }
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const Charge& val);
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const DoubleCharge& val);
 
 }  // namespace roo_quantity
\ No newline at end of file
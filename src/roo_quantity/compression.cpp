@@ -0,0 +1,211 @@
+#include "roo_quantity/compression.h"
+
+namespace roo_quantity {
+namespace internal {
+namespace {
+
+int LeadingZeros(uint32_t x) { return __builtin_clz(x); }
+
+int TrailingZeros(uint32_t x) { return __builtin_ctz(x); }
+
+}  // namespace
+
+GorillaWriter::GorillaWriter(uint8_t* buffer, size_t capacity,
+                             uint32_t tick_micros)
+    : buffer_(buffer),
+      capacity_(capacity),
+      pos_(0),
+      count_(0),
+      overflow_(false),
+      prev_ticks_(0),
+      prev_delta_(0),
+      prev_value_(0),
+      leading_(-1),
+      trailing_(0) {
+  write(tick_micros, 32);
+}
+
+void GorillaWriter::write(uint64_t bits, int n) {
+  // Writes MSB-first, a byte at a time. Bits past pos_ are overwritten (not
+  // OR-ed), so that a rolled-back sample leaves no trace.
+  while (n > 0) {
+    size_t byte = pos_ >> 3;
+    if (byte >= capacity_) {
+      overflow_ = true;
+      return;
+    }
+    int room = 8 - static_cast<int>(pos_ & 7);
+    int take = n < room ? n : room;
+    int shift = room - take;
+    uint8_t mask = static_cast<uint8_t>(((1u << take) - 1) << shift);
+    uint8_t chunk = static_cast<uint8_t>(
+        ((bits >> (n - take)) & ((1u << take) - 1)) << shift);
+    buffer_[byte] = static_cast<uint8_t>((buffer_[byte] & ~mask) | chunk);
+    pos_ += take;
+    n -= take;
+  }
+}
+
+bool GorillaWriter::append(int64_t ticks, uint32_t value) {
+  if (overflow_) return false;
+  size_t pos = pos_;
+  int leading = leading_;
+  int trailing = trailing_;
+  if (count_ == 0) {
+    write(static_cast<uint64_t>(ticks), 64);
+    write(value, 32);
+  } else {
+    int64_t delta = ticks - prev_ticks_;
+    int64_t dod = delta - prev_delta_;
+    if (dod == 0) {
+      write(0, 1);
+    } else if (dod >= -64 && dod <= 63) {
+      write(0x2, 2);
+      write(static_cast<uint64_t>(dod), 7);
+    } else if (dod >= -256 && dod <= 255) {
+      write(0x6, 3);
+      write(static_cast<uint64_t>(dod), 9);
+    } else if (dod >= -2048 && dod <= 2047) {
+      write(0xE, 4);
+      write(static_cast<uint64_t>(dod), 12);
+    } else {
+      write(0xF, 4);
+      write(static_cast<uint64_t>(dod), 64);
+    }
+    uint32_t x = value ^ prev_value_;
+    if (x == 0) {
+      write(0, 1);
+    } else {
+      int lz = LeadingZeros(x);
+      int tz = TrailingZeros(x);
+      if (leading_ >= 0 && lz >= leading_ && tz >= trailing_) {
+        write(0x2, 2);
+        write(x >> trailing_, 32 - leading_ - trailing_);
+      } else {
+        write(0x3, 2);
+        write(static_cast<uint64_t>(lz), 5);
+        write(static_cast<uint64_t>(31 - lz - tz), 5);
+        write(x >> tz, 32 - lz - tz);
+        leading_ = lz;
+        trailing_ = tz;
+      }
+    }
+  }
+  if (overflow_) {
+    // Roll back the partially written sample.
+    pos_ = pos;
+    leading_ = leading;
+    trailing_ = trailing;
+    overflow_ = false;
+    return false;
+  }
+  prev_delta_ = count_ == 0 ? 0 : ticks - prev_ticks_;
+  prev_ticks_ = ticks;
+  prev_value_ = value;
+  ++count_;
+  return true;
+}
+
+GorillaReader::GorillaReader(const uint8_t* data, size_t size, size_t count)
+    : data_(data),
+      size_bits_(size * 8),
+      pos_(0),
+      remaining_(count),
+      tick_micros_(0),
+      prev_ticks_(0),
+      prev_delta_(0),
+      prev_value_(0),
+      leading_(0),
+      length_(0),
+      first_(true),
+      truncated_(false) {
+  tick_micros_ = static_cast<uint32_t>(read(32));
+  if (truncated_) remaining_ = 0;
+}
+
+uint64_t GorillaReader::read(int n) {
+  if (size_bits_ - pos_ < static_cast<size_t>(n)) {
+    truncated_ = true;
+    pos_ = size_bits_;
+    return 0;
+  }
+  uint64_t result = 0;
+  while (n > 0) {
+    int room = 8 - static_cast<int>(pos_ & 7);
+    int take = n < room ? n : room;
+    int shift = room - take;
+    uint64_t chunk = (data_[pos_ >> 3] >> shift) & ((1u << take) - 1);
+    result = (result << take) | chunk;
+    pos_ += take;
+    n -= take;
+  }
+  return result;
+}
+
+namespace {
+
+// Interprets the n low bits as a two's complement number.
+int64_t SignExtend(uint64_t bits, int n) {
+  uint64_t sign = uint64_t{1} << (n - 1);
+  return static_cast<int64_t>((bits ^ sign) - sign);
+}
+
+}  // namespace
+
+bool GorillaReader::next(int64_t& ticks, uint32_t& value) {
+  if (remaining_ == 0) return false;
+  int64_t t;
+  uint32_t v;
+  int64_t delta;
+  if (first_) {
+    t = static_cast<int64_t>(read(64));
+    v = static_cast<uint32_t>(read(32));
+    delta = 0;
+  } else {
+    int64_t dod;
+    if (read(1) == 0) {
+      dod = 0;
+    } else if (read(1) == 0) {
+      dod = SignExtend(read(7), 7);
+    } else if (read(1) == 0) {
+      dod = SignExtend(read(9), 9);
+    } else if (read(1) == 0) {
+      dod = SignExtend(read(12), 12);
+    } else {
+      dod = static_cast<int64_t>(read(64));
+    }
+    delta = prev_delta_ + dod;
+    t = prev_ticks_ + delta;
+    v = prev_value_;
+    if (read(1) != 0) {
+      if (read(1) != 0) {
+        leading_ = static_cast<int>(read(5));
+        length_ = static_cast<int>(read(5)) + 1;
+      }
+      // A window that does not fit in 32 bits (or none, before the first
+      // one is defined) means the stream is truncated or corrupt.
+      if (truncated_ || length_ == 0 || leading_ + length_ > 32) {
+        truncated_ = true;
+        remaining_ = 0;
+        return false;
+      }
+      int trailing = 32 - leading_ - length_;
+      v ^= static_cast<uint32_t>(read(length_)) << trailing;
+    }
+  }
+  if (truncated_) {
+    remaining_ = 0;
+    return false;
+  }
+  first_ = false;
+  prev_delta_ = delta;
+  prev_ticks_ = t;
+  prev_value_ = v;
+  --remaining_;
+  ticks = t;
+  value = v;
+  return true;
+}
+
+}  // namespace internal
+}  // namespace roo_quantity
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cmath>
+#include <type_traits>
+
+#include "roo_quantity/span.h"
+#include "roo_quantity/statistics.h"
+#include "roo_time.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// Bit-level encoder of a series of (timestamp, 32-bit value) pairs, in the
+/// format of Facebook's Gorilla time series database. Timestamps are integer
+/// ticks, encoded as deltas of deltas:
+///
+///   0                     - same delta as before,
+///   10 + 7 bits           - in [-64, 63],
+///   110 + 9 bits          - in [-256, 255],
+///   1110 + 12 bits        - in [-2048, 2047],
+///   1111 + 64 bits        - otherwise.
+///
+/// Values are encoded as the XOR with the previous value:
+///
+///   0                     - same value as before,
+///   10 + meaningful bits  - the non-zero bits of the XOR fit in the window of
+///                           the previous XOR,
+///   11 + 5 bits leading zeros + 5 bits (length - 1) + meaningful bits.
+///
+/// The stream starts with the tick length in microseconds (32 bits). The first
+/// sample is stored as is (64 + 32 bits); the delta of the second one is
+/// encoded against a delta of zero.
+class GorillaWriter {
+ public:
+  GorillaWriter(uint8_t* buffer, size_t capacity, uint32_t tick_micros);
+
+  /// Appends the sample. If it does not fit in the buffer, returns false,
+  /// leaving the stream as it was.
+  bool append(int64_t ticks, uint32_t value);
+
+  /// Returns the number of samples written.
+  size_t count() const { return count_; }
+
+  /// Returns the size of the stream in bits.
+  size_t sizeBits() const { return pos_; }
+
+ private:
+  void write(uint64_t bits, int n);
+
+  uint8_t* buffer_;
+  size_t capacity_;
+  size_t pos_;
+  size_t count_;
+  bool overflow_;
+  int64_t prev_ticks_;
+  int64_t prev_delta_;
+  uint32_t prev_value_;
+  int leading_;
+  int trailing_;
+};
+
+/// Decoder of streams written by GorillaWriter.
+class GorillaReader {
+ public:
+  /// Reads `count` samples from the stream of `size` bytes.
+  GorillaReader(const uint8_t* data, size_t size, size_t count);
+
+  /// Returns the tick length, in microseconds.
+  uint32_t tickMicros() const { return tick_micros_; }
+
+  /// Reads the next sample. Returns false, leaving the arguments unchanged, if
+  /// all the samples have been read (or the stream is truncated).
+  bool next(int64_t& ticks, uint32_t& value);
+
+ private:
+  uint64_t read(int n);
+
+  const uint8_t* data_;
+  size_t size_bits_;
+  size_t pos_;
+  size_t remaining_;
+  uint32_t tick_micros_;
+  int64_t prev_ticks_;
+  int64_t prev_delta_;
+  uint32_t prev_value_;
+  int leading_;
+  int length_;
+  bool first_;
+  bool truncated_;
+};
+
+}  // namespace internal
+
+/// Streaming compressor of a time series of quantities, into a caller-provided
+/// buffer, using the Gorilla encoding (see internal::GorillaWriter): deltas of
+/// deltas of timestamps, and XOR of consecutive float values. For regularly
+/// sampled, slowly changing sensor readings, a sample takes a few bits, rather
+/// than 12 bytes. Works with any single-precision quantity class, including
+/// Temperature; decode with SeriesDecoder<Q>.
+///
+/// Timestamps are rounded to `time_resolution`; with regular sampling and
+/// jitter smaller than the resolution, each timestamp takes a single bit. The
+/// resolution is clamped to between 1 and 2^32 - 1 microseconds, the range
+/// that the stream header holds.
+/// Values are stored exactly, unless `resolution` is specified, in which case
+/// they are first rounded to a multiple of the largest power of two (in the
+/// raw unit, e.g. Celsius) not greater than `resolution`. Rounding both
+/// increases the number of repeated values, and clears the low bits of the
+/// others, which the XOR encoding then omits.
+///
+/// Example:
+///
+///   uint8_t buffer[4096];
+///   SeriesEncoder<Temperature> encoder(buffer, sizeof(buffer),
+///                                      roo_time::Millis(10),
+///                                      TemperatureDeltaDegCelcius(0.01f));
+///   ...
+///   if (!encoder.append(roo_time::Uptime::Now(), sensor.read())) {
+///     // Buffer full; flush it, and start a new encoder.
+///   }
+template <typename Q>
+class SeriesEncoder {
+ public:
+  using Delta = internal::DeltaType<Q>;
+
+  static_assert(
+      std::is_same<typename internal::RawTraits<Q>::Rep, float>::value,
+      "SeriesEncoder supports single-precision quantities only");
+
+  SeriesEncoder(uint8_t* buffer, size_t capacity,
+                const roo_time::Duration& time_resolution = roo_time::Micros(1),
+                const Delta& resolution = Delta())
+      : writer_(buffer, capacity,
+                static_cast<uint32_t>(TickMicros(time_resolution))),
+        tick_micros_(TickMicros(time_resolution)),
+        step_(0.0f),
+        inv_step_(0.0f) {
+    float r = internal::RawTraits<Delta>::ToRaw(resolution);
+    if (r > 0.0f) {
+      int exp;
+      std::frexp(r, &exp);
+      // r is in [2^(exp - 1), 2^exp).
+      step_ = std::ldexp(1.0f, exp - 1);
+      inv_step_ = 1.0f / step_;
+    }
+  }
+
+  /// Appends the sample. If it does not fit in the buffer, returns false,
+  /// leaving the stream as it was. Timestamps should be non-decreasing.
+  bool append(roo_time::Uptime t, const Q& q) {
+    float x = internal::RawTraits<Q>::ToRaw(q);
+    if (step_ != 0.0f) x = std::round(x * inv_step_) * step_;
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    int64_t micros = t.inMicros();
+    int64_t ticks = (micros >= 0 ? micros + tick_micros_ / 2
+                                 : micros - tick_micros_ / 2) /
+                    tick_micros_;
+    return writer_.append(ticks, bits);
+  }
+
+  /// Returns the number of samples written.
+  size_t count() const { return writer_.count(); }
+
+  /// Returns the number of bytes of the buffer used so far.
+  size_t size() const { return (writer_.sizeBits() + 7) / 8; }
+
+ private:
+  static int64_t TickMicros(const roo_time::Duration& time_resolution) {
+    int64_t micros = time_resolution.inMicros();
+    if (micros < 1) return 1;
+    if (micros > int64_t{0xFFFFFFFF}) return int64_t{0xFFFFFFFF};
+    return micros;
+  }
+
+  internal::GorillaWriter writer_;
+  int64_t tick_micros_;
+  float step_;
+  float inv_step_;
+};
+
+/// Decoder of series compressed by SeriesEncoder<Q>, yielding the samples as
+/// quantities of the same type.
+///
+/// Example:
+///
+///   SeriesDecoder<Temperature> decoder(buffer, encoder.size(),
+///                                      encoder.count());
+///   roo_time::Uptime t;
+///   Temperature temp;
+///   while (decoder.next(t, temp)) { ... }
+template <typename Q>
+class SeriesDecoder {
+ public:
+  static_assert(
+      std::is_same<typename internal::RawTraits<Q>::Rep, float>::value,
+      "SeriesDecoder supports single-precision quantities only");
+
+  /// Decodes `count` samples from the `size` bytes of `data`.
+  SeriesDecoder(const uint8_t* data, size_t size, size_t count)
+      : reader_(data, size, count) {}
+
+  /// Reads the next sample. Returns false, leaving the arguments unchanged, if
+  /// all the samples have been read.
+  bool next(roo_time::Uptime& t, Q& q) {
+    int64_t ticks;
+    uint32_t bits;
+    if (!reader_.next(ticks, bits)) return false;
+    float x;
+    memcpy(&x, &bits, sizeof(x));
+    t = roo_time::Uptime::Start() +
+        roo_time::Micros(ticks * static_cast<int64_t>(reader_.tickMicros()));
+    q = internal::RawTraits<Q>::FromRaw(x);
+    return true;
+  }
+
+  /// Decodes the remaining samples, up to q.size() of them, into `t` (which
+  /// must have room for q.size() elements) and `q`. Returns the number of
+  /// samples decoded.
+  size_t next(roo_time::Uptime* t, QuantitySpan<Q> q) {
+    size_t i = 0;
+    Q value;
+    while (i < q.size() && next(t[i], value)) q.set(i++, value);
+    return i;
+  }
+
+ private:
+  internal::GorillaReader reader_;
+};
+
+}  // namespace roo_quantity
@@ -1,22 +1,18 @@
 #include "roo_quantity/current.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void CurrentToString(const Current& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inAmperes(), "A", out, maxlen);
+size_t Current::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inAmperes(), "A", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Current::asString() const {
-  char out[16];
-  CurrentToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,13 @@ std::string Current::asString() const {
 #if defined(ARDUINO)
 
 String Current::asArduinoString() const {
-  char out[16];
-  CurrentToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Current& val) {
-  char out[16];
-  CurrentToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -0,0 +1,118 @@
+#include "roo_quantity/differentiator.h"
+
+#include "roo_quantity/simd.h"
+
+namespace roo_quantity {
+namespace internal {
+namespace {
+
+void ConvolveScalar(const float* in, size_t count, const float* weights,
+                    size_t k, float* out) {
+  for (size_t i = 0; i < count; ++i) {
+    float acc = 0.0f;
+    for (size_t j = 0; j < k; ++j) acc = acc + weights[j] * in[i + j];
+    out[i] = acc;
+  }
+}
+
+#ifdef ROO_QUANTITY_X86_SIMD
+
+// Both kernels compute several consecutive outputs at a time, as in the
+// scalar loop (no fused multiply-add).
+
+void ConvolveSse(const float* in, size_t count, const float* weights, size_t k,
+                 float* out) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 acc = _mm_setzero_ps();
+    for (size_t j = 0; j < k; ++j) {
+      acc = _mm_add_ps(
+          acc, _mm_mul_ps(_mm_set1_ps(weights[j]), _mm_loadu_ps(in + i + j)));
+    }
+    _mm_storeu_ps(out + i, acc);
+  }
+  ConvolveScalar(in + i, count - i, weights, k, out + i);
+}
+
+__attribute__((target("avx2"))) void ConvolveAvx2(const float* in,
+                                                   size_t count,
+                                                   const float* weights,
+                                                   size_t k, float* out) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t j = 0; j < k; ++j) {
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(weights[j]),
+                                             _mm256_loadu_ps(in + i + j)));
+    }
+    _mm256_storeu_ps(out + i, acc);
+  }
+  ConvolveSse(in + i, count - i, weights, k, out + i);
+}
+
+#endif  // ROO_QUANTITY_X86_SIMD
+
+// The least-squares slope of in[lo, hi], per sample interval.
+float ClippedSlope(const float* in, size_t lo, size_t hi) {
+  float t_mean = static_cast<float>(hi - lo) * 0.5f;
+  float stt = 0.0f;
+  float stx = 0.0f;
+  for (size_t j = lo; j <= hi; ++j) {
+    float t = static_cast<float>(j - lo) - t_mean;
+    stt += t * t;
+    stx += t * in[j];
+  }
+  return stx / stt;
+}
+
+}  // namespace
+
+void Convolve(const float* in, size_t n, const float* weights, size_t k,
+              float* out) {
+  if (k == 0 || n < k) return;
+  size_t count = n - k + 1;
+#ifdef ROO_QUANTITY_X86_SIMD
+  if (HasAvx2()) {
+    ConvolveAvx2(in, count, weights, k, out);
+  } else {
+    ConvolveSse(in, count, weights, k, out);
+  }
+#else
+  ConvolveScalar(in, count, weights, k, out);
+#endif
+}
+
+void LeastSquaresSlopes(const float* in, size_t n, size_t window, float dt,
+                        float* out) {
+  size_t h = window / 2;
+  if (h == 0) h = 1;
+  // Edges, where the window is clipped.
+  size_t head = h < n ? h : n;
+  size_t tail = n >= h && n - h > head ? n - h : head;
+  for (size_t i = 0; i < head; ++i) {
+    out[i] = ClippedSlope(in, 0, i + h < n ? i + h : n - 1) / dt;
+  }
+  for (size_t i = tail; i < n; ++i) {
+    out[i] = ClippedSlope(in, i >= h ? i - h : 0, n - 1) / dt;
+  }
+  if (n < 2 * h + 1) return;
+  // Interior. For the centered window, the slope is the sum of
+  // x[i + j] * j / sum(j^2), for j in [-h, h].
+  constexpr size_t kMaxWindow = 255;
+  if (2 * h + 1 > kMaxWindow) {
+    for (size_t i = h; i < n - h; ++i) {
+      out[i] = ClippedSlope(in, i - h, i + h) / dt;
+    }
+    return;
+  }
+  float weights[kMaxWindow];
+  float hf = static_cast<float>(h);
+  float norm = hf * (hf + 1.0f) * (2.0f * hf + 1.0f) / 3.0f * dt;
+  for (size_t j = 0; j <= 2 * h; ++j) {
+    weights[j] = (static_cast<float>(j) - hf) / norm;
+  }
+  Convolve(in, n, weights, 2 * h + 1, out + h);
+}
+
+}  // namespace internal
+}  // namespace roo_quantity
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <limits>
+
+#include "roo_logging.h"
+#include "roo_quantity/quantity.h"
+#include "roo_quantity/span.h"
+#include "roo_quantity/statistics.h"
+#include "roo_quantity/time.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// The type of the time derivative of Q; e.g. Velocity for Length, and
+/// TemperatureDelta / Time for Temperature.
+template <typename Q>
+using DerivativeType = QuotientOf<DeltaType<Q>, Time>;
+
+/// Computes out[i] = sum(weights[j] * in[i + j]) for j in [0, k), for i in
+/// [0, n - k + 1). Vectorized; each product and sum is rounded separately, in
+/// the order of increasing j, so the results do not depend on the code path.
+void Convolve(const float* in, size_t n, const float* weights, size_t k,
+              float* out);
+
+/// Computes the least-squares slopes of in[0, n), sampled every `dt`, over
+/// windows of `window` samples (odd) centered at each element and clipped at
+/// the ends of the array. See Differentiate().
+void LeastSquaresSlopes(const float* in, size_t n, size_t window, float dt,
+                        float* out);
+
+/// Weights w such that sum(w[k] * x[k]) is the slope, at the last point, of
+/// the parabola least-squares fitted to N uniformly spaced points x[0, N),
+/// sampled at unit intervals.
+template <size_t N>
+struct SavitzkyGolayWeights {
+  double w[N];
+
+  constexpr SavitzkyGolayWeights() : w() {
+    // Power sums of the sample positions t = k - (N - 1), i.e. -(N - 1)..0.
+    double s[5] = {0, 0, 0, 0, 0};
+    for (size_t k = 0; k < N; ++k) {
+      double t = static_cast<double>(k) - static_cast<double>(N - 1);
+      double p = 1;
+      for (int e = 0; e < 5; ++e) {
+        s[e] += p;
+        p *= t;
+      }
+    }
+    // The linear coefficient of the fit is row 1 of the inverse of the
+    // (Hankel) normal matrix, [s0 s1 s2; s1 s2 s3; s2 s3 s4], applied to the
+    // moments sum(t^j * x). Expand the inverse via cofactors.
+    double det = s[0] * (s[2] * s[4] - s[3] * s[3]) -
+                 s[1] * (s[1] * s[4] - s[3] * s[2]) +
+                 s[2] * (s[1] * s[3] - s[2] * s[2]);
+    double c0 = -(s[1] * s[4] - s[3] * s[2]);
+    double c1 = s[0] * s[4] - s[2] * s[2];
+    double c2 = -(s[0] * s[3] - s[2] * s[1]);
+    for (size_t k = 0; k < N; ++k) {
+      double t = static_cast<double>(k) - static_cast<double>(N - 1);
+      w[k] = (c0 + c1 * t + c2 * t * t) / det;
+    }
+  }
+};
+
+}  // namespace internal
+
+// Estimators of the rate of change of a sampled quantity. The derivative of Q
+// over Time has the corresponding type, e.g. Velocity for Length,
+// VolumeFlowRate for Volume, and Current for Charge. For Temperature, it is
+// TemperatureDelta / Time.
+
+/// Estimates the derivative as the difference between the last two samples,
+/// divided by the time between them. Responds immediately, but amplifies
+/// noise; see LeastSquaresSlope and SavitzkyGolayDerivative for smoother
+/// estimates.
+///
+/// Example:
+///
+///   FiniteDifference<Length> speed;
+///   ...
+///   speed.addSample(encoder.position(), TimeElapsed(last_time, now));
+///   Velocity v = speed.derivative();
+template <typename Q>
+class FiniteDifference {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+  using Derivative = internal::DerivativeType<Q>;
+
+  constexpr FiniteDifference()
+      : prev_(std::numeric_limits<Rep>::quiet_NaN()),
+        derivative_(std::numeric_limits<Rep>::quiet_NaN()) {}
+
+  /// Adds a sample, taken `dt` after the previous one (`dt` of the first
+  /// sample is ignored).
+  void addSample(const Q& q, const Time& dt) {
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    derivative_ = (x - prev_) / static_cast<Rep>(dt.inSeconds());
+    prev_ = x;
+  }
+
+  /// Returns the derivative estimated from the last two samples, or unknown
+  /// if there have been fewer than two, or if either of them was unknown.
+  Derivative derivative() const { return Derivative::FromSiUnits(derivative_); }
+
+  /// Forgets all samples.
+  void reset() { *this = FiniteDifference(); }
+
+ private:
+  Rep prev_;
+  Rep derivative_;
+};
+
+/// Estimates the derivative as the slope of the straight line least-squares
+/// fitted to the last N samples. The samples need not be uniformly spaced;
+/// unknown samples are skipped. Averages out noise, at the cost of a lag of
+/// about half the window. derivative() takes O(N) time.
+template <typename Q, size_t N>
+class LeastSquaresSlope {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+  using Derivative = internal::DerivativeType<Q>;
+
+  static_assert(N >= 2, "The window must have at least two samples");
+
+  constexpr LeastSquaresSlope() : x_(), dt_(), pos_(0), count_(0) {}
+
+  /// Adds a sample, taken `dt` after the previous one (`dt` of the first
+  /// sample is ignored).
+  void addSample(const Q& q, const Time& dt) {
+    x_[pos_] = internal::RawTraits<Q>::ToRaw(q);
+    dt_[pos_] = static_cast<Rep>(dt.inSeconds());
+    pos_ = (pos_ + 1) % N;
+    if (count_ < N) ++count_;
+  }
+
+  /// Returns the slope over the last N samples (or all of them, if fewer),
+  /// or unknown if fewer than two of them are known.
+  Derivative derivative() const {
+    // Sample times relative to the newest sample, which is at t = 0.
+    Rep t[N];
+    Rep elapsed = 0;
+    size_t known = 0;
+    Rep t_sum = 0;
+    Rep x_sum = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      size_t k = (pos_ + N - 1 - i) % N;
+      t[i] = -elapsed;
+      elapsed += dt_[k];
+      if (x_[k] != x_[k]) continue;
+      ++known;
+      t_sum += t[i];
+      x_sum += x_[k];
+    }
+    if (known < 2) return Derivative();
+    Rep t_mean = t_sum / static_cast<Rep>(known);
+    Rep x_mean = x_sum / static_cast<Rep>(known);
+    Rep stt = 0;
+    Rep stx = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      size_t k = (pos_ + N - 1 - i) % N;
+      if (x_[k] != x_[k]) continue;
+      Rep dt = t[i] - t_mean;
+      stt += dt * dt;
+      stx += dt * (x_[k] - x_mean);
+    }
+    return Derivative::FromSiUnits(stx / stt);
+  }
+
+  /// Forgets all samples.
+  void reset() { *this = LeastSquaresSlope(); }
+
+ private:
+  Rep x_[N];
+  // dt_[k] is the time between sample k and its predecessor.
+  Rep dt_[N];
+  size_t pos_;
+  size_t count_;
+};
+
+/// Estimates the derivative at the newest of N uniformly spaced samples, as
+/// the slope of the parabola least-squares fitted to them (a causal
+/// Savitzky-Golay differentiator). Tracks changes in slope more closely than
+/// LeastSquaresSlope, with somewhat less noise suppression. An unknown sample
+/// makes the derivative unknown until it leaves the window.
+template <typename Q, size_t N>
+class SavitzkyGolayDerivative {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+  using Derivative = internal::DerivativeType<Q>;
+
+  static_assert(N >= 3, "The window must have at least three samples");
+
+  /// Creates a differentiator of samples taken every `dt`.
+  explicit SavitzkyGolayDerivative(const Time& dt)
+      : x_(), pos_(0), count_(0) {
+    constexpr internal::SavitzkyGolayWeights<N> weights;
+    for (size_t k = 0; k < N; ++k) {
+      weights_[k] = static_cast<Rep>(weights.w[k]) /
+                    static_cast<Rep>(dt.inSeconds());
+    }
+  }
+
+  /// Adds the next sample.
+  void addSample(const Q& q) {
+    x_[pos_] = internal::RawTraits<Q>::ToRaw(q);
+    pos_ = (pos_ + 1) % N;
+    if (count_ < N) ++count_;
+  }
+
+  /// Returns the derivative at the newest sample, or unknown if fewer than N
+  /// samples have been added.
+  Derivative derivative() const {
+    if (count_ < N) return Derivative();
+    Rep result = 0;
+    for (size_t k = 0; k < N; ++k) {
+      result += weights_[k] * x_[(pos_ + k) % N];
+    }
+    return Derivative::FromSiUnits(result);
+  }
+
+  /// Forgets all samples.
+  void reset() {
+    pos_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  Rep weights_[N];
+  Rep x_[N];
+  size_t pos_;
+  size_t count_;
+};
+
+/// Computes the derivative of uniformly spaced samples, `dt` apart: out[i] is
+/// the slope of the straight line least-squares fitted to the `window`
+/// samples centered at in[i]. At the ends of the array, the window is clipped.
+/// `window` must be odd, and at least 3; with the default of 3, out[i] is
+/// (in[i + 1] - in[i - 1]) / (2 * dt), or the one-sided difference at the
+/// ends. (For a centered window, this is also the Savitzky-Golay derivative
+/// of quadratic order.) Wider windows suppress more noise. Unknown samples
+/// make the outputs whose windows include them unknown.
+///
+/// `out` must have in.size() elements, of the type of the derivative; e.g.
+///
+///   Differentiate(positions, TimeInMicroseconds(10), velocities, 9);
+///
+/// Both requirements are checked in debug builds. (Otherwise, only the first
+/// min(in.size(), out.size()) outputs are computed.) The interior of the array
+/// is vectorized.
+template <typename Q>
+void Differentiate(QuantitySpan<Q> in, const Time& dt,
+                   QuantitySpan<internal::DerivativeType<Q>> out,
+                   size_t window = 3) {
+  internal::CheckStatistics<Q>();
+  internal::CheckElementwise<internal::DerivativeType<Q>>();
+  DCHECK_EQ(in.size(), out.size());
+  DCHECK_GE(window, 3u);
+  DCHECK_EQ(window % 2, 1u);
+  size_t n = in.size() < out.size() ? in.size() : out.size();
+  internal::LeastSquaresSlopes(in.data(), n, window, dt.inSeconds(),
+                               out.data());
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,143 @@
+#include "roo_quantity/filter.h"
+
+#include "roo_quantity/simd.h"
+
+namespace roo_quantity {
+namespace internal {
+namespace {
+
+// Rows of the coefficient and state arrays; see BiquadBankStep().
+enum { kB0, kB1, kB2, kA1, kA2, kGain };
+enum { kZ1, kZ2, kY };
+
+// Processes channels [begin, end) of n.
+void BiquadBankStepScalar(const float* in, float* out, size_t begin,
+                          size_t end, size_t n, const float* c, float* s) {
+  for (size_t i = begin; i < end; ++i) {
+    float x = in[i];
+    float y_prev = s[kY * n + i];
+    if (x != x) {
+      out[i] = y_prev;
+      continue;
+    }
+    float b1x = c[kB1 * n + i] * x;
+    float b2x = c[kB2 * n + i] * x;
+    float y;
+    if (y_prev != y_prev) {
+      y = x * c[kGain * n + i];
+      s[kZ2 * n + i] = b2x - c[kA2 * n + i] * y;
+      s[kZ1 * n + i] = b1x - c[kA1 * n + i] * y + s[kZ2 * n + i];
+    } else {
+      y = c[kB0 * n + i] * x + s[kZ1 * n + i];
+      s[kZ1 * n + i] = b1x - c[kA1 * n + i] * y + s[kZ2 * n + i];
+      s[kZ2 * n + i] = b2x - c[kA2 * n + i] * y;
+    }
+    s[kY * n + i] = y;
+    out[i] = y;
+  }
+}
+
+#ifdef ROO_QUANTITY_X86_SIMD
+
+// The vector kernels process channels from `begin` while whole vectors fit
+// before `end`, and return the first unprocessed one. They compute both the
+// regular and the initial update, and select per lane. Operations are the
+// same, and in the same order, as in the scalar loop.
+
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+size_t BiquadBankStepSse(const float* in, float* out, size_t begin,
+                         size_t end, size_t n, const float* c, float* s) {
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    __m128 x = _mm_loadu_ps(in + i);
+    __m128 y_prev = _mm_loadu_ps(s + kY * n + i);
+    __m128 z1 = _mm_loadu_ps(s + kZ1 * n + i);
+    __m128 z2 = _mm_loadu_ps(s + kZ2 * n + i);
+    __m128 a1 = _mm_loadu_ps(c + kA1 * n + i);
+    __m128 a2 = _mm_loadu_ps(c + kA2 * n + i);
+    __m128 known = _mm_cmpord_ps(x, x);
+    __m128 first = _mm_cmpunord_ps(y_prev, y_prev);
+    __m128 b1x = _mm_mul_ps(_mm_loadu_ps(c + kB1 * n + i), x);
+    __m128 b2x = _mm_mul_ps(_mm_loadu_ps(c + kB2 * n + i), x);
+    // Initial update.
+    __m128 y_init = _mm_mul_ps(x, _mm_loadu_ps(c + kGain * n + i));
+    __m128 z2_init = _mm_sub_ps(b2x, _mm_mul_ps(a2, y_init));
+    __m128 z1_init =
+        _mm_add_ps(_mm_sub_ps(b1x, _mm_mul_ps(a1, y_init)), z2_init);
+    // Regular update.
+    __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(c + kB0 * n + i), x), z1);
+    __m128 z1_next = _mm_add_ps(_mm_sub_ps(b1x, _mm_mul_ps(a1, y)), z2);
+    __m128 z2_next = _mm_sub_ps(b2x, _mm_mul_ps(a2, y));
+    y = Select(first, y_init, y);
+    z1_next = Select(first, z1_init, z1_next);
+    z2_next = Select(first, z2_init, z2_next);
+    // Unknown inputs leave the state unchanged.
+    y = Select(known, y, y_prev);
+    _mm_storeu_ps(s + kZ1 * n + i, Select(known, z1_next, z1));
+    _mm_storeu_ps(s + kZ2 * n + i, Select(known, z2_next, z2));
+    _mm_storeu_ps(s + kY * n + i, y);
+    _mm_storeu_ps(out + i, y);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) inline __m256 Select256(__m256 mask, __m256 a,
+                                                        __m256 b) {
+  return _mm256_blendv_ps(b, a, mask);
+}
+
+__attribute__((target("avx2"))) size_t BiquadBankStepAvx2(
+    const float* in, float* out, size_t begin, size_t end, size_t n,
+    const float* c, float* s) {
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m256 x = _mm256_loadu_ps(in + i);
+    __m256 y_prev = _mm256_loadu_ps(s + kY * n + i);
+    __m256 z1 = _mm256_loadu_ps(s + kZ1 * n + i);
+    __m256 z2 = _mm256_loadu_ps(s + kZ2 * n + i);
+    __m256 a1 = _mm256_loadu_ps(c + kA1 * n + i);
+    __m256 a2 = _mm256_loadu_ps(c + kA2 * n + i);
+    __m256 known = _mm256_cmp_ps(x, x, _CMP_ORD_Q);
+    __m256 first = _mm256_cmp_ps(y_prev, y_prev, _CMP_UNORD_Q);
+    __m256 b1x = _mm256_mul_ps(_mm256_loadu_ps(c + kB1 * n + i), x);
+    __m256 b2x = _mm256_mul_ps(_mm256_loadu_ps(c + kB2 * n + i), x);
+    __m256 y_init = _mm256_mul_ps(x, _mm256_loadu_ps(c + kGain * n + i));
+    __m256 z2_init = _mm256_sub_ps(b2x, _mm256_mul_ps(a2, y_init));
+    __m256 z1_init =
+        _mm256_add_ps(_mm256_sub_ps(b1x, _mm256_mul_ps(a1, y_init)), z2_init);
+    __m256 y = _mm256_add_ps(
+        _mm256_mul_ps(_mm256_loadu_ps(c + kB0 * n + i), x), z1);
+    __m256 z1_next =
+        _mm256_add_ps(_mm256_sub_ps(b1x, _mm256_mul_ps(a1, y)), z2);
+    __m256 z2_next = _mm256_sub_ps(b2x, _mm256_mul_ps(a2, y));
+    y = Select256(first, y_init, y);
+    z1_next = Select256(first, z1_init, z1_next);
+    z2_next = Select256(first, z2_init, z2_next);
+    y = Select256(known, y, y_prev);
+    _mm256_storeu_ps(s + kZ1 * n + i, Select256(known, z1_next, z1));
+    _mm256_storeu_ps(s + kZ2 * n + i, Select256(known, z2_next, z2));
+    _mm256_storeu_ps(s + kY * n + i, y);
+    _mm256_storeu_ps(out + i, y);
+  }
+  return i;
+}
+
+#endif  // ROO_QUANTITY_X86_SIMD
+
+}  // namespace
+
+void BiquadBankStep(const float* in, float* out, size_t n,
+                    const float* coefficients, float* state) {
+  size_t i = 0;
+#ifdef ROO_QUANTITY_X86_SIMD
+  if (HasAvx2()) i = BiquadBankStepAvx2(in, out, 0, n, n, coefficients, state);
+  i = BiquadBankStepSse(in, out, i, n, n, coefficients, state);
+#endif
+  BiquadBankStepScalar(in, out, i, n, n, coefficients, state);
+}
+
+}  // namespace internal
+}  // namespace roo_quantity
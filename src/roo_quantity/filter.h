@@ -0,0 +1,270 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "roo_quantity/frequency.h"
+#include "roo_quantity/span.h"
+#include "roo_quantity/time.h"
+
+namespace roo_quantity {
+
+// Smoothing filters for streams of quantities. All of them accept any
+// quantity class, including Temperature, and return the filtered value as the
+// same type. They start from the first known sample (as if the input had
+// always been at that value, rather than ramping up from zero), and ignore
+// unknown samples, returning the previous output instead.
+
+/// Exponential moving average: y += alpha * (x - y). Smaller alpha smooths
+/// more; alpha = 1 passes the input through.
+template <typename Q>
+class Ema {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  /// Creates the filter with the specified smoothing factor, in (0, 1].
+  explicit constexpr Ema(float alpha)
+      : alpha_(static_cast<Rep>(alpha)),
+        y_(std::numeric_limits<Rep>::quiet_NaN()) {}
+
+  /// Adds the next sample, and returns the updated average.
+  Q update(const Q& q) {
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    if (x == x) y_ = (y_ != y_) ? x : y_ + alpha_ * (x - y_);
+    return value();
+  }
+
+  /// Returns the current average, or unknown if there have been no known
+  /// samples.
+  Q value() const { return internal::RawTraits<Q>::FromRaw(y_); }
+
+  /// Forgets all samples.
+  void reset() { y_ = std::numeric_limits<Rep>::quiet_NaN(); }
+
+ private:
+  Rep alpha_;
+  Rep y_;
+};
+
+/// First-order (RC) low-pass filter with the specified cutoff frequency.
+/// Unlike Ema, takes the time since the previous sample, so it behaves the
+/// same regardless of the (possibly irregular) sampling rate.
+template <typename Q>
+class LowPassFilter {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  /// Creates the filter with the specified -3 dB cutoff frequency.
+  explicit LowPassFilter(const Frequency& cutoff)
+      : omega_(static_cast<Rep>(2.0f * static_cast<float>(M_PI) *
+                                cutoff.inHertz())),
+        y_(std::numeric_limits<Rep>::quiet_NaN()) {}
+
+  /// Adds the next sample, taken `dt` after the previous one, and returns the
+  /// updated output.
+  Q update(const Q& q, const Time& dt) {
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    if (x != x) return value();
+    if (y_ != y_) {
+      y_ = x;
+    } else {
+      Rep alpha = 1 - std::exp(-omega_ * static_cast<Rep>(dt.inSeconds()));
+      y_ += alpha * (x - y_);
+    }
+    return value();
+  }
+
+  /// Returns the current output, or unknown if there have been no known
+  /// samples.
+  Q value() const { return internal::RawTraits<Q>::FromRaw(y_); }
+
+  /// Forgets all samples.
+  void reset() { y_ = std::numeric_limits<Rep>::quiet_NaN(); }
+
+ private:
+  Rep omega_;
+  Rep y_;
+};
+
+/// Coefficients of a biquad (second-order IIR) filter, normalized so that
+/// a0 = 1:
+///
+///   y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+///
+/// Use the factory functions below to design common filters.
+struct BiquadCoefficients {
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+
+  /// Returns the gain at zero frequency (the steady-state output for a
+  /// constant input of 1).
+  float dcGain() const { return (b0 + b1 + b2) / (1.0f + a1 + a2); }
+};
+
+/// Returns the coefficients of the exponential moving average with the
+/// specified smoothing factor (see Ema).
+inline BiquadCoefficients BiquadEma(float alpha) {
+  return BiquadCoefficients{alpha, 0.0f, 0.0f, alpha - 1.0f, 0.0f};
+}
+
+/// Returns the coefficients of the second-order low-pass filter with the
+/// specified cutoff frequency and quality factor (1/sqrt(2), the default, is
+/// the maximally flat Butterworth response), for the specified sampling rate.
+/// (From the 'Audio EQ Cookbook' by R. Bristow-Johnson.)
+inline BiquadCoefficients BiquadLowPass(const Frequency& cutoff,
+                                        const Frequency& sample_rate,
+                                        float q = 0.70710678f) {
+  float w0 = 2.0f * static_cast<float>(M_PI) * cutoff.inHertz() /
+             sample_rate.inHertz();
+  float cos_w0 = std::cos(w0);
+  float alpha = std::sin(w0) / (2.0f * q);
+  float a0 = 1.0f + alpha;
+  float b1 = (1.0f - cos_w0) / a0;
+  return BiquadCoefficients{b1 * 0.5f, b1, b1 * 0.5f, -2.0f * cos_w0 / a0,
+                            (1.0f - alpha) / a0};
+}
+
+/// Returns the coefficients of the second-order high-pass filter; see
+/// BiquadLowPass(). (Applied to Temperature, the output of a high-pass filter
+/// is a difference, not a temperature; use TemperatureDelta instead.)
+inline BiquadCoefficients BiquadHighPass(const Frequency& cutoff,
+                                         const Frequency& sample_rate,
+                                         float q = 0.70710678f) {
+  float w0 = 2.0f * static_cast<float>(M_PI) * cutoff.inHertz() /
+             sample_rate.inHertz();
+  float cos_w0 = std::cos(w0);
+  float alpha = std::sin(w0) / (2.0f * q);
+  float a0 = 1.0f + alpha;
+  float b1 = -(1.0f + cos_w0) / a0;
+  return BiquadCoefficients{-b1 * 0.5f, b1, -b1 * 0.5f, -2.0f * cos_w0 / a0,
+                            (1.0f - alpha) / a0};
+}
+
+/// Biquad filter, in transposed direct form II. See BiquadCoefficients.
+template <typename Q>
+class Biquad {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  explicit constexpr Biquad(const BiquadCoefficients& coefficients)
+      : c_(coefficients),
+        z1_(0),
+        z2_(0),
+        y_(std::numeric_limits<Rep>::quiet_NaN()) {}
+
+  /// Adds the next sample, and returns the updated output.
+  Q update(const Q& q) {
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    if (x != x) return value();
+    Rep b0 = static_cast<Rep>(c_.b0);
+    Rep b1 = static_cast<Rep>(c_.b1);
+    Rep b2 = static_cast<Rep>(c_.b2);
+    Rep a1 = static_cast<Rep>(c_.a1);
+    Rep a2 = static_cast<Rep>(c_.a2);
+    // Before the first sample, assume the steady state for a constant input.
+    Rep y = (y_ != y_) ? x * static_cast<Rep>(c_.dcGain()) : b0 * x + z1_;
+    if (y_ != y_) {
+      z2_ = b2 * x - a2 * y;
+      z1_ = b1 * x - a1 * y + z2_;
+    } else {
+      z1_ = b1 * x - a1 * y + z2_;
+      z2_ = b2 * x - a2 * y;
+    }
+    y_ = y;
+    return value();
+  }
+
+  /// Returns the current output, or unknown if there have been no known
+  /// samples.
+  Q value() const { return internal::RawTraits<Q>::FromRaw(y_); }
+
+  /// Forgets all samples.
+  void reset() { y_ = std::numeric_limits<Rep>::quiet_NaN(); }
+
+ private:
+  BiquadCoefficients c_;
+  Rep z1_;
+  Rep z2_;
+  Rep y_;
+};
+
+namespace internal {
+
+/// Advances a bank of n biquad filters by one sample each. `coefficients`
+/// holds 6 rows of n values each: b0, b1, b2, a1, a2, and the DC gain;
+/// `state` holds 3 rows: z1, z2, and the last output (NaN if none). Computes
+/// exactly what Biquad<Q>::update() does for each channel, vectorized across
+/// channels.
+void BiquadBankStep(const float* in, float* out, size_t n,
+                    const float* coefficients, float* state);
+
+}  // namespace internal
+
+/// A bank of kChannels biquad filters, e.g. smoothing all the sensors of a
+/// device, advanced together by one sample per channel. The state is stored
+/// channel-wise in contiguous arrays (structure of arrays), so that the
+/// channels are processed with SIMD. Each channel computes exactly what a
+/// separate Biquad<Q> would. Supports single-precision quantities.
+///
+/// Example:
+///
+///   FilterBank<Temperature, 32> smoothed(BiquadEma(0.1f));
+///   Temperature raw[32], filtered[32];
+///   ...
+///   smoothed.update(raw, filtered);
+template <typename Q, size_t kChannels>
+class FilterBank {
+ public:
+  static_assert(
+      std::is_same<typename internal::RawTraits<Q>::Rep, float>::value,
+      "FilterBank supports single-precision quantities only");
+
+  /// Creates a bank with all channels using the same coefficients.
+  explicit FilterBank(const BiquadCoefficients& coefficients) {
+    for (size_t i = 0; i < kChannels; ++i) setCoefficients(i, coefficients);
+    reset();
+  }
+
+  /// Changes the coefficients of the specified channel.
+  void setCoefficients(size_t channel, const BiquadCoefficients& c) {
+    coefficients_[0][channel] = c.b0;
+    coefficients_[1][channel] = c.b1;
+    coefficients_[2][channel] = c.b2;
+    coefficients_[3][channel] = c.a1;
+    coefficients_[4][channel] = c.a2;
+    coefficients_[5][channel] = c.dcGain();
+  }
+
+  /// Adds the next sample of each channel, and writes the updated outputs.
+  /// Both spans must have kChannels elements; `out` may alias `in`.
+  void update(QuantitySpan<const Q> in, QuantitySpan<Q> out) {
+    internal::BiquadBankStep(in.data(), out.data(), kChannels,
+                             &coefficients_[0][0], &state_[0][0]);
+  }
+
+  /// Returns the current output of the specified channel.
+  Q value(size_t channel) const {
+    return internal::RawTraits<Q>::FromRaw(state_[2][channel]);
+  }
+
+  /// Forgets all samples.
+  void reset() {
+    for (size_t i = 0; i < kChannels; ++i) {
+      state_[0][i] = 0.0f;
+      state_[1][i] = 0.0f;
+      state_[2][i] = std::numeric_limits<float>::quiet_NaN();
+    }
+  }
+
+ private:
+  float coefficients_[6][kChannels];
+  float state_[3][kChannels];
+};
+
+}  // namespace roo_quantity
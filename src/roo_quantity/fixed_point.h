@@ -0,0 +1,390 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "roo_logging.h"
+#include "roo_quantity/format.h"
+#include "roo_quantity/quantity.h"
+#include "roo_quantity/si.h"
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+#include <string>
+#endif
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+
+namespace roo_quantity {
+
+namespace internal {
+
+constexpr int64_t Pow10(int n) { return n == 0 ? 1 : 10 * Pow10(n - 1); }
+
+/// Returns n / d, rounded to nearest, with ties away from zero. Requires
+/// d != 0.
+constexpr int64_t DivRound(int64_t n, int64_t d) {
+  return ((n < 0) == (d < 0)) ? (n + d / 2) / d : (n - d / 2) / d;
+}
+
+/// Converts `val`, expressed in units of 10^From, to units of 10^To, rounding
+/// to nearest.
+template <int From, int To>
+constexpr int64_t Rescale(int64_t val) {
+  return From >= To ? val * Pow10(From >= To ? From - To : 0)
+                    : DivRound(val, Pow10(From < To ? To - From : 0));
+}
+
+/// Returns whether a * b fits in int64_t.
+constexpr bool MulFits(int64_t a, int64_t b) {
+  return a == 0 || b == 0 ||
+         (a > 0 ? (b > 0 ? a <= std::numeric_limits<int64_t>::max() / b
+                         : b >= std::numeric_limits<int64_t>::min() / a)
+                : (b > 0 ? a >= std::numeric_limits<int64_t>::min() / b
+                         : a >= std::numeric_limits<int64_t>::max() / b));
+}
+
+/// Returns whether Rescale<From, To>(val) fits in int64_t.
+template <int From, int To>
+constexpr bool RescaleFits(int64_t val) {
+  return From < To || MulFits(val, Pow10(From >= To ? From - To : 0));
+}
+
+/// Returns the fixed-point quantity with the specified count, or 'unknown' if
+/// the count does not fit in its representation.
+template <typename Result>
+constexpr Result FromCountOrUnknown(int64_t count) {
+  return count > std::numeric_limits<typename Result::Rep>::min() &&
+                 count <= std::numeric_limits<typename Result::Rep>::max()
+             ? Result::FromCount((typename Result::Rep)count)
+             : Result();
+}
+
+/// Base unit symbols of the dimensions that fixed-point quantities can be
+/// formatted in.
+template <typename D>
+struct SiSymbol;
+
+template <>
+struct SiSymbol<dimension::Voltage> {
+  static constexpr const char* value = "V";
+};
+
+template <>
+struct SiSymbol<dimension::Current> {
+  static constexpr const char* value = "A";
+};
+
+template <>
+struct SiSymbol<dimension::Power> {
+  static constexpr const char* value = "W";
+};
+
+template <>
+struct SiSymbol<dimension::Resistance> {
+  static constexpr const char* value = "Ω";
+};
+
+template <>
+struct SiSymbol<dimension::Charge> {
+  static constexpr const char* value = "C";
+};
+
+template <>
+struct SiSymbol<dimension::Capacitance> {
+  static constexpr const char* value = "F";
+};
+
+template <>
+struct SiSymbol<dimension::Time> {
+  static constexpr const char* value = "s";
+};
+
+template <>
+struct SiSymbol<dimension::Work> {
+  static constexpr const char* value = "J";
+};
+
+}  // namespace internal
+
+/// Quantity of dimension D, stored as an integer count of 10^Exp10 SI units.
+/// For example, FixedQuantity<dimension::Voltage, -6> stores microVolts.
+///
+/// Meant for targets without an FPU (e.g. ESP8266), where float arithmetic is
+/// emulated in software. All arithmetic, including products and quotients of
+/// different quantities, and formatting, uses integers only. Products and
+/// quotients are computed in 64 bits and rounded to nearest.
+///
+/// The 'unknown' value is represented by the smallest value of Int. Products
+/// and quotients of quantities propagate it, like the float classes, and
+/// yield it on division by zero, and when the result does not fit in its
+/// representation. Other arithmetic (with scalars, and of the same quantity)
+/// does not propagate it, nor detect overflow; check isUnknown() before
+/// computing.
+template <typename D, int Exp10, typename Int = int32_t>
+class FixedQuantity {
+ public:
+  static_assert(std::is_integral<Int>::value && std::is_signed<Int>::value,
+                "FixedQuantity requires a signed integer representation");
+
+  using Dim = D;
+  using Rep = Int;
+
+  /// Decimal exponent of the unit of the stored count.
+  static constexpr int exp10 = Exp10;
+
+  /// Creates an object representing an 'unknown' quantity.
+  constexpr FixedQuantity() : count_(std::numeric_limits<Int>::min()) {}
+
+  /// Converts from the float-backed quantity of the same dimension, rounding
+  /// to nearest. Unknown converts to unknown.
+  explicit constexpr FixedQuantity(const Quantity<D, float>& val)
+      : count_(FromFloat(val.inSiUnits())) {}
+
+  /// Returns a quantity equal to `count` * 10^Exp10 SI units.
+  static constexpr FixedQuantity FromCount(Int count) {
+    FixedQuantity result;
+    result.count_ = count;
+    return result;
+  }
+
+  /// Returns a quantity equal to `val` * 10^E SI units, rounded to nearest.
+  template <int E>
+  static constexpr FixedQuantity FromScaled(int64_t val) {
+    return FromCount((Int)internal::Rescale<E, Exp10>(val));
+  }
+
+  /// Returns the stored count, in units of 10^Exp10 SI units.
+  constexpr Int count() const { return count_; }
+
+  /// Returns the value in units of 10^E SI units, rounded to nearest.
+  template <int E>
+  constexpr int64_t inScaled() const {
+    return internal::Rescale<Exp10, E>(count_);
+  }
+
+  /// Converts to the float-backed quantity of the same dimension.
+  constexpr Quantity<D, float> toFloat() const {
+    return Quantity<D, float>::FromSiUnits(
+        isUnknown() ? internal::kUnknownValue : (float)count_ * kUnit);
+  }
+
+  /// Returns whether the object represents an unknown quantity.
+  constexpr bool isUnknown() const {
+    return count_ == std::numeric_limits<Int>::min();
+  }
+
+  constexpr bool operator<(const FixedQuantity& other) const {
+    return count_ < other.count_;
+  }
+
+  constexpr bool operator==(const FixedQuantity& other) const {
+    return count_ == other.count_;
+  }
+
+  constexpr bool operator>(const FixedQuantity& other) const {
+    return other.count_ < count_;
+  }
+
+  constexpr bool operator<=(const FixedQuantity& other) const {
+    return !(other.count_ < count_);
+  }
+
+  constexpr bool operator>=(const FixedQuantity& other) const {
+    return !(count_ < other.count_);
+  }
+
+  constexpr bool operator!=(const FixedQuantity& other) const {
+    return !(count_ == other.count_);
+  }
+
+  constexpr FixedQuantity& operator+=(const FixedQuantity& other) {
+    count_ += other.count_;
+    return *this;
+  }
+
+  constexpr FixedQuantity& operator-=(const FixedQuantity& other) {
+    count_ -= other.count_;
+    return *this;
+  }
+
+  constexpr FixedQuantity& operator*=(Int multi) {
+    count_ *= multi;
+    return *this;
+  }
+
+  constexpr FixedQuantity& operator/=(Int div) {
+    count_ /= div;
+    return *this;
+  }
+
+  friend constexpr FixedQuantity operator+(FixedQuantity a, FixedQuantity b) {
+    return FromCount(a.count_ + b.count_);
+  }
+
+  friend constexpr FixedQuantity operator-(FixedQuantity a, FixedQuantity b) {
+    return FromCount(a.count_ - b.count_);
+  }
+
+  friend constexpr FixedQuantity operator-(FixedQuantity a) {
+    return FromCount(-a.count_);
+  }
+
+  friend constexpr FixedQuantity operator*(FixedQuantity a, Int b) {
+    return FromCount(a.count_ * b);
+  }
+
+  friend constexpr FixedQuantity operator*(Int a, FixedQuantity b) {
+    return FromCount(a * b.count_);
+  }
+
+  friend constexpr FixedQuantity operator/(FixedQuantity a, Int b) {
+    return FromCount(a.count_ / b);
+  }
+
+  /// Writes the string representation of the quantity into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate,
+  /// and does not use floating-point arithmetic.
+  size_t formatTo(char* out, size_t maxlen) const {
+    return FormatFixedSiValue(
+        isUnknown() ? std::numeric_limits<int64_t>::min() : (int64_t)count_,
+        Exp10, internal::SiSymbol<D>::value, out, maxlen);
+  }
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+  /// Returns the string representation of the quantity.
+  std::string asString() const { return internal::FormatAsString(*this); }
+#endif
+
+#if defined(ARDUINO)
+  String asArduinoString() const {
+    return internal::FormatAsArduinoString(*this);
+  }
+#endif
+
+ private:
+  // The SI value of a count of one, and its reciprocal. Powers of ten up to
+  // 10^10 are exact in float.
+  static constexpr float kUnit =
+      Exp10 >= 0 ? (float)internal::Pow10(Exp10 >= 0 ? Exp10 : 0)
+                 : 1.0f / (float)internal::Pow10(Exp10 < 0 ? -Exp10 : 0);
+  static constexpr float kCountsPerUnit =
+      Exp10 <= 0 ? (float)internal::Pow10(Exp10 <= 0 ? -Exp10 : 0)
+                 : 1.0f / (float)internal::Pow10(Exp10 > 0 ? Exp10 : 0);
+
+  static constexpr Int FromFloat(float val) {
+    if (val != val) return std::numeric_limits<Int>::min();
+    float scaled = val * kCountsPerUnit;
+    return (Int)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+  }
+
+  Int count_;
+};
+
+template <typename D, int Exp10, typename Int>
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const FixedQuantity<D, Exp10, Int>& val) {
+  return internal::FormatToStream(os, val);
+}
+
+/// Voltage, stored as 32-bit microVolts (range: +/- 2147 V).
+using FixedVoltage = FixedQuantity<dimension::Voltage, -6>;
+
+/// Current, stored as 32-bit microAmperes (range: +/- 2147 A).
+using FixedCurrent = FixedQuantity<dimension::Current, -6>;
+
+/// Power, stored as 64-bit microWatts.
+using FixedPower = FixedQuantity<dimension::Power, -6, int64_t>;
+
+/// Resistance, stored as 32-bit milliOhms (range: +/- 2.1 MΩ).
+using FixedResistance = FixedQuantity<dimension::Resistance, -3>;
+
+/// Charge, stored as 64-bit microCoulombs.
+using FixedCharge = FixedQuantity<dimension::Charge, -6, int64_t>;
+
+/// Capacitance, stored as 32-bit picoFarads (range: +/- 2.1 mF).
+using FixedCapacitance = FixedQuantity<dimension::Capacitance, -12>;
+
+/// Time, stored as 64-bit microseconds (like roo_time::Duration).
+using FixedTime = FixedQuantity<dimension::Time, -6, int64_t>;
+
+/// Work, stored as 64-bit microJoules.
+using FixedWork = FixedQuantity<dimension::Work, -6, int64_t>;
+
+namespace internal {
+
+/// Maps a dimension to the fixed-point class that products and quotients of
+/// that dimension are returned as. Dimensions without a named alias get a
+/// 64-bit representation, with the exponent chosen by the operator.
+template <typename D, int DefaultExp10>
+struct FixedQuantityFor {
+  using type = FixedQuantity<D, DefaultExp10, int64_t>;
+};
+
+#define ROO_QUANTITY_FIXED_NAMED(name)                       \
+  template <int DefaultExp10>                                \
+  struct FixedQuantityFor<dimension::name, DefaultExp10> {   \
+    using type = Fixed##name;                                \
+  }
+
+ROO_QUANTITY_FIXED_NAMED(Voltage);
+ROO_QUANTITY_FIXED_NAMED(Current);
+ROO_QUANTITY_FIXED_NAMED(Power);
+ROO_QUANTITY_FIXED_NAMED(Resistance);
+ROO_QUANTITY_FIXED_NAMED(Charge);
+ROO_QUANTITY_FIXED_NAMED(Capacitance);
+ROO_QUANTITY_FIXED_NAMED(Time);
+ROO_QUANTITY_FIXED_NAMED(Work);
+
+#undef ROO_QUANTITY_FIXED_NAMED
+
+}  // namespace internal
+
+/// Multiplies fixed-point quantities. The result has the named fixed-point
+/// type of its dimension, if any (e.g. FixedVoltage * FixedCurrent is
+/// FixedPower); otherwise, it holds the exact product in 64 bits. Unknown if
+/// either operand is unknown, or if the product does not fit in the result.
+template <typename D1, int E1, typename I1, typename D2, int E2, typename I2>
+constexpr typename internal::FixedQuantityFor<DimensionProduct<D1, D2>,
+                                              E1 + E2>::type
+operator*(FixedQuantity<D1, E1, I1> a, FixedQuantity<D2, E2, I2> b) {
+  using Result = typename internal::FixedQuantityFor<DimensionProduct<D1, D2>,
+                                                     E1 + E2>::type;
+  if (a.isUnknown() || b.isUnknown()) return Result();
+  if (!internal::MulFits(a.count(), b.count())) return Result();
+  int64_t product = (int64_t)a.count() * b.count();
+  if (!internal::RescaleFits<E1 + E2, Result::exp10>(product)) return Result();
+  return internal::FromCountOrUnknown<Result>(
+      internal::Rescale<E1 + E2, Result::exp10>(product));
+}
+
+/// Divides fixed-point quantities. The result has the named fixed-point type
+/// of its dimension, if any (e.g. FixedVoltage / FixedCurrent is
+/// FixedResistance); otherwise, it is a 64-bit value with 6 more decimal
+/// digits than the dividend (e.g. FixedVoltage / FixedVoltage is a ratio in
+/// millionths). Unknown if either operand is unknown, on division by zero,
+/// and if the quotient does not fit in the result.
+template <typename D1, int E1, typename I1, typename D2, int E2, typename I2>
+constexpr typename internal::FixedQuantityFor<DimensionQuotient<D1, D2>,
+                                              E1 - E2 - 6>::type
+operator/(FixedQuantity<D1, E1, I1> a, FixedQuantity<D2, E2, I2> b) {
+  using Result = typename internal::FixedQuantityFor<DimensionQuotient<D1, D2>,
+                                                     E1 - E2 - 6>::type;
+  if (a.isUnknown() || b.isUnknown() || b.count() == 0) return Result();
+  // a / b = (a.count / b.count) * 10^(E1 - E2), in units of 10^Result::exp10.
+  constexpr int shift = E1 - E2 - Result::exp10;
+  constexpr int64_t n_scale = internal::Pow10(shift >= 0 ? shift : 0);
+  constexpr int64_t d_scale = internal::Pow10(shift < 0 ? -shift : 0);
+  if (!internal::MulFits(a.count(), n_scale) ||
+      !internal::MulFits(b.count(), d_scale)) {
+    return Result();
+  }
+  return internal::FromCountOrUnknown<Result>(internal::DivRound(
+      (int64_t)a.count() * n_scale, (int64_t)b.count() * d_scale));
+}
+
+}  // namespace roo_quantity
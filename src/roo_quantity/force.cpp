@@ -1,22 +1,18 @@
 #include "roo_quantity/force.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void ForceToString(const Force& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inNewtons(), "N", out, maxlen);
+size_t Force::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inNewtons(), "N", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Force::asString() const {
-  char out[16];
-  ForceToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,13 @@ std::string Force::asString() const {
 #if defined(ARDUINO)
 
 String Force::asArduinoString() const {
-  char out[16];
-  ForceToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Force& val) {
-  char out[16];
-  ForceToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -0,0 +1,283 @@
+#include "roo_quantity/format.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace roo_quantity {
+namespace internal {
+namespace {
+
+// Normalized 64-bit significands of 10^n, n in [kMinCachedPow10,
+// kMaxCachedPow10], rounded to nearest. The matching binary exponents are
+// given by CachedPow10BinaryExponent().
+constexpr int kMinCachedPow10 = -33;
+constexpr int kMaxCachedPow10 = 50;
+
+const uint64_t kCachedPow10[] = {
+    0xa6274bbdd0fadd62ULL, 0xcfb11ead453994baULL, 0x81ceb32c4b43fcf5ULL,
+    0xa2425ff75e14fc32ULL, 0xcad2f7f5359a3b3eULL, 0xfd87b5f28300ca0eULL,
+    0x9e74d1b791e07e48ULL, 0xc612062576589ddbULL, 0xf79687aed3eec551ULL,
+    0x9abe14cd44753b53ULL, 0xc16d9a0095928a27ULL, 0xf1c90080baf72cb1ULL,
+    0x971da05074da7befULL, 0xbce5086492111aebULL, 0xec1e4a7db69561a5ULL,
+    0x9392ee8e921d5d07ULL, 0xb877aa3236a4b449ULL, 0xe69594bec44de15bULL,
+    0x901d7cf73ab0acd9ULL, 0xb424dc35095cd80fULL, 0xe12e13424bb40e13ULL,
+    0x8cbccc096f5088ccULL, 0xafebff0bcb24aaffULL, 0xdbe6fecebdedd5bfULL,
+    0x89705f4136b4a597ULL, 0xabcc77118461cefdULL, 0xd6bf94d5e57a42bcULL,
+    0x8637bd05af6c69b6ULL, 0xa7c5ac471b478423ULL, 0xd1b71758e219652cULL,
+    0x83126e978d4fdf3bULL, 0xa3d70a3d70a3d70aULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0xa000000000000000ULL, 0xc800000000000000ULL,
+    0xfa00000000000000ULL, 0x9c40000000000000ULL, 0xc350000000000000ULL,
+    0xf424000000000000ULL, 0x9896800000000000ULL, 0xbebc200000000000ULL,
+    0xee6b280000000000ULL, 0x9502f90000000000ULL, 0xba43b74000000000ULL,
+    0xe8d4a51000000000ULL, 0x9184e72a00000000ULL, 0xb5e620f480000000ULL,
+    0xe35fa931a0000000ULL, 0x8e1bc9bf04000000ULL, 0xb1a2bc2ec5000000ULL,
+    0xde0b6b3a76400000ULL, 0x8ac7230489e80000ULL, 0xad78ebc5ac620000ULL,
+    0xd8d726b7177a8000ULL, 0x878678326eac9000ULL, 0xa968163f0a57b400ULL,
+    0xd3c21bcecceda100ULL, 0x84595161401484a0ULL, 0xa56fa5b99019a5c8ULL,
+    0xcecb8f27f4200f3aULL, 0x813f3978f8940984ULL, 0xa18f07d736b90be5ULL,
+    0xc9f2c9cd04674edfULL, 0xfc6f7c4045812296ULL, 0x9dc5ada82b70b59eULL,
+    0xc5371912364ce305ULL, 0xf684df56c3e01bc7ULL, 0x9a130b963a6c115cULL,
+    0xc097ce7bc90715b3ULL, 0xf0bdc21abb48db20ULL, 0x96769950b50d88f4ULL,
+    0xbc143fa4e250eb31ULL, 0xeb194f8e1ae525fdULL, 0x92efd1b8d0cf37beULL,
+    0xb7abc627050305aeULL, 0xe596b7b0c643c719ULL, 0x8f7e32ce7bea5c70ULL,
+    0xb35dbf821ae4f38cULL, 0xe0352f62a19e306fULL, 0x8c213d9da502de45ULL,
+    0xaf298d050e4395d7ULL, 0xdaf3f04651d47b4cULL, 0x88d8762bf324cd10ULL,
+};
+
+// floor(e * log10(2)), exact for |e| < 2620.
+inline int FloorLog10Pow2(int e) { return (e * 78913) >> 18; }
+
+// Returns b such that 10^n = kCachedPow10[n - kMinCachedPow10] * 2^b.
+inline int CachedPow10BinaryExponent(int n) {
+  return ((n * 217706) >> 16) - 63;
+}
+
+// Powers of 5 that fit in a float mantissa.
+const uint32_t kPow5[] = {1,      5,       25,       125,      625,
+                          3125,   15625,   78125,    390625,   1953125,
+                          9765625};
+
+// Returns floor(a * b / 2^32). Sets `inexact` if the result got truncated.
+inline uint64_t MulShift32(uint32_t a, uint64_t b, bool& inexact) {
+  uint64_t lo = (uint64_t)a * (uint32_t)b;
+  uint64_t hi = (uint64_t)a * (uint32_t)(b >> 32);
+  inexact = ((uint32_t)lo != 0);
+  return hi + (lo >> 32);
+}
+
+// Powers of 10 that fit in uint64_t.
+const uint64_t kPow10[] = {1ULL,
+                           10ULL,
+                           100ULL,
+                           1000ULL,
+                           10000ULL,
+                           100000ULL,
+                           1000000ULL,
+                           10000000ULL,
+                           100000000ULL,
+                           1000000000ULL,
+                           10000000000ULL,
+                           100000000000ULL,
+                           1000000000000ULL,
+                           10000000000000ULL,
+                           100000000000000ULL,
+                           1000000000000000ULL,
+                           10000000000000000ULL,
+                           100000000000000000ULL,
+                           1000000000000000000ULL,
+                           10000000000000000000ULL};
+
+// Returns the number of decimal digits of n > 0.
+int DigitCount(uint64_t n) {
+  int count = 1;
+  while (count < 20 && n >= kPow10[count]) ++count;
+  return count;
+}
+
+}  // namespace
+
+Decimal6 ToDecimal6(float val) {
+  uint32_t bits;
+  memcpy(&bits, &val, sizeof(bits));
+  uint32_t mantissa = bits & 0x7FFFFF;
+  int exponent = (bits >> 23) & 0xFF;
+  if (exponent == 0) {
+    // Subnormal.
+    exponent = -149;
+  } else {
+    mantissa |= 0x800000;
+    exponent -= 150;
+  }
+  // Normalize, so that val = mantissa * 2^exponent, with the mantissa in
+  // [2^31, 2^32).
+  int shift = __builtin_clz(mantissa);
+  mantissa <<= shift;
+  exponent -= shift;
+
+  // Lower bound of the decimal exponent; off by at most one.
+  int exp10 = FloorLog10Pow2(exponent + 31);
+  while (true) {
+    // Scale val by 10^n, to land in [100000, 10000000). The result is
+    // scaled * 2^(-fraction_bits).
+    int n = 5 - exp10;
+    uint64_t scaled;
+    int fraction_bits;
+    bool inexact;
+    if (n < 0 && -n < (int)(sizeof(kPow5) / sizeof(kPow5[0])) &&
+        mantissa % kPow5[-n] == 0) {
+      // The result is a dyadic rational; compute it exactly, so that ties
+      // get rounded correctly.
+      scaled = (uint64_t)(mantissa / kPow5[-n]) << 32;
+      fraction_bits = 32 - n - exponent;
+      inexact = false;
+    } else {
+      scaled = MulShift32(mantissa, kCachedPow10[n - kMinCachedPow10], inexact);
+      fraction_bits = -(exponent + CachedPow10BinaryExponent(n) + 32);
+    }
+    uint32_t digits = (uint32_t)(scaled >> fraction_bits);
+    if (digits >= 1000000) {
+      ++exp10;
+      continue;
+    }
+    uint64_t fraction = scaled & ((1ULL << fraction_bits) - 1);
+    uint64_t half = 1ULL << (fraction_bits - 1);
+    if (fraction > half ||
+        (fraction == half && (inexact || (digits & 1) != 0))) {
+      ++digits;
+      if (digits == 1000000) {
+        digits = 100000;
+        ++exp10;
+      }
+    }
+    return Decimal6{digits, exp10};
+  }
+}
+
+int LeadingExp10(uint64_t mantissa, int exp10) {
+  return DigitCount(mantissa) - 1 + exp10;
+}
+
+Decimal6 ToDecimal6(uint64_t mantissa, int exp10) {
+  int count = DigitCount(mantissa);
+  exp10 += count - 1;
+  if (count <= 6) {
+    return Decimal6{(uint32_t)(mantissa * kPow10[6 - count]), exp10};
+  }
+  uint64_t divisor = kPow10[count - 6];
+  uint32_t digits = (uint32_t)(mantissa / divisor);
+  uint64_t remainder = mantissa % divisor;
+  uint64_t half = divisor / 2;
+  if (remainder > half || (remainder == half && (digits & 1) != 0)) {
+    ++digits;
+    if (digits == 1000000) {
+      digits = 100000;
+      ++exp10;
+    }
+  }
+  return Decimal6{digits, exp10};
+}
+
+int WriteDecimal6(Decimal6 val, int shift10, char* out) {
+  if (val.digits == 0) {
+    *out = '0';
+    return 1;
+  }
+  char digits[6];
+  int count = 6;
+  uint32_t d = val.digits;
+  while (count > 1 && d % 10 == 0) {
+    d /= 10;
+    --count;
+  }
+  for (int i = count - 1; i >= 0; --i) {
+    digits[i] = '0' + d % 10;
+    d /= 10;
+  }
+  int exp10 = val.exp10 - shift10;
+  char* p = out;
+  if (exp10 < -4 || exp10 >= 6) {
+    // Exponent notation, e.g. 1.5e+07.
+    *p++ = digits[0];
+    if (count > 1) {
+      *p++ = '.';
+      for (int i = 1; i < count; ++i) *p++ = digits[i];
+    }
+    *p++ = 'e';
+    if (exp10 < 0) {
+      *p++ = '-';
+      exp10 = -exp10;
+    } else {
+      *p++ = '+';
+    }
+    *p++ = '0' + exp10 / 10;
+    *p++ = '0' + exp10 % 10;
+  } else if (exp10 >= 0) {
+    // Fixed notation, e.g. 150.3 or 1200.
+    for (int i = 0; i <= exp10; ++i) *p++ = (i < count) ? digits[i] : '0';
+    if (count > exp10 + 1) {
+      *p++ = '.';
+      for (int i = exp10 + 1; i < count; ++i) *p++ = digits[i];
+    }
+  } else {
+    // Fixed notation, e.g. 0.0068.
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = -1; i > exp10; --i) *p++ = '0';
+    for (int i = 0; i < count; ++i) *p++ = digits[i];
+  }
+  return p - out;
+}
+
+void StringWriter::appendFloat(float val) {
+  if (std::isnan(val)) {
+    append("nan");
+    return;
+  }
+  if (std::signbit(val)) {
+    append('-');
+    val = -val;
+  }
+  if (val == 0.0f) {
+    append('0');
+  } else if (std::isinf(val)) {
+    append("inf");
+  } else {
+    char buf[kMaxDecimal6Length];
+    append(buf, WriteDecimal6(ToDecimal6(val), 0, buf));
+  }
+}
+
+}  // namespace internal
+
+size_t FormatFloat(float val, char* out, size_t maxlen) {
+  internal::StringWriter writer(out, maxlen);
+  writer.appendFloat(val);
+  return writer.finish();
+}
+
+size_t FormatInUnits(float val, const UnitFormat* units, size_t unit_count,
+                     const char* base_symbol, char* out, size_t maxlen) {
+  internal::StringWriter writer(out, maxlen);
+  if (std::isnan(val)) {
+    writer.append('?');
+    writer.append(base_symbol);
+  } else if (val == 0.0f) {
+    writer.append('0');
+    writer.append(base_symbol);
+  } else {
+    if (val < 0.0f) {
+      writer.append('-');
+      val = -val;
+    }
+    // Branch-free: counts the thresholds that are above the value.
+    size_t idx = 0;
+    for (size_t i = 0; i + 1 < unit_count; ++i) {
+      idx += (val < units[i].threshold);
+    }
+    writer.appendFloat(val * units[idx].scale);
+    writer.append(units[idx].symbol);
+  }
+  return writer.finish();
+}
+
+}  // namespace roo_quantity
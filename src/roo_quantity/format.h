@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "roo_logging.h"
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+#include <string>
+#endif
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+
+namespace roo_quantity {
+
+/// Formats a float the same way as printf's "%g" (6 significant digits,
+/// trailing zeros removed, exponent notation for very large and very small
+/// magnitudes), without going through printf. Non-finite values are
+/// formatted as "nan", "inf", and "-inf".
+///
+/// Writes a null-terminated string into `out` with at most `maxlen` bytes.
+/// Returns the number of characters written, excluding the terminating null.
+size_t FormatFloat(float val, char* out, size_t maxlen);
+
+/// A unit that a quantity can be pretty-printed in.
+struct UnitFormat {
+  /// Smallest magnitude, in the base unit, that gets printed in this unit.
+  float threshold;
+
+  /// Multiplier converting from the base unit to this unit.
+  float scale;
+
+  /// Unit symbol, including the separator, e.g. " km".
+  const char* symbol;
+};
+
+/// Formats `val`, expressed in the base unit, using the first of `units` whose
+/// threshold does not exceed the magnitude of `val`. The units must be ordered
+/// by decreasing threshold; the last one is used for all smaller magnitudes.
+/// Unknown (NaN) values and zero are formatted as "?" and "0", followed by
+/// `base_symbol`.
+///
+/// Writes a null-terminated string into `out` with at most `maxlen` bytes.
+/// Returns the number of characters written, excluding the terminating null.
+size_t FormatInUnits(float val, const UnitFormat* units, size_t unit_count,
+                     const char* base_symbol, char* out, size_t maxlen);
+
+template <size_t N>
+size_t FormatInUnits(float val, const UnitFormat (&units)[N],
+                     const char* base_symbol, char* out, size_t maxlen) {
+  return FormatInUnits(val, units, N, base_symbol, out, maxlen);
+}
+
+namespace internal {
+
+/// Decimal approximation of a positive, finite float, rounded to 6
+/// significant digits: value ~= digits * 10^(exp10 - 5), where
+/// 100000 <= digits <= 999999.
+struct Decimal6 {
+  uint32_t digits;
+  int exp10;
+};
+
+/// Converts a positive, finite float to its 6-significant-digit decimal
+/// representation, using integer arithmetic only.
+Decimal6 ToDecimal6(float val);
+
+/// Converts mantissa * 10^exp10, where mantissa > 0, to its 6-significant-digit
+/// decimal representation. Ties are rounded to even.
+Decimal6 ToDecimal6(uint64_t mantissa, int exp10);
+
+/// Returns the decimal exponent of the leading digit of mantissa * 10^exp10,
+/// where mantissa > 0.
+int LeadingExp10(uint64_t mantissa, int exp10);
+
+/// Maximum number of characters written by WriteDecimal6.
+constexpr int kMaxDecimal6Length = 12;
+
+/// Writes `val`, scaled by 10^(-shift10), in the "%g" style; zero digits are
+/// written as "0". The output is not null-terminated; `out` must have room for
+/// kMaxDecimal6Length characters. Returns the number of characters written.
+int WriteDecimal6(Decimal6 val, int shift10, char* out);
+
+/// Helper for writing bounded, null-terminated strings, with the same
+/// truncation semantics as snprintf.
+class StringWriter {
+ public:
+  StringWriter(char* out, size_t maxlen)
+      : out_(out), maxlen_(maxlen), pos_(0) {}
+
+  void append(char c) {
+    if (pos_ + 1 < maxlen_) out_[pos_++] = c;
+  }
+
+  void append(const char* str) {
+    while (*str != '\0' && pos_ + 1 < maxlen_) out_[pos_++] = *str++;
+  }
+
+  void append(const char* str, size_t len) {
+    while (len-- > 0 && pos_ + 1 < maxlen_) out_[pos_++] = *str++;
+  }
+
+  /// Appends the value formatted as by FormatFloat.
+  void appendFloat(float val);
+
+  /// Null-terminates the output, and returns its length.
+  size_t finish() {
+    if (maxlen_ > 0) out_[pos_] = '\0';
+    return pos_;
+  }
+
+ private:
+  char* out_;
+  size_t maxlen_;
+  size_t pos_;
+};
+
+/// Size of the stack buffer used by asString(), asArduinoString(), and
+/// operator<<.
+constexpr size_t kFormatBufferSize = 16;
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+template <typename Q>
+std::string FormatAsString(const Q& val) {
+  char out[kFormatBufferSize];
+  val.formatTo(out, kFormatBufferSize);
+  return out;
+}
+#endif
+
+#if defined(ARDUINO)
+template <typename Q>
+String FormatAsArduinoString(const Q& val) {
+  char out[kFormatBufferSize];
+  val.formatTo(out, kFormatBufferSize);
+  return out;
+}
+#endif
+
+template <typename Q>
+roo_logging::Stream& FormatToStream(roo_logging::Stream& os, const Q& val) {
+  char out[kFormatBufferSize];
+  val.formatTo(out, kFormatBufferSize);
+  os << out;
+  return os;
+}
+
+}  // namespace internal
+
+}  // namespace roo_quantity
@@ -1,22 +1,18 @@
 #include "roo_quantity/frequency.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void FrequencyToString(const Frequency& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inHertz(), "Hz", out, maxlen);
+size_t Frequency::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inHertz(), "Hz", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Frequency::asString() const {
-  char out[16];
-  FrequencyToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,13 @@ std::string Frequency::asString() const {
 #if defined(ARDUINO)
 
 String Frequency::asArduinoString() const {
-  char out[16];
-  FrequencyToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Frequency& val) {
-  char out[16];
-  FrequencyToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
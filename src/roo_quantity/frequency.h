@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
 #include "roo_quantity/time.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -17,78 +19,47 @@
 namespace roo_quantity {
 
 /// Representation of frequency, internally stored as floating-point Hertz.
-class Frequency {
+class Frequency
+    : public internal::QuantityBase<Frequency, dimension::Frequency, float> {
  public:
   /// Creates a frequency object representing an 'unknown' frequency.
-  Frequency() : frequency_(std::nanf("")) {}
+  constexpr Frequency() = default;
 
   /// Returns the frequency in GigaHertz.
-  float inGigaHertz() const { return frequency_ * 0.000000001f; }
+  constexpr float inGigaHertz() const { return value_ * 0.000000001f; }
 
   /// Returns the frequency in MegaHertz.
-  float inMegaHertz() const { return frequency_ * 0.000001f; }
+  constexpr float inMegaHertz() const { return value_ * 0.000001f; }
 
   /// Returns the frequency in kiloHertz.
-  float inKiloHertz() const { return frequency_ * 0.001f; }
+  constexpr float inKiloHertz() const { return value_ * 0.001f; }
 
   /// Returns the frequency in Hertz.
-  float inHertz() const { return frequency_; }
+  constexpr float inHertz() const { return value_; }
 
   /// Returns the frequency in milliHertz.
-  float inMilliHertz() const { return frequency_ * 1000.0f; }
+  constexpr float inMilliHertz() const { return value_ * 1000.0f; }
 
   /// Returns the frequency in microHertz.
-  float inMicroHertz() const { return frequency_ * 1000000.0f; }
+  constexpr float inMicroHertz() const { return value_ * 1000000.0f; }
 
   /// Returns the rotational frequency in radians per second.
-  float inRadiansPerSecond() const { return frequency_ * 2.0f * M_PI; }
+  constexpr float inRadiansPerSecond() const { return value_ * 6.283185307f; }
 
   /// Returns the rotational frequency in cycles per second (equivalent
   /// to Hertz).
-  float inCyclesPerSecond() const { return inHertz(); }
+  constexpr float inCyclesPerSecond() const { return inHertz(); }
 
   /// Returns the rotational frequency in RPM.
-  float inRevolutionsPerMinute() const { return frequency_ * 60.0f; }
+  constexpr float inRevolutionsPerMinute() const { return value_ * 60.0f; }
 
   /// Returns the rotational frequency in RPM.
-  float inRPM() const { return inRevolutionsPerMinute(); }
+  constexpr float inRPM() const { return inRevolutionsPerMinute(); }
 
-  /// Returns whether the object represents an unknown frequency.
-  bool isUnknown() const { return std::isnan(frequency_); }
-
-  bool operator<(const Frequency &other) const {
-    return frequency_ < other.frequency_;
-  }
-
-  bool operator==(const Frequency &other) const {
-    return frequency_ == other.frequency_;
-  }
-
-  bool operator>(const Frequency &other) const {
-    return other.frequency_ < frequency_;
-  }
-
-  bool operator<=(const Frequency &other) const {
-    return !(other.frequency_ < frequency_);
-  }
-
-  bool operator>=(const Frequency &other) const {
-    return !(frequency_ < other.frequency_);
-  }
-
-  bool operator!=(const Frequency &other) const {
-    return !(frequency_ == other.frequency_);
-  }
-
-  Frequency &operator*=(float multi) {
-    frequency_ *= multi;
-    return *this;
-  }
-
-  Frequency &operator/=(float div) {
-    frequency_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the frequency into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char *out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the frequency.
@@ -100,105 +71,84 @@ class Frequency {
 #endif
 
  private:
-  friend Frequency UnknownFrequency();
-
-  friend Frequency FrequencyInHertz(float);
+  friend constexpr Frequency UnknownFrequency();
 
-  explicit Frequency(float frequency) : frequency_(frequency) {}
+  friend constexpr Frequency FrequencyInHertz(float);
 
-  /// Stored in Hertz.
-  float frequency_;
+  explicit constexpr Frequency(float frequency) : QuantityBase(frequency) {}
 };
 
-inline Frequency FrequencyInHertz(float frequency);
+constexpr Frequency FrequencyInHertz(float frequency);
 
 /// Returns a frequency object representing an unknown frequency.
-inline Frequency UnknownFrequency() { return Frequency(); }
+constexpr Frequency UnknownFrequency() { return Frequency(); }
 
 /// Returns a frequency object equivalent to the specified frequency
 /// expressed in gigaHertz.
-inline Frequency FrequencyInGigaHertz(float frequency) {
+constexpr Frequency FrequencyInGigaHertz(float frequency) {
   return FrequencyInHertz(frequency * 1000000000.0f);
 }
 
 /// Returns a frequency object equivalent to the specified frequency
 /// expressed in megaHertz.
-inline Frequency FrequencyInMegaHertz(float frequency) {
+constexpr Frequency FrequencyInMegaHertz(float frequency) {
   return FrequencyInHertz(frequency * 1000000.0f);
 }
 
 /// Returns a frequency object equivalent to the specified frequency
 /// expressed in kiloHertz.
-inline Frequency FrequencyInKiloHertz(float frequency) {
+constexpr Frequency FrequencyInKiloHertz(float frequency) {
   return FrequencyInHertz(frequency * 1000.0f);
 }
 
 /// Returns a frequency object equivalent to the specified frequency
 /// expressed in Hertz.
-inline Frequency FrequencyInHertz(float frequency) {
+constexpr Frequency FrequencyInHertz(float frequency) {
   return Frequency(frequency);
 }
 
 /// Returns a frequency object equivalent to the specified frequency
 /// expressed in milliHertz.
-inline Frequency FrequencyInMilliHertz(float frequency) {
+constexpr Frequency FrequencyInMilliHertz(float frequency) {
   return FrequencyInHertz(frequency * 0.001f);
 }
 
 /// Returns a frequency object equivalent to the specified frequency
 /// expressed in microHertz.
-inline Frequency FrequencyInMicroHertz(float frequency) {
+constexpr Frequency FrequencyInMicroHertz(float frequency) {
   return FrequencyInHertz(frequency * 0.000001f);
 }
 
 /// Returns a frequency object equivalent to the specified rotational frequency
 /// expressed in radians per second.
-inline Frequency FrequencyInRadiansPerSecond(float omega) {
+constexpr Frequency FrequencyInRadiansPerSecond(float omega) {
   return FrequencyInHertz(omega * 0.1591549430918f);
 }
 
 /// Returns a frequency object equivalent to the specified rotational frequency
 /// expressed in revolutions per minute (RPM).
-inline Frequency FrequencyInRevolutionsPerMinute(float frequency) {
+constexpr Frequency FrequencyInRevolutionsPerMinute(float frequency) {
   return FrequencyInHertz(frequency * 0.016666666666666666f);
 }
 
 /// Returns a frequency object equivalent to the specified rotational frequency
 /// expressed in revolutions per minute (RPM).
-inline Frequency FrequencyInRPM(float frequency) {
+constexpr Frequency FrequencyInRPM(float frequency) {
   return FrequencyInRevolutionsPerMinute(frequency);
 }
 
-inline Frequency operator*(Frequency a, float b) {
-  return FrequencyInHertz(a.inHertz() * b);
-}
-
-inline Frequency operator*(float a, Frequency b) {
-  return FrequencyInHertz(a * b.inHertz());
-}
-
-inline float operator*(Time a, Frequency b) {
-  return a.inSeconds() * b.inHertz();
-}
-
-inline float operator*(Frequency a, Time b) {
-  return a.inHertz() * b.inSeconds();
-}
-
-inline Frequency operator/(Frequency a, float b) {
-  return FrequencyInHertz(a.inHertz() / b);
-}
-
-inline float operator/(Frequency a, Frequency b) {
-  return a.inHertz() / b.inHertz();
-}
-
-inline Time operator/(float a, Frequency b) {
-  return TimeInSeconds(a / b.inHertz());
+/// Returns the frequency of a periodic event with the specified period.
+inline Frequency FrequencyFromPeriod(const roo_time::Duration &period) {
+  return FrequencyInHertz(1000000.0f /
+                          static_cast<float>(period.inMicros()));
 }
 
-inline Frequency operator/(float a, Time b) {
-  return FrequencyInHertz(a / b.inSeconds());
+/// Returns the frequency of `count` events occurring over the specified
+/// interval.
+inline Frequency FrequencyFromCount(float count,
+                                    const roo_time::Duration &interval) {
+  return FrequencyInHertz(count * 1000000.0f /
+                          static_cast<float>(interval.inMicros()));
 }
 
 roo_logging::Stream &operator<<(roo_logging::Stream &os, const Frequency &val);
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "roo_quantity/quantity.h"
+#include "roo_quantity/span.h"
+#include "roo_quantity/statistics.h"
+#include "roo_quantity/time.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// Neumaier's variant of compensated (Kahan) summation, which stays accurate
+/// also when the addends are larger than the running sum. The error of the
+/// sum does not grow with the number of addends; in particular, a float sum
+/// keeps accumulating small addends long after 2^24 of them. (Relies on strict
+/// IEEE semantics; must not be compiled with -ffast-math.)
+template <typename T>
+class NeumaierSum {
+ public:
+  constexpr NeumaierSum() : sum_(0), compensation_(0) {}
+
+  void add(T x) {
+    T t = sum_ + x;
+    if (std::fabs(sum_) >= std::fabs(x)) {
+      compensation_ += (sum_ - t) + x;
+    } else {
+      compensation_ += (x - t) + sum_;
+    }
+    sum_ = t;
+  }
+
+  T value() const { return sum_ + compensation_; }
+
+ private:
+  T sum_;
+  T compensation_;
+};
+
+}  // namespace internal
+
+/// The rule used by Integrator to approximate the integral over an interval
+/// between consecutive samples.
+enum class IntegrationRule {
+  /// Each sample is taken to hold over the interval preceding it.
+  kRectangle,
+
+  /// The rate is taken to change linearly between consecutive samples.
+  kTrapezoidal,
+};
+
+/// Accumulates the integral over time of a sampled rate; e.g. energy (Work)
+/// from Power, charge from Current (coulomb counting), or Volume from
+/// VolumeFlowRate (flow totalizing).
+///
+/// The result type defaults to Rate * Time, e.g. Work for Power, but can be
+/// any quantity class of the same dimension, e.g. DoubleWork. The total is
+/// kept in its representation, with compensated summation, so that, unlike
+/// naive `total += rate * dt` in float, it does not stop growing once the
+/// total exceeds 2^24 times the increment.
+///
+/// Unknown samples are treated as gaps: nothing is accumulated over the
+/// intervals adjacent to them.
+///
+/// Example:
+///
+///   Integrator<Power, DoubleWork> energy;
+///   ...
+///   energy.addSample(voltage * current, TimeElapsed(last_time, now));
+///   LOG(INFO) << "Consumed " << energy.total().inKiloJoules() << " kJ";
+template <typename Rate, typename Result = internal::ProductOf<Rate, Time>,
+          IntegrationRule kRule = IntegrationRule::kTrapezoidal>
+class Integrator {
+ public:
+  using Rep = typename Result::Rep;
+
+  static_assert(internal::IsQuantity<Rate>::value &&
+                    internal::IsQuantity<Result>::value,
+                "Integrator requires quantity classes");
+  static_assert(std::is_same<typename Result::Dim,
+                             typename internal::ProductOf<Rate, Time>::Dim>::
+                    value,
+                "Result must have the dimension of Rate * Time");
+
+  /// Creates an integrator with a zero total.
+  constexpr Integrator() : prev_(std::numeric_limits<Rep>::quiet_NaN()) {}
+
+  /// Adds a sample of the rate, taken `dt` after the previous one. With the
+  /// trapezoidal rule, `dt` of the first sample (and of the first one after
+  /// an unknown sample) is ignored.
+  void addSample(const Rate& rate, const Time& dt) {
+    add(static_cast<Rep>(rate.inSiUnits()), static_cast<Rep>(dt.inSeconds()));
+  }
+
+  /// Adds uniformly spaced samples of the rate, `dt` apart (and, for the first
+  /// one, after the previous sample). Equivalent to calling addSample() for
+  /// each element. For single-precision rates and results, vectorized (see
+  /// statistics.h), with the batch summed in float; for double-precision
+  /// results, the samples are added one by one, keeping double precision.
+  void addSamples(QuantitySpan<const Rate> rates, const Time& dt) {
+    if (rates.empty()) return;
+    Rep seconds = static_cast<Rep>(dt.inSeconds());
+    if constexpr (std::is_same<typename Rate::Rep, float>::value &&
+                  std::is_same<Rep, float>::value) {
+      internal::KnownStats stats =
+          internal::SumKnown(rates.data(), rates.size());
+      if (kRule == IntegrationRule::kRectangle) {
+        total_.add(static_cast<Rep>(stats.sum) * seconds);
+        return;
+      }
+      if (stats.count == rates.size()) {
+        // No gaps: every sample is weighted by dt, except for the first and
+        // last one, by dt / 2; plus the interval joining the previous batch.
+        Rep first = static_cast<Rep>(rates.data()[0]);
+        Rep last = static_cast<Rep>(rates.data()[rates.size() - 1]);
+        Rep inner = static_cast<Rep>(stats.sum) - (first + last) * Rep(0.5);
+        total_.add(inner * seconds);
+        add(first, seconds);
+        prev_ = last;
+        return;
+      }
+    }
+    for (size_t i = 0; i < rates.size(); ++i) {
+      add(static_cast<Rep>(rates.data()[i]), seconds);
+    }
+  }
+
+  /// Returns the accumulated integral.
+  Result total() const { return Result::FromSiUnits(total_.value()); }
+
+  /// Resets the total to zero, and forgets the previous sample.
+  void reset() { *this = Integrator(); }
+
+ private:
+  void add(Rep x, Rep dt) {
+    if (x != x) {
+      prev_ = x;
+      return;
+    }
+    if (kRule == IntegrationRule::kRectangle) {
+      total_.add(x * dt);
+    } else {
+      if (prev_ == prev_) total_.add((prev_ + x) * Rep(0.5) * dt);
+      prev_ = x;
+    }
+  }
+
+  internal::NeumaierSum<Rep> total_;
+
+  // The previous sample (for the trapezoidal rule), or NaN if none.
+  Rep prev_;
+};
+
+/// Integrator using the rectangle rule; see IntegrationRule.
+template <typename Rate, typename Result = internal::ProductOf<Rate, Time>>
+using RectangleIntegrator =
+    Integrator<Rate, Result, IntegrationRule::kRectangle>;
+
+}  // namespace roo_quantity
@@ -1,54 +1,30 @@
 #include "roo_quantity/length.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void LengthToString(Length val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? m", maxlen);
-  } else {
-    const char* format;
-    const char* sign = "";
-    float num;
-    if (val.inMeters() == 0.0f) {
-      snprintf(out, maxlen, "0 m");
-      return;
-    }
-    if (val.inMeters() < 0) {
-      sign = "-";
-      val = -val;
-    }
-    if (val >= LengthInMeters(1000.0f)) {
-      format = "%s%g km";
-      num = val.inKilometers();
-    } else if (val >= LengthInMeters(1.0f)) {
-      format = "%s%g m";
-      num = val.inMeters();
-    } else if (val >= LengthInCentimeters(10.0f)) {
-      format = "%s%g cm";
-      num = val.inCentimeters();
-    } else if (val >= LengthInMillimeters(1.0f)) {
-      format = "%s%g mm";
-      num = val.inMillimeters();
-    } else if (val >= LengthInMicrometers(1.0f)) {
-      format = "%s%g µm";
-      num = val.inMicrometers();
-    } else {
-      format = "%s%g nm";
-      num = val.inNanometers();
-    }
-    snprintf(out, maxlen, format, sign, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kLengthUnits[] = {
+    {1000.0f,   0.001f,        " km"},
+    {1.0f,      1.0f,          " m"},
+    {0.1f,      100.0f,        " cm"},
+    {0.001f,    1000.0f,       " mm"},
+    {0.000001f, 1000000.0f,    " µm"},
+    {0.0f,      1000000000.0f, " nm"},
+};
 
 }  // namespace
 
+size_t Length::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inMeters(), kLengthUnits, " m", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Length::asString() const {
-  char out[16];
-  LengthToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -56,18 +32,38 @@ std::string Length::asString() const {
 #if defined(ARDUINO)
 
 String Length::asArduinoString() const {
-  char out[16];
-  LengthToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Length& val) {
-  char out[16];
-  LengthToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
+}
+
+size_t DoubleLength::formatTo(char* out, size_t maxlen) const {
+  return toFloat().formatTo(out, maxlen);
+}
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+
+std::string DoubleLength::asString() const {
+  return internal::FormatAsString(*this);
+}
+
+#endif
+
+#if defined(ARDUINO)
+
+String DoubleLength::asArduinoString() const {
+  return internal::FormatAsArduinoString(*this);
+}
+
+#endif
+
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const DoubleLength& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
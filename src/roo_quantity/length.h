@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -16,86 +18,48 @@
 namespace roo_quantity {
 
 /// Representation of length, internally stored as floating-point meters.
-class Length {
+class Length : public internal::QuantityBase<Length, dimension::Length, float> {
  public:
   /// Creates a length object representing an 'unknown' length.
-  Length() : length_(std::nanf("")) {}
+  constexpr Length() = default;
 
   /// Returns the length in kilometers.
-  float inKilometers() const { return length_ * 0.001f; }
+  constexpr float inKilometers() const { return value_ * 0.001f; }
 
   /// Returns the length in meters.
-  float inMeters() const { return length_; }
+  constexpr float inMeters() const { return value_; }
 
   /// Returns the length in decimeters.
-  float inDecimeters() const { return length_ * 10.0f; }
+  constexpr float inDecimeters() const { return value_ * 10.0f; }
 
   /// Returns the length in centimeters.
-  float inCentimeters() const { return length_ * 100.0f; }
+  constexpr float inCentimeters() const { return value_ * 100.0f; }
 
   /// Returns the length in millimeters.
-  float inMillimeters() const { return length_ * 1000.0f; }
+  constexpr float inMillimeters() const { return value_ * 1000.0f; }
 
   /// Returns the length in micrometers.
-  float inMicrometers() const { return length_ * 1000000.0f; }
+  constexpr float inMicrometers() const { return value_ * 1000000.0f; }
 
   /// Returns the length in nanometers.
-  float inNanometers() const { return length_ * 1000000000.0f; }
+  constexpr float inNanometers() const { return value_ * 1000000000.0f; }
 
   /// Returns the length in inches.
-  float inInches() const { return length_ * 39.37007874f; }
+  constexpr float inInches() const { return value_ * 39.37007874f; }
 
   /// Returns the length in feet.
-  float inFeet() const { return length_ * 3.280839895f; }
+  constexpr float inFeet() const { return value_ * 3.280839895f; }
 
   /// Returns the length in yards.
-  float inYards() const { return length_ * 1.0936132983f; }
+  constexpr float inYards() const { return value_ * 1.0936132983f; }
 
   /// Returns the length in light years.
-  float inLightYears() const { return length_ * 1.057000834E-16f; }
+  constexpr float inLightYears() const { return value_ * 1.057000834E-16f; }
 
-  /// Returns whether the object represents an unknown length.
-  bool isUnknown() const { return std::isnan(length_); }
-
-  bool operator<(const Length& other) const { return length_ < other.length_; }
-
-  bool operator==(const Length& other) const {
-    return length_ == other.length_;
-  }
-
-  bool operator>(const Length& other) const { return other.length_ < length_; }
-
-  bool operator<=(const Length& other) const {
-    return !(other.length_ < length_);
-  }
-
-  bool operator>=(const Length& other) const {
-    return !(length_ < other.length_);
-  }
-
-  bool operator!=(const Length& other) const {
-    return !(length_ == other.length_);
-  }
-
-  inline Length& operator+=(const Length& other) {
-    length_ += other.inMeters();
-    return *this;
-  }
-
-  inline Length& operator-=(const Length& other) {
-    length_ -= other.inMeters();
-    return *this;
-  }
-
-  inline Length& operator*=(float multi) {
-    length_ *= multi;
-    return *this;
-  }
-
-  inline Length& operator/=(float div) {
-    length_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the length into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the length.
@@ -107,111 +71,230 @@ class Length {
 #endif
 
  private:
-  friend Length UnknownLength();
-
-  friend Length LengthInMeters(float);
+  friend constexpr Length UnknownLength();
 
-  explicit Length(float length) : length_(length) {}
+  friend constexpr Length LengthInMeters(float);
 
-  /// Stored in meters.
-  float length_;
+  explicit constexpr Length(float length) : QuantityBase(length) {}
 };
 
-inline Length LengthInMeters(float length);
+constexpr Length LengthInMeters(float length);
 
 /// Returns a length object representing an unknown length.
-inline Length UnknownLength() { return Length(); }
+constexpr Length UnknownLength() { return Length(); }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in kilometers.
-inline Length LengthInKilometers(float length) {
+constexpr Length LengthInKilometers(float length) {
   return LengthInMeters(length * 1000.0f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in meters.
-inline Length LengthInMeters(float length) { return Length(length); }
+constexpr Length LengthInMeters(float length) { return Length(length); }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in decimeters.
-inline Length LengthInDecimeters(float length) {
+constexpr Length LengthInDecimeters(float length) {
   return LengthInMeters(length * 0.1f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in centimeters.
-inline Length LengthInCentimeters(float length) {
+constexpr Length LengthInCentimeters(float length) {
   return LengthInMeters(length * 0.01f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in millimeters.
-inline Length LengthInMillimeters(float length) {
+constexpr Length LengthInMillimeters(float length) {
   return LengthInMeters(length * 0.001f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in micrometers.
-inline Length LengthInMicrometers(float length) {
+constexpr Length LengthInMicrometers(float length) {
   return LengthInMeters(length * 0.000001f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in nanometers.
-inline Length LengthInNanometers(float length) {
+constexpr Length LengthInNanometers(float length) {
   return LengthInMeters(length * 0.000000001f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in inches.
-inline Length LengthInInches(float length) {
+constexpr Length LengthInInches(float length) {
   return LengthInMeters(length * 0.0254f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in feet.
-inline Length LengthInFeet(float length) {
+constexpr Length LengthInFeet(float length) {
   return LengthInMeters(length * 0.3048f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in yards.
-inline Length LengthInYards(float length) {
+constexpr Length LengthInYards(float length) {
   return LengthInMeters(length * 0.9144f);
 }
 
 /// Returns a length object equivalent to the specified length
 /// expressed in light years.
-inline Length LengthInLightYears(float length) {
+constexpr Length LengthInLightYears(float length) {
   return LengthInMeters(length * 9460730472580044.0f);
 }
 
-inline Length operator+(Length a, Length b) {
-  return LengthInMeters(a.inMeters() + b.inMeters());
+roo_logging::Stream& operator<<(roo_logging::Stream& os, const Length& val);
+
+/// Representation of length, internally stored as double-precision meters.
+/// Use instead of Length where float precision is insufficient, e.g. for long-
+/// running accumulations. Converts implicitly from Length, and can be mixed
+/// with it in arithmetic; the results are double-precision.
+class DoubleLength
+    : public internal::QuantityBase<DoubleLength, dimension::Length, double> {
+ public:
+  /// Creates a length object representing an 'unknown' length.
+  constexpr DoubleLength() = default;
+
+  /// Converts from the single-precision length. The conversion is exact.
+  constexpr DoubleLength(const Length& length)
+      : QuantityBase(static_cast<double>(length.inSiUnits())) {}
+
+  /// Returns the length in kilometers.
+  constexpr double inKilometers() const { return value_ / 1000.0; }
+
+  /// Returns the length in meters.
+  constexpr double inMeters() const { return value_; }
+
+  /// Returns the length in decimeters.
+  constexpr double inDecimeters() const { return value_ * 10.0; }
+
+  /// Returns the length in centimeters.
+  constexpr double inCentimeters() const { return value_ * 100.0; }
+
+  /// Returns the length in millimeters.
+  constexpr double inMillimeters() const { return value_ * 1000.0; }
+
+  /// Returns the length in micrometers.
+  constexpr double inMicrometers() const { return value_ * 1000000.0; }
+
+  /// Returns the length in nanometers.
+  constexpr double inNanometers() const { return value_ * 1000000000.0; }
+
+  /// Returns the length in inches.
+  constexpr double inInches() const { return value_ / 0.0254; }
+
+  /// Returns the length in feet.
+  constexpr double inFeet() const { return value_ / 0.3048; }
+
+  /// Returns the length in yards.
+  constexpr double inYards() const { return value_ / 0.9144; }
+
+  /// Returns the length in light years.
+  constexpr double inLightYears() const { return value_ / 9460730472580800.0; }
+
+  /// Returns the length, rounded to single precision.
+  constexpr Length toFloat() const {
+    return Length::FromSiUnits(static_cast<float>(value_));
+  }
+
+  /// Writes the string representation of the length into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+  /// Returns the string representation of the length.
+  std::string asString() const;
+#endif
+
+#if defined(ARDUINO)
+  String asArduinoString() const;
+#endif
+
+ private:
+  friend constexpr DoubleLength UnknownDoubleLength();
+
+  friend constexpr DoubleLength DoubleLengthInMeters(double);
+
+  explicit constexpr DoubleLength(double length) : QuantityBase(length) {}
+};
+
+constexpr DoubleLength DoubleLengthInMeters(double length);
+
+/// Returns a double-precision length object representing an unknown length.
+constexpr DoubleLength UnknownDoubleLength() { return DoubleLength(); }
+
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in kilometers.
+constexpr DoubleLength DoubleLengthInKilometers(double length) {
+  return DoubleLengthInMeters(length * 1000.0);
+}
+
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in meters.
+constexpr DoubleLength DoubleLengthInMeters(double length) {
+  return DoubleLength(length);
 }
 
-inline Length operator-(Length a, Length b) {
-  return LengthInMeters(a.inMeters() - b.inMeters());
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in decimeters.
+constexpr DoubleLength DoubleLengthInDecimeters(double length) {
+  return DoubleLengthInMeters(length / 10.0);
 }
 
-inline Length operator-(Length a) { return LengthInMeters(-a.inMeters()); }
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in centimeters.
+constexpr DoubleLength DoubleLengthInCentimeters(double length) {
+  return DoubleLengthInMeters(length / 100.0);
+}
 
-inline Length operator*(Length a, float b) {
-  return LengthInMeters(a.inMeters() * b);
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in millimeters.
+constexpr DoubleLength DoubleLengthInMillimeters(double length) {
+  return DoubleLengthInMeters(length / 1000.0);
 }
 
-inline Length operator*(float a, Length b) {
-  return LengthInMeters(a * b.inMeters());
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in micrometers.
+constexpr DoubleLength DoubleLengthInMicrometers(double length) {
+  return DoubleLengthInMeters(length / 1000000.0);
 }
 
-inline Length operator/(Length a, float b) {
-  return LengthInMeters(a.inMeters() / b);
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in nanometers.
+constexpr DoubleLength DoubleLengthInNanometers(double length) {
+  return DoubleLengthInMeters(length / 1000000000.0);
 }
 
-inline float operator/(Length a, Length b) {
-  return a.inMeters() / b.inMeters();
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in inches.
+constexpr DoubleLength DoubleLengthInInches(double length) {
+  return DoubleLengthInMeters(length * 0.0254);
 }
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const Length& val);
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in feet.
+constexpr DoubleLength DoubleLengthInFeet(double length) {
+  return DoubleLengthInMeters(length * 0.3048);
+}
+
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in yards.
+constexpr DoubleLength DoubleLengthInYards(double length) {
+  return DoubleLengthInMeters(length * 0.9144);
+}
+
+/// Returns a double-precision length object equivalent to the specified
+/// length expressed in light years.
+constexpr DoubleLength DoubleLengthInLightYears(double length) {
+  return DoubleLengthInMeters(length * 9460730472580800.0);
+}
+
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const DoubleLength& val);
 
 }  // namespace roo_quantity
\ No newline at end of file
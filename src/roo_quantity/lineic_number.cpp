@@ -1,23 +1,20 @@
 #include "roo_quantity/lineic_number.h"
 
-#include "roo_quantity/si.h"
+#include "roo_quantity/format.h"
 
 namespace roo_quantity {
-namespace {
 
-void LineicNumberToString(const LineicNumber& val, char* out,
-                           int maxlen) {
-  snprintf(out, maxlen, "%.6g/m", val.inUnitsPerMeter());
+size_t LineicNumber::formatTo(char* out, size_t maxlen) const {
+  internal::StringWriter writer(out, maxlen);
+  writer.appendFloat(inUnitsPerMeter());
+  writer.append("/m");
+  return writer.finish();
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string LineicNumber::asString() const {
-  char out[16];
-  LineicNumberToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -25,19 +22,14 @@ std::string LineicNumber::asString() const {
 #if defined(ARDUINO)
 
 String LineicNumber::asArduinoString() const {
-  char out[16];
-  LineicNumberToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os,
                                 const LineicNumber& val) {
-  char out[16];
-  LineicNumberToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
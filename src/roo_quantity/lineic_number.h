@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
 #include "roo_quantity/length.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -18,87 +20,57 @@ namespace roo_quantity {
 
 /// Representation of lineic number, a reciprocal of length, internally
 /// stored as floating-point units per meter.
-class LineicNumber {
+class LineicNumber
+    : public internal::QuantityBase<LineicNumber, dimension::LineicNumber,
+                                    float> {
  public:
   /// Creates a lineic number object representing an 'unknown'
   /// lineic number.
-  LineicNumber() : lineic_number_(std::nanf("")) {}
+  constexpr LineicNumber() = default;
 
   /// Returns the lineic number in GigaUnitsPerMeter.
-  float inGigaUnitsPerMeter() const { return lineic_number_ * 0.000000001f; }
+  constexpr float inGigaUnitsPerMeter() const { return value_ * 0.000000001f; }
 
   /// Returns the lineic number in Mega-units per meter.
-  float inMegaUnitsPerMeter() const { return lineic_number_ * 0.000001f; }
+  constexpr float inMegaUnitsPerMeter() const { return value_ * 0.000001f; }
 
   /// Returns the lineic number in kilo-units per meter.
-  float inKiloUnitsPerMeter() const { return lineic_number_ * 0.001f; }
+  constexpr float inKiloUnitsPerMeter() const { return value_ * 0.001f; }
 
   /// Returns the lineic number in units per meter.
-  float inUnitsPerMeter() const { return lineic_number_; }
+  constexpr float inUnitsPerMeter() const { return value_; }
 
   /// Returns the lineic number in milli-units per meter.
-  float inMilliUnitsPerMeter() const { return lineic_number_ * 1000.0f; }
+  constexpr float inMilliUnitsPerMeter() const { return value_ * 1000.0f; }
 
   /// Returns the lineic number in micro-units per meter.
-  float inMicroUnitsPerMeter() const { return lineic_number_ * 1000000.0f; }
+  constexpr float inMicroUnitsPerMeter() const { return value_ * 1000000.0f; }
 
   /// Returns the lineic number in units per centimeter.
-  float inUnitsPerCentimeter() const { return lineic_number_ * 0.01f; }
+  constexpr float inUnitsPerCentimeter() const { return value_ * 0.01f; }
 
   /// Returns the lineic number in units per millimeter.
-  float inUnitsPerMillimeter() const { return lineic_number_ * 0.001f; }
+  constexpr float inUnitsPerMillimeter() const { return value_ * 0.001f; }
 
   /// Returns the lineic number in units per kilometer.
-  float inUnitsPerKilometer() const { return lineic_number_ * 1000.0f; }
+  constexpr float inUnitsPerKilometer() const { return value_ * 1000.0f; }
 
   /// Returns the lineic number in units per inch (DPI).
-  float inUnitsPerInch() const { return lineic_number_ * 0.0254f; }
+  constexpr float inUnitsPerInch() const { return value_ * 0.0254f; }
 
   /// Returns the lineic number in units per inch (DPI).
-  float inDPI() const { return inUnitsPerInch(); }
+  constexpr float inDPI() const { return inUnitsPerInch(); }
 
   /// Returns the lineic number in units per foot.
-  float inUnitsPerFoot() const { return lineic_number_ * 0.3048f; }
+  constexpr float inUnitsPerFoot() const { return value_ * 0.3048f; }
 
   /// Returns the lineic number in units per yard.
-  float inUnitsPerYard() const { return lineic_number_ * 0.9144f; }
+  constexpr float inUnitsPerYard() const { return value_ * 0.9144f; }
 
-  /// Returns whether the object represents an unknown lineic number.
-  bool isUnknown() const { return std::isnan(lineic_number_); }
-
-  bool operator<(const LineicNumber &other) const {
-    return lineic_number_ < other.lineic_number_;
-  }
-
-  bool operator==(const LineicNumber &other) const {
-    return lineic_number_ == other.lineic_number_;
-  }
-
-  bool operator>(const LineicNumber &other) const {
-    return other.lineic_number_ < lineic_number_;
-  }
-
-  bool operator<=(const LineicNumber &other) const {
-    return !(other.lineic_number_ < lineic_number_);
-  }
-
-  bool operator>=(const LineicNumber &other) const {
-    return !(lineic_number_ < other.lineic_number_);
-  }
-
-  bool operator!=(const LineicNumber &other) const {
-    return !(lineic_number_ == other.lineic_number_);
-  }
-
-  LineicNumber &operator*=(float multi) {
-    lineic_number_ *= multi;
-    return *this;
-  }
-
-  LineicNumber &operator/=(float div) {
-    lineic_number_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the lineic number into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char *out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the lineic number.
@@ -110,126 +82,92 @@ class LineicNumber {
 #endif
 
  private:
-  friend LineicNumber UnknownLineicNumber();
-
-  friend LineicNumber LineicNumberInUnitsPerMeter(float);
+  friend constexpr LineicNumber UnknownLineicNumber();
 
-  explicit LineicNumber(float lineic_number) : lineic_number_(lineic_number) {}
+  friend constexpr LineicNumber LineicNumberInUnitsPerMeter(float);
 
-  /// Stored in units per meter.
-  float lineic_number_;
+  explicit constexpr LineicNumber(float lineic_number)
+      : QuantityBase(lineic_number) {}
 };
 
-inline LineicNumber LineicNumberInUnitsPerMeter(float lineic_number);
+constexpr LineicNumber LineicNumberInUnitsPerMeter(float lineic_number);
 
 /// Returns a lineic number object representing an unknown
 /// lineic number.
-inline LineicNumber UnknownLineicNumber() { return LineicNumber(); }
+constexpr LineicNumber UnknownLineicNumber() { return LineicNumber(); }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in giga-units per meter.
-inline LineicNumber LineicNumberInGigaUnitsPerMeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInGigaUnitsPerMeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 1000000000.0f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in mega-units per meter.
-inline LineicNumber LineicNumberInMegaUnitsPerMeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInMegaUnitsPerMeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 1000000.0f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in kilo-units per meter.
-inline LineicNumber LineicNumberInKiloUnitsPerMeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInKiloUnitsPerMeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 1000.0f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per meter.
-inline LineicNumber LineicNumberInUnitsPerMeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerMeter(float lineic_number) {
   return LineicNumber(lineic_number);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in milli-units per meter.
-inline LineicNumber LineicNumberInMilliUnitsPerMeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInMilliUnitsPerMeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 0.001f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in micro-units per meter.
-inline LineicNumber LineicNumberInMicroUnitsPerMeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInMicroUnitsPerMeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 0.000001f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per centimeter.
-inline LineicNumber LineicNumberInUnitsPerCentimeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerCentimeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 100.0f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per millimeter.
-inline LineicNumber LineicNumberInUnitsPerMillimeter(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerMillimeter(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 1000.0f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per kilometer.
-inline LineicNumber LineicNumberInUnitsPerKilometer(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerKilometer(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 0.001f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per inch.
-inline LineicNumber LineicNumberInUnitsPerInch(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerInch(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 39.37007874f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per foot.
-inline LineicNumber LineicNumberInUnitsPerFoot(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerFoot(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 3.280839895f);
 }
 
 /// Returns a lineic number object equivalent to the specified
 /// lineic number expressed in units per yard.
-inline LineicNumber LineicNumberInUnitsPerYard(float lineic_number) {
+constexpr LineicNumber LineicNumberInUnitsPerYard(float lineic_number) {
   return LineicNumberInUnitsPerMeter(lineic_number * 1.0936132983f);
 }
 
-inline LineicNumber operator*(LineicNumber a, float b) {
-  return LineicNumberInUnitsPerMeter(a.inUnitsPerMeter() * b);
-}
-
-inline LineicNumber operator*(float a, LineicNumber b) {
-  return LineicNumberInUnitsPerMeter(a * b.inUnitsPerMeter());
-}
-
-inline float operator*(Length a, LineicNumber b) {
-  return a.inMeters() * b.inUnitsPerMeter();
-}
-
-inline float operator*(LineicNumber a, Length b) {
-  return a.inUnitsPerMeter() * b.inMeters();
-}
-
-inline LineicNumber operator/(LineicNumber a, float b) {
-  return LineicNumberInUnitsPerMeter(a.inUnitsPerMeter() / b);
-}
-
-inline float operator/(LineicNumber a, LineicNumber b) {
-  return a.inUnitsPerMeter() / b.inUnitsPerMeter();
-}
-
-inline Length operator/(float a, LineicNumber b) {
-  return LengthInMeters(a / b.inUnitsPerMeter());
-}
-
-inline LineicNumber operator/(float a, Length b) {
-  return LineicNumberInUnitsPerMeter(a / b.inMeters());
-}
-
 roo_logging::Stream& operator<<(roo_logging::Stream& os,
                                 const LineicNumber& val);
 
@@ -0,0 +1,104 @@
+#pragma once
+
+// User-defined literals for the common quantities, e.g. 3.3_V, 20_mA, 25_degC,
+// 10_ms. They are constexpr, so constants defined with them fold at compile
+// time.
+//
+// The literals are opt-in; to use them, bring them into scope with:
+//
+//   using namespace roo_quantity::literals;
+
+#include "roo_quantity/capacitance.h"
+#include "roo_quantity/charge.h"
+#include "roo_quantity/current.h"
+#include "roo_quantity/frequency.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/mass.h"
+#include "roo_quantity/power.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/resistance.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/time.h"
+#include "roo_quantity/voltage.h"
+#include "roo_quantity/work.h"
+
+namespace roo_quantity {
+namespace literals {
+
+#define ROO_QUANTITY_LITERAL(type, suffix, factory)              \
+  constexpr type operator""_##suffix(long double val) {          \
+    return factory(static_cast<float>(val));                     \
+  }                                                              \
+  constexpr type operator""_##suffix(unsigned long long val) {   \
+    return factory(static_cast<float>(val));                     \
+  }
+
+ROO_QUANTITY_LITERAL(Voltage, kV, VoltageInKiloVolts)
+ROO_QUANTITY_LITERAL(Voltage, V, VoltageInVolts)
+ROO_QUANTITY_LITERAL(Voltage, mV, VoltageInMilliVolts)
+ROO_QUANTITY_LITERAL(Voltage, uV, VoltageInMicroVolts)
+
+ROO_QUANTITY_LITERAL(Current, A, CurrentInAmperes)
+ROO_QUANTITY_LITERAL(Current, mA, CurrentInMilliAmperes)
+ROO_QUANTITY_LITERAL(Current, uA, CurrentInMicroAmperes)
+
+ROO_QUANTITY_LITERAL(Power, kW, PowerInKiloWatts)
+ROO_QUANTITY_LITERAL(Power, W, PowerInWatts)
+ROO_QUANTITY_LITERAL(Power, mW, PowerInMilliWatts)
+ROO_QUANTITY_LITERAL(Power, uW, PowerInMicroWatts)
+
+ROO_QUANTITY_LITERAL(Resistance, MOhm, ResistanceInMegaOhms)
+ROO_QUANTITY_LITERAL(Resistance, kOhm, ResistanceInKiloOhms)
+ROO_QUANTITY_LITERAL(Resistance, Ohm, ResistanceInOhms)
+ROO_QUANTITY_LITERAL(Resistance, mOhm, ResistanceInMilliOhms)
+
+ROO_QUANTITY_LITERAL(Capacitance, F, CapacitanceInFarads)
+ROO_QUANTITY_LITERAL(Capacitance, mF, CapacitanceInMilliFarads)
+ROO_QUANTITY_LITERAL(Capacitance, uF, CapacitanceInMicroFarads)
+ROO_QUANTITY_LITERAL(Capacitance, nF, CapacitanceInNanoFarads)
+ROO_QUANTITY_LITERAL(Capacitance, pF, CapacitanceInPicoFarads)
+
+ROO_QUANTITY_LITERAL(Charge, C, ChargeInCoulombs)
+ROO_QUANTITY_LITERAL(Charge, mC, ChargeInMilliCoulombs)
+ROO_QUANTITY_LITERAL(Charge, uC, ChargeInMicroCoulombs)
+
+ROO_QUANTITY_LITERAL(Work, kJ, WorkInKiloJoules)
+ROO_QUANTITY_LITERAL(Work, J, WorkInJoules)
+ROO_QUANTITY_LITERAL(Work, mJ, WorkInMilliJoules)
+
+ROO_QUANTITY_LITERAL(Temperature, degC, TemperatureDegCelcius)
+ROO_QUANTITY_LITERAL(Temperature, degF, TemperatureDegFahrenheit)
+ROO_QUANTITY_LITERAL(Temperature, degK, TemperatureDegKelvin)
+
+ROO_QUANTITY_LITERAL(Time, h, TimeInHours)
+ROO_QUANTITY_LITERAL(Time, min, TimeInMinutes)
+ROO_QUANTITY_LITERAL(Time, s, TimeInSeconds)
+ROO_QUANTITY_LITERAL(Time, ms, TimeInMilliseconds)
+ROO_QUANTITY_LITERAL(Time, us, TimeInMicroseconds)
+ROO_QUANTITY_LITERAL(Time, ns, TimeInNanoseconds)
+
+ROO_QUANTITY_LITERAL(Frequency, GHz, FrequencyInGigaHertz)
+ROO_QUANTITY_LITERAL(Frequency, MHz, FrequencyInMegaHertz)
+ROO_QUANTITY_LITERAL(Frequency, kHz, FrequencyInKiloHertz)
+ROO_QUANTITY_LITERAL(Frequency, Hz, FrequencyInHertz)
+
+ROO_QUANTITY_LITERAL(Length, km, LengthInKilometers)
+ROO_QUANTITY_LITERAL(Length, m, LengthInMeters)
+ROO_QUANTITY_LITERAL(Length, cm, LengthInCentimeters)
+ROO_QUANTITY_LITERAL(Length, mm, LengthInMillimeters)
+ROO_QUANTITY_LITERAL(Length, um, LengthInMicrometers)
+
+ROO_QUANTITY_LITERAL(Mass, kg, MassInKilograms)
+ROO_QUANTITY_LITERAL(Mass, g, MassInGrams)
+ROO_QUANTITY_LITERAL(Mass, mg, MassInMilligrams)
+
+ROO_QUANTITY_LITERAL(Pressure, MPa, PressureInMegaPascals)
+ROO_QUANTITY_LITERAL(Pressure, bar, PressureInBars)
+ROO_QUANTITY_LITERAL(Pressure, kPa, PressureInKiloPascals)
+ROO_QUANTITY_LITERAL(Pressure, hPa, PressureInHectoPascals)
+ROO_QUANTITY_LITERAL(Pressure, Pa, PressureInPascals)
+
+#undef ROO_QUANTITY_LITERAL
+
+}  // namespace literals
+}  // namespace roo_quantity
@@ -1,51 +1,29 @@
 #include "roo_quantity/mass.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void MassToString(Mass val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? kg", maxlen);
-  } else {
-    const char* format;
-    const char* sign = "";
-    float num;
-    if (val.inKg() == 0.0f) {
-      snprintf(out, maxlen, "0 kg");
-      return;
-    }
-    if (val.inKg() < 0) {
-      sign = "-";
-      val = -val;
-    }
-    if (val >= MassInTons(1.0f)) {
-      format = "%s%g t";
-      num = val.inTons();
-    } else if (val >= MassInKilograms(1.0f)) {
-      format = "%s%g kg";
-      num = val.inKilograms();
-    } else if (val >= MassInGrams(1.0f)) {
-      format = "%s%g g";
-      num = val.inGrams();
-    } else if (val >= MassInMilligrams(1.0f)) {
-      format = "%s%g mg";
-      num = val.inMilligrams();
-    } else {
-      format = "%s%g µg";
-      num = val.inMicrograms();
-    }
-    snprintf(out, maxlen, format, sign, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kMassUnits[] = {
+    {1000.0f,   0.001f,        " t"},
+    {1.0f,      1.0f,          " kg"},
+    {0.001f,    1000.0f,       " g"},
+    {0.000001f, 1000000.0f,    " mg"},
+    {0.0f,      1000000000.0f, " µg"},
+};
 
 }  // namespace
 
+size_t Mass::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inKilograms(), kMassUnits, " kg", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Mass::asString() const {
-  char out[16];
-  MassToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -53,18 +31,13 @@ std::string Mass::asString() const {
 #if defined(ARDUINO)
 
 String Mass::asArduinoString() const {
-  char out[16];
-  MassToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Mass& val) {
-  char out[16];
-  MassToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
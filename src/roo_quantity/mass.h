@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -16,68 +18,38 @@
 namespace roo_quantity {
 
 /// Representation of mass, internally stored as floating-point kilograms.
-class Mass {
+class Mass : public internal::QuantityBase<Mass, dimension::Mass, float> {
  public:
   /// Creates a mass object representing an 'unknown' mass.
-  Mass() : mass_(std::nanf("")) {}
+  constexpr Mass() = default;
 
   /// Returns the mass in metric tonnes.
-  float inTons() const { return mass_ * 0.001f; }
+  constexpr float inTons() const { return value_ * 0.001f; }
 
   /// Returns the mass in kilograms.
-  float inKilograms() const { return mass_; }
+  constexpr float inKilograms() const { return value_; }
 
-  float inKg() const { return inKilograms(); }
+  constexpr float inKg() const { return inKilograms(); }
 
   /// Returns the mass in grams.
-  float inGrams() const { return mass_ * 1000.0f; }
+  constexpr float inGrams() const { return value_ * 1000.0f; }
 
   /// Returns the mass in milligrams.
-  float inMilligrams() const { return mass_ * 1000000.0f; }
+  constexpr float inMilligrams() const { return value_ * 1000000.0f; }
 
   /// Returns the mass in micrograms.
-  float inMicrograms() const { return mass_ * 1000000000.0f; }
+  constexpr float inMicrograms() const { return value_ * 1000000000.0f; }
 
   /// Returns the mass in pounds.
-  float inPounds() const { return mass_ * 2.2046226218f; }
+  constexpr float inPounds() const { return value_ * 2.2046226218f; }
 
   /// Returns the mass in pounds.
-  float inLbs() const { return inPounds(); }
+  constexpr float inLbs() const { return inPounds(); }
 
-  /// Returns whether the object represents an unknown mass.
-  bool isUnknown() const { return std::isnan(mass_); }
-
-  bool operator<(const Mass& other) const { return mass_ < other.mass_; }
-
-  bool operator==(const Mass& other) const { return mass_ == other.mass_; }
-
-  bool operator>(const Mass& other) const { return other.mass_ < mass_; }
-
-  bool operator<=(const Mass& other) const { return !(other.mass_ < mass_); }
-
-  bool operator>=(const Mass& other) const { return !(mass_ < other.mass_); }
-
-  bool operator!=(const Mass& other) const { return !(mass_ == other.mass_); }
-
-  inline Mass& operator+=(const Mass& other) {
-    mass_ += other.inKg();
-    return *this;
-  }
-
-  inline Mass& operator-=(const Mass& other) {
-    mass_ -= other.inKg();
-    return *this;
-  }
-
-  inline Mass& operator*=(float multi) {
-    mass_ *= multi;
-    return *this;
-  }
-
-  inline Mass& operator/=(float div) {
-    mass_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the mass into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the mass.
@@ -89,68 +61,53 @@ class Mass {
 #endif
 
  private:
-  friend Mass UnknownMass();
+  friend constexpr Mass UnknownMass();
 
-  friend Mass MassInKilograms(float);
+  friend constexpr Mass MassInKilograms(float);
 
-  explicit Mass(float mass) : mass_(mass) {}
-
-  /// Stored in kg.
-  float mass_;
+  explicit constexpr Mass(float mass) : QuantityBase(mass) {}
 };
 
-inline Mass MassInGrams(float mass);
+constexpr Mass MassInGrams(float mass);
 
 /// Returns a mass object representing an unknown mass.
-inline Mass UnknownMass() { return Mass(); }
+constexpr Mass UnknownMass() { return Mass(); }
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in kilograms.
-inline Mass MassInKilograms(float mass) { return Mass(mass); }
+constexpr Mass MassInKilograms(float mass) { return Mass(mass); }
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in kilograms.
-inline Mass MassInKg(float mass) { return MassInKilograms(mass); }
+constexpr Mass MassInKg(float mass) { return MassInKilograms(mass); }
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in metric tons.
-inline Mass MassInTons(float mass) { return MassInKilograms(mass * 1000.0f); }
+constexpr Mass MassInTons(float mass) {
+  return MassInKilograms(mass * 1000.0f);
+}
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in grams.
-inline Mass MassInGrams(float mass) { return MassInKg(mass * 0.001f); }
+constexpr Mass MassInGrams(float mass) { return MassInKg(mass * 0.001f); }
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in milligrams.
-inline Mass MassInMilligrams(float mass) {
+constexpr Mass MassInMilligrams(float mass) {
   return MassInKilograms(mass * 0.000001f);
 }
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in micrograms.
-inline Mass MassInMicrograms(float mass) {
+constexpr Mass MassInMicrograms(float mass) {
   return MassInKg(mass * 0.000000001f);
 }
 
 /// Returns a mass object equivalent to the specified mass
 /// expressed in pounds.
-inline Mass MassInPounds(float mass) { return MassInKg(mass * 0.45359237f); }
-
-inline Mass MassInLbs(float mass) { return MassInPounds(mass); }
-
-inline Mass operator+(Mass a, Mass b) { return MassInKg(a.inKg() + b.inKg()); }
-
-inline Mass operator-(Mass a, Mass b) { return MassInKg(a.inKg() - b.inKg()); }
-
-inline Mass operator-(Mass a) { return MassInKg(-a.inKg()); }
-
-inline Mass operator*(Mass a, float b) { return MassInKg(a.inKg() * b); }
-
-inline Mass operator*(float a, Mass b) { return MassInKg(a * b.inKg()); }
-
-inline Mass operator/(Mass a, float b) { return MassInKg(a.inKg() / b); }
+constexpr Mass MassInPounds(float mass) { return MassInKg(mass * 0.45359237f); }
 
-inline float operator/(Mass a, Mass b) { return a.inKg() / b.inKg(); }
+constexpr Mass MassInLbs(float mass) { return MassInPounds(mass); }
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Mass& val);
 
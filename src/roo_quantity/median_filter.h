@@ -0,0 +1,208 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <limits>
+
+#include "roo_quantity/span.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// The last N raw values of a stream, with the known (non-NaN) ones also kept
+/// in sorted order. Adding a value shifts at most N elements of the sorted
+/// array, to remove the evicted value and to insert the new one (as in
+/// insertion sort). For the window sizes used to filter sensor data, this
+/// beats O(log N) tree- or heap-based structures, as well as sorting networks
+/// on a copy of the window.
+template <typename Rep, size_t N>
+class SortedWindow {
+ public:
+  constexpr SortedWindow()
+      : ring_(), sorted_(), pos_(0), count_(0), known_(0) {}
+
+  /// Adds a value, evicting the oldest one if the window is full.
+  void push(Rep x) {
+    if (count_ == N) {
+      Rep old = ring_[pos_];
+      if (old == old) {
+        for (size_t i = LowerBound(old); i + 1 < known_; ++i) {
+          sorted_[i] = sorted_[i + 1];
+        }
+        --known_;
+      }
+    } else {
+      ++count_;
+    }
+    ring_[pos_] = x;
+    if (++pos_ == N) pos_ = 0;
+    if (x == x) {
+      size_t i = known_;
+      for (; i > 0 && x < sorted_[i - 1]; --i) sorted_[i] = sorted_[i - 1];
+      sorted_[i] = x;
+      ++known_;
+    }
+  }
+
+  /// Returns the number of known values in the window.
+  size_t known() const { return known_; }
+
+  /// Returns the median of the known values (the mean of the two middle ones,
+  /// if their number is even), or NaN if there are none.
+  Rep median() const {
+    if (known_ == 0) return std::numeric_limits<Rep>::quiet_NaN();
+    Rep upper = sorted_[known_ / 2];
+    if (known_ % 2 == 1) return upper;
+    Rep lower = sorted_[known_ / 2 - 1];
+    return lower + (upper - lower) / 2;
+  }
+
+  /// Returns the median absolute deviation of the known values from `m` (the
+  /// median), or NaN if there are none. Takes O(N) time: the deviations of
+  /// the values below and above the median are both sorted, so the middle of
+  /// their union is found by merging them.
+  Rep medianAbsoluteDeviation(Rep m) const {
+    if (known_ == 0) return std::numeric_limits<Rep>::quiet_NaN();
+    // Values in [0, split) are below m; the others are not.
+    size_t split = LowerBound(m);
+    size_t below = split;  // Next candidate below, at index below - 1.
+    size_t above = split;  // Next candidate above.
+    Rep prev = 0;
+    Rep current = 0;
+    for (size_t taken = 0; taken <= known_ / 2; ++taken) {
+      prev = current;
+      if (above == known_ ||
+          (below > 0 && m - sorted_[below - 1] < sorted_[above] - m)) {
+        current = m - sorted_[--below];
+      } else {
+        current = sorted_[above++] - m;
+      }
+    }
+    return known_ % 2 == 1 ? current : prev + (current - prev) / 2;
+  }
+
+  void clear() { *this = SortedWindow(); }
+
+ private:
+  // Index of the first sorted value not less than x.
+  size_t LowerBound(Rep x) const {
+    size_t lo = 0;
+    size_t hi = known_;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (sorted_[mid] < x) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  Rep ring_[N];
+  Rep sorted_[N];
+  size_t pos_;
+  size_t count_;
+  size_t known_;
+};
+
+}  // namespace internal
+
+/// Sliding-window median of the last N samples of a stream of quantities.
+/// Rejects spikes (up to (N - 1) / 2 consecutive ones) while preserving
+/// steps, unlike averaging filters. Unknown samples occupy their place in the
+/// window, but are otherwise skipped. Works with any quantity class, including
+/// Temperature.
+///
+/// Example:
+///
+///   MedianFilter<Pressure, 5> filter;
+///   ...
+///   Pressure p = filter.update(sensor.read());
+template <typename Q, size_t N>
+class MedianFilter {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  static_assert(N >= 1, "The window must not be empty");
+
+  constexpr MedianFilter() = default;
+
+  /// Adds the next sample, and returns the median of the window.
+  Q update(const Q& q) {
+    window_.push(internal::RawTraits<Q>::ToRaw(q));
+    return value();
+  }
+
+  /// Returns the median of the known samples in the window, or unknown if
+  /// there are none.
+  Q value() const { return internal::RawTraits<Q>::FromRaw(window_.median()); }
+
+  /// Forgets all samples.
+  void reset() { window_.clear(); }
+
+ private:
+  internal::SortedWindow<Rep, N> window_;
+};
+
+/// Hampel outlier filter: passes each sample through, unless it deviates from
+/// the median of the last N samples (itself included) by more than
+/// `threshold` times the scaled median absolute deviation (a robust estimate
+/// of the standard deviation), in which case it is replaced by the median.
+/// Unlike MedianFilter, leaves inliers unchanged. Unknown samples are passed
+/// through as unknown, and do not count towards the window statistics.
+///
+/// Example:
+///
+///   HampelFilter<VolumeFlowRate, 7> filter;
+///   ...
+///   VolumeFlowRate flow = filter.update(meter.read());
+template <typename Q, size_t N>
+class HampelFilter {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  static_assert(N >= 3, "The window must have at least three samples");
+
+  /// Creates the filter with the specified threshold, in (robust) standard
+  /// deviations; 3 is customary.
+  explicit constexpr HampelFilter(float threshold = 3.0f)
+      : threshold_(static_cast<Rep>(threshold)), outlier_(false) {}
+
+  /// Adds the next sample, and returns it, or the median of the window if the
+  /// sample is an outlier.
+  Q update(const Q& q) {
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    window_.push(x);
+    outlier_ = false;
+    if (x != x) return q;
+    Rep m = window_.median();
+    // 1.4826 * MAD estimates the standard deviation of normal data.
+    Rep sigma = static_cast<Rep>(1.4826f) * window_.medianAbsoluteDeviation(m);
+    Rep deviation = x - m;
+    if (deviation < 0) deviation = -deviation;
+    if (deviation > threshold_ * sigma) {
+      outlier_ = true;
+      return internal::RawTraits<Q>::FromRaw(m);
+    }
+    return q;
+  }
+
+  /// Returns whether the last sample was rejected as an outlier.
+  bool lastWasOutlier() const { return outlier_; }
+
+  /// Forgets all samples.
+  void reset() {
+    window_.clear();
+    outlier_ = false;
+  }
+
+ private:
+  internal::SortedWindow<Rep, N> window_;
+  Rep threshold_;
+  bool outlier_;
+};
+
+}  // namespace roo_quantity
@@ -1,22 +1,18 @@
 #include "roo_quantity/power.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void PowerToString(const Power& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inWatts(), "W", out, maxlen);
+size_t Power::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inWatts(), "W", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Power::asString() const {
-  char out[16];
-  PowerToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,13 @@ std::string Power::asString() const {
 #if defined(ARDUINO)
 
 String Power::asArduinoString() const {
-  char out[16];
-  PowerToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Power& val) {
-  char out[16];
-  PowerToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,63 +1,31 @@
 #include "roo_quantity/pressure.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void PressureToString(Pressure val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? Pa", maxlen);
-  } else {
-    const char* format;
-    const char* sign = "";
-    float num;
-    if (val.inPascals() == 0.0f) {
-      snprintf(out, maxlen, "0 Pa");
-      return;
-    }
-    if (val.inPascals() < 0) {
-      sign = "-";
-      val = -val;
-    }
-    if (val >= PressureInGigaPascals(1.0f)) {
-      format = "%s%g GPa";
-      num = val.inGigaPascals();
-    } else if (val >= PressureInMegaPascals(2.0f)) {
-      format = "%s%g MPa";
-      num = val.inMegaPascals();
-    } else if (val >= PressureInBars(0.1f)) {
-      format = "%s%g bar";
-      num = val.inBars();
-    // } else if (val >= PressureInHectoPascals(1100.0f)) {
-    //   format = "%s%g kPa";
-    //   num = val.inKiloPascals();
-    // } else if (val >= PressureInHectoPascals(800.0f)) {
-    //   format = "%s%g hPa";
-    //   num = val.inHectoPascals();
-    } else if (val >= PressureInKiloPascals(1.0f)) {
-      format = "%s%g kPa";
-      num = val.inKiloPascals();
-    } else if (val >= PressureInPascals(1.0f)) {
-      format = "%s%g Pa";
-      num = val.inPascals();
-    } else if (val >= PressureInMilliPascals(1.0f)) {
-      format = "%s%g mPa";
-      num = val.inMilliPascals();
-    } else {
-      format = "%s%g µPa";
-      num = val.inMicroPascals();
-    }
-    snprintf(out, maxlen, format, sign, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kPressureUnits[] = {
+    {1000000000.0f, 0.000000001f, " GPa"},
+    {2000000.0f,    0.000001f,    " MPa"},
+    {10000.0f,      0.00001f,     " bar"},
+    {1000.0f,       0.001f,       " kPa"},
+    {1.0f,          1.0f,         " Pa"},
+    {0.001f,        1000.0f,      " mPa"},
+    {0.0f,          1000000.0f,   " µPa"},
+};
 
 }  // namespace
 
+size_t Pressure::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inPascals(), kPressureUnits, " Pa", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Pressure::asString() const {
-  char out[16];
-  PressureToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -65,18 +33,13 @@ std::string Pressure::asString() const {
 #if defined(ARDUINO)
 
 String Pressure::asArduinoString() const {
-  char out[16];
-  PressureToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Pressure& val) {
-  char out[16];
-  PressureToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
 #include "roo_quantity/area.h"
 #include "roo_quantity/areic_number.h"
 #include "roo_quantity/force.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -19,84 +21,43 @@
 namespace roo_quantity {
 
 /// Representation of pressure, internally stored as floating-point Pascals.
-class Pressure {
+class Pressure
+    : public internal::QuantityBase<Pressure, dimension::Pressure, float> {
  public:
   /// Creates a pressure object representing an 'unknown' pressure.
-  Pressure() : pressure_(std::nanf("")) {}
+  constexpr Pressure() = default;
 
   /// Returns the pressure in GigaPascals.
-  float inGigaPascals() const { return pressure_ * 0.000000001f; }
+  constexpr float inGigaPascals() const { return value_ * 0.000000001f; }
 
   /// Returns the pressure in MegaPascals.
-  float inMegaPascals() const { return pressure_ * 0.000001f; }
+  constexpr float inMegaPascals() const { return value_ * 0.000001f; }
 
   /// Returns the pressure in bars.
-  float inBars() const { return pressure_ * 0.00001f; }
+  constexpr float inBars() const { return value_ * 0.00001f; }
 
   /// Returns the pressure in kiloPascals.
-  float inKiloPascals() const { return pressure_ * 0.001f; }
+  constexpr float inKiloPascals() const { return value_ * 0.001f; }
 
   /// Returns the pressure in HectoPascals.
-  float inHectoPascals() const { return pressure_ * 0.01f; }
+  constexpr float inHectoPascals() const { return value_ * 0.01f; }
 
   /// Returns the pressure in Pascals.
-  float inPascals() const { return pressure_; }
+  constexpr float inPascals() const { return value_; }
 
   /// Returns the pressure in milliPascals.
-  float inMilliPascals() const { return pressure_ * 1000.0f; }
+  constexpr float inMilliPascals() const { return value_ * 1000.0f; }
 
   /// Returns the pressure in microPascals.
-  float inMicroPascals() const { return pressure_ * 1000000.0f; }
+  constexpr float inMicroPascals() const { return value_ * 1000000.0f; }
 
   /// Returns the pressure in PSI (pound per square inch).
-  float inPSI() const { return pressure_ * 0.0001450377f; }
+  constexpr float inPSI() const { return value_ * 0.0001450377f; }
 
-  /// Returns whether the object represents an unknown pressure.
-  bool isUnknown() const { return std::isnan(pressure_); }
-
-  bool operator<(const Pressure& other) const {
-    return pressure_ < other.pressure_;
-  }
-
-  bool operator==(const Pressure& other) const {
-    return pressure_ == other.pressure_;
-  }
-
-  bool operator>(const Pressure& other) const {
-    return other.pressure_ < pressure_;
-  }
-
-  bool operator<=(const Pressure& other) const {
-    return !(other.pressure_ < pressure_);
-  }
-
-  bool operator>=(const Pressure& other) const {
-    return !(pressure_ < other.pressure_);
-  }
-
-  bool operator!=(const Pressure& other) const {
-    return !(pressure_ == other.pressure_);
-  }
-
-  inline Pressure& operator+=(const Pressure& other) {
-    pressure_ += other.inPascals();
-    return *this;
-  }
-
-  inline Pressure& operator-=(const Pressure& other) {
-    pressure_ -= other.inPascals();
-    return *this;
-  }
-
-  inline Pressure& operator*=(float multi) {
-    pressure_ *= multi;
-    return *this;
-  }
-
-  inline Pressure& operator/=(float div) {
-    pressure_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the pressure into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the pressure.
@@ -108,109 +69,72 @@ class Pressure {
 #endif
 
  private:
-  friend Pressure UnknownPressure();
+  friend constexpr Pressure UnknownPressure();
 
-  friend Pressure PressureInPascals(float);
+  friend constexpr Pressure PressureInPascals(float);
 
-  explicit Pressure(float pressure) : pressure_(pressure) {}
-
-  /// Stored in Pascals.
-  float pressure_;
+  explicit constexpr Pressure(float pressure) : QuantityBase(pressure) {}
 };
 
-inline Pressure PressureInPascals(float pressure);
+constexpr Pressure PressureInPascals(float pressure);
 
 /// Returns a pressure object representing an unknown pressure.
-inline Pressure UnknownPressure() { return Pressure(); }
+constexpr Pressure UnknownPressure() { return Pressure(); }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in GigaPascals.
-inline Pressure PressureInGigaPascals(float pressure) {
+constexpr Pressure PressureInGigaPascals(float pressure) {
   return PressureInPascals(pressure * 1000000000.0f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in MegaPascals.
-inline Pressure PressureInMegaPascals(float pressure) {
+constexpr Pressure PressureInMegaPascals(float pressure) {
   return PressureInPascals(pressure * 1000000.0f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in bars.
-inline Pressure PressureInBars(float pressure) {
+constexpr Pressure PressureInBars(float pressure) {
   return PressureInPascals(pressure * 100000.0f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in kiloPascals.
-inline Pressure PressureInKiloPascals(float pressure) {
+constexpr Pressure PressureInKiloPascals(float pressure) {
   return PressureInPascals(pressure * 1000.0f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in hectoPascals.
-inline Pressure PressureInHectoPascals(float pressure) {
+constexpr Pressure PressureInHectoPascals(float pressure) {
   return PressureInPascals(pressure * 100.0f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in Pascals.
-inline Pressure PressureInPascals(float pressure) { return Pressure(pressure); }
+constexpr Pressure PressureInPascals(float pressure) {
+  return Pressure(pressure);
+}
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in milliPascals.
-inline Pressure PressureInMilliPascals(float pressure) {
+constexpr Pressure PressureInMilliPascals(float pressure) {
   return PressureInPascals(pressure * 0.001f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in microPascals.
-inline Pressure PressureInMicroPascals(float pressure) {
+constexpr Pressure PressureInMicroPascals(float pressure) {
   return PressureInPascals(pressure * 0.000001f);
 }
 
 /// Returns a pressure object equivalent to the specified pressure
 /// expressed in PSI (pounds per square inch).
-inline Pressure PressureInPSI(float pressure) {
+constexpr Pressure PressureInPSI(float pressure) {
   return PressureInPascals(pressure * 6894.7572932f);
 }
 
-inline Pressure operator+(Pressure a, Pressure b) {
-  return PressureInPascals(a.inPascals() + b.inPascals());
-}
-
-inline Pressure operator-(Pressure a, Pressure b) {
-  return PressureInPascals(a.inPascals() - b.inPascals());
-}
-
-inline Pressure operator-(Pressure a) {
-  return PressureInPascals(-a.inPascals());
-}
-
-inline Pressure operator*(Pressure a, float b) {
-  return PressureInPascals(a.inPascals() * b);
-}
-
-inline Pressure operator*(float a, Pressure b) {
-  return PressureInPascals(a * b.inPascals());
-}
-
-inline Pressure operator/(Pressure a, float b) {
-  return PressureInPascals(a.inPascals() / b);
-}
-
-inline float operator/(Pressure a, Pressure b) {
-  return a.inPascals() / b.inPascals();
-}
-
-inline Pressure operator/(Force a, Area b) {
-  return PressureInPascals(a.inNewtons() / b.inSquareMeters());
-}
-
-inline Pressure operator*(Force a, AreicNumber b) {
-  return PressureInPascals(a.inNewtons() * b.inUnitsPerSquareMeter());
-}
-
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Pressure& val);
 
 }  // namespace roo_quantity
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "roo_quantity/frequency.h"
+#include "roo_quantity/volume.h"
+#include "roo_quantity/volume_flow_rate.h"
+#include "roo_time.h"
+
+namespace roo_quantity {
+
+// Pulse-rate estimation for Hall-effect flow meters, tachometers, and other
+// sensors that emit a pulse per unit of the measured quantity. Pulses are
+// recorded with integer operations only (an increment, and for
+// PulsePeriodMeter, a 32-bit timestamp store), so that the recording method can
+// be called from interrupt handlers, even on microcontrollers without an FPU.
+// Conversion to quantities happens when the rate is sampled, with a single
+// floating-point division.
+//
+// The recording methods are not atomic with respect to the others. If pulses
+// are recorded from an interrupt handler, call sample() and reset() with
+// interrupts disabled.
+
+/// A number of pulses counted over a time interval.
+struct PulseRate {
+  /// The number of pulses; for PulsePeriodMeter, the number of complete
+  /// periods.
+  uint32_t pulses;
+
+  /// The interval over which the pulses have been counted.
+  roo_time::Duration interval;
+
+  /// Returns the pulse frequency, or unknown if the interval is empty.
+  Frequency frequency() const {
+    if (interval.inMicros() <= 0) return Frequency();
+    return FrequencyFromCount(static_cast<float>(pulses), interval);
+  }
+
+  /// Returns the rotational frequency of a shaft emitting the specified number
+  /// of pulses per revolution; e.g. rotationalFrequency(2).inRPM() for a
+  /// typical PC fan.
+  Frequency rotationalFrequency(uint32_t pulses_per_revolution) const {
+    return frequency() / static_cast<float>(pulses_per_revolution);
+  }
+
+  /// Returns the flow rate through a flow meter emitting the specified number
+  /// of pulses per liter (the 'K-factor' in its datasheet).
+  VolumeFlowRate flowRate(float pulses_per_liter) const {
+    return VolumeFlowRateInLitersPerSecond(frequency().inHertz() /
+                                           pulses_per_liter);
+  }
+
+  /// Returns the volume that has flown through a flow meter emitting the
+  /// specified number of pulses per liter.
+  Volume volume(float pulses_per_liter) const {
+    return VolumeInLiters(static_cast<float>(pulses) / pulses_per_liter);
+  }
+};
+
+/// Measures the pulse rate by counting pulses in consecutive windows, ended by
+/// calls to sample(). The resolution is one pulse per window, so this suits
+/// fast pulse trains, or pulses counted in hardware (e.g. by ESP32's PCNT).
+///
+/// Example:
+///
+///   PulseCounter counter(roo_time::Uptime::Now());
+///   void IRAM_ATTR OnPulse() { counter.pulse(); }
+///   ...
+///   noInterrupts();
+///   PulseRate rate = counter.sample(roo_time::Uptime::Now());
+///   interrupts();
+///   VolumeFlowRate flow = rate.flowRate(450.0f);
+class PulseCounter {
+ public:
+  /// Creates the counter, with the first window starting at `start`.
+  explicit PulseCounter(roo_time::Uptime start = roo_time::Uptime::Start())
+      : start_(start), pulses_(0) {}
+
+  /// Records a pulse.
+  void pulse() { ++pulses_; }
+
+  /// Records the specified number of pulses, e.g. read from a hardware
+  /// counter.
+  void add(uint32_t pulses) { pulses_ += pulses; }
+
+  /// Returns the pulses counted since the start of the window, ending the
+  /// window at `now`, and starting the next one.
+  PulseRate sample(roo_time::Uptime now) {
+    PulseRate rate{pulses_, now - start_};
+    start_ = now;
+    pulses_ = 0;
+    return rate;
+  }
+
+  /// Discards the pulses counted so far, starting a new window at `now`.
+  void reset(roo_time::Uptime now) {
+    start_ = now;
+    pulses_ = 0;
+  }
+
+ private:
+  roo_time::Uptime start_;
+  uint32_t pulses_;
+};
+
+/// Measures the pulse rate from the timestamps of the pulses: the number of
+/// complete periods, between the first and the last pulse since the previous
+/// sample, over their time span. Unlike PulseCounter, accurate to the
+/// timestamp resolution (a microsecond) regardless of the rate, so this suits
+/// slow pulse trains, e.g. a flow meter at a trickle. Consecutive samples
+/// share their boundary pulse, so that no period is lost.
+///
+/// Timestamps are stored as 32-bit microseconds, so the time between samples
+/// must not exceed 71 minutes.
+class PulsePeriodMeter {
+ public:
+  constexpr PulsePeriodMeter() : first_(0), last_(0), pulses_(0) {}
+
+  /// Records a pulse, occurring at `now`.
+  void pulse(roo_time::Uptime now) {
+    uint32_t t = static_cast<uint32_t>(now.inMicros());
+    if (pulses_ == 0) first_ = t;
+    last_ = t;
+    ++pulses_;
+  }
+
+  /// Returns the complete periods since the previous sample, and starts the
+  /// next sample at the last pulse. If there are none (i.e. fewer than two
+  /// pulses), returns zero pulses over the time since the last pulse (or an
+  /// empty interval, if there have been no pulses at all), and keeps
+  /// accumulating.
+  PulseRate sample(roo_time::Uptime now) {
+    if (pulses_ < 2) {
+      uint32_t since = pulses_ == 0
+                           ? 0
+                           : static_cast<uint32_t>(now.inMicros()) - last_;
+      return PulseRate{0, roo_time::Micros(since)};
+    }
+    PulseRate rate{pulses_ - 1, roo_time::Micros(last_ - first_)};
+    first_ = last_;
+    pulses_ = 1;
+    return rate;
+  }
+
+  /// Discards all pulses.
+  void reset() { pulses_ = 0; }
+
+ private:
+  uint32_t first_;
+  uint32_t last_;
+  uint32_t pulses_;
+};
+
+}  // namespace roo_quantity
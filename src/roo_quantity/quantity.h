@@ -0,0 +1,356 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "roo_quantity/unknown.h"
+
+namespace roo_quantity {
+
+/// Physical dimension of a quantity, expressed as exponents of the base
+/// dimensions: length, mass, time, electric current, and temperature. For
+/// example, velocity is Dimension<1, 0, -1, 0, 0>.
+///
+/// Dimensions exist only at compile time. They determine which quantities can
+/// be added or compared, and the type of the result of multiplying or dividing
+/// quantities.
+template <int L, int M, int T, int I, int K>
+struct Dimension {
+  static constexpr int length = L;
+  static constexpr int mass = M;
+  static constexpr int time = T;
+  static constexpr int current = I;
+  static constexpr int temperature = K;
+};
+
+/// Dimension of plain numbers, e.g. of the ratio of two lengths.
+using Dimensionless = Dimension<0, 0, 0, 0, 0>;
+
+/// Dimension of the product of quantities of dimensions A and B.
+template <typename A, typename B>
+using DimensionProduct =
+    Dimension<A::length + B::length, A::mass + B::mass, A::time + B::time,
+              A::current + B::current, A::temperature + B::temperature>;
+
+/// Dimension of the quotient of quantities of dimensions A and B.
+template <typename A, typename B>
+using DimensionQuotient =
+    Dimension<A::length - B::length, A::mass - B::mass, A::time - B::time,
+              A::current - B::current, A::temperature - B::temperature>;
+
+/// Dimensions of the named quantity classes.
+namespace dimension {
+
+using Length = Dimension<1, 0, 0, 0, 0>;
+using Area = Dimension<2, 0, 0, 0, 0>;
+using Volume = Dimension<3, 0, 0, 0, 0>;
+using LineicNumber = Dimension<-1, 0, 0, 0, 0>;
+using AreicNumber = Dimension<-2, 0, 0, 0, 0>;
+using VolumicNumber = Dimension<-3, 0, 0, 0, 0>;
+using Mass = Dimension<0, 1, 0, 0, 0>;
+using Time = Dimension<0, 0, 1, 0, 0>;
+using Frequency = Dimension<0, 0, -1, 0, 0>;
+using Velocity = Dimension<1, 0, -1, 0, 0>;
+using VolumeFlowRate = Dimension<3, 0, -1, 0, 0>;
+using Force = Dimension<1, 1, -2, 0, 0>;
+using Pressure = Dimension<-1, 1, -2, 0, 0>;
+using Work = Dimension<2, 1, -2, 0, 0>;
+using Power = Dimension<2, 1, -3, 0, 0>;
+using Current = Dimension<0, 0, 0, 1, 0>;
+using Charge = Dimension<0, 0, 1, 1, 0>;
+using Voltage = Dimension<2, 1, -3, -1, 0>;
+using Resistance = Dimension<2, 1, -3, -2, 0>;
+using Capacitance = Dimension<-2, -1, 4, 2, 0>;
+using TemperatureDelta = Dimension<0, 0, 0, 0, 1>;
+
+}  // namespace dimension
+
+namespace internal {
+
+/// Common implementation of all quantity classes, parameterized by the
+/// concrete class (Derived), its dimension (D), and the arithmetic type used
+/// to store the value (R). The value is kept in the coherent SI unit of the
+/// dimension (e.g. meters, square meters, Newtons, Volts).
+///
+/// Provides comparisons, compound assignment, and arithmetic between
+/// quantities of the same type, and with scalars. Adds no state and no virtual
+/// functions, so that a quantity is exactly as large as its representation.
+template <typename Derived, typename D, typename R>
+class QuantityBase {
+ public:
+  using Dim = D;
+  using Rep = R;
+
+  /// Returns a quantity with the specified value, expressed in the coherent SI
+  /// unit of its dimension.
+  static constexpr Derived FromSiUnits(Rep value) {
+    Derived result;
+    static_cast<QuantityBase&>(result).value_ = value;
+    return result;
+  }
+
+  /// Returns the value, expressed in the coherent SI unit of the dimension.
+  constexpr Rep inSiUnits() const { return value_; }
+
+  /// Returns whether the object represents an unknown quantity.
+  // (Self-comparison, since std::isnan is not constexpr before C++23.)
+  constexpr bool isUnknown() const { return value_ != value_; }
+
+  constexpr Derived& operator+=(const Derived& other) {
+    value_ += other.inSiUnits();
+    return static_cast<Derived&>(*this);
+  }
+
+  constexpr Derived& operator-=(const Derived& other) {
+    value_ -= other.inSiUnits();
+    return static_cast<Derived&>(*this);
+  }
+
+  constexpr Derived& operator*=(Rep multi) {
+    value_ *= multi;
+    return static_cast<Derived&>(*this);
+  }
+
+  constexpr Derived& operator/=(Rep div) {
+    value_ /= div;
+    return static_cast<Derived&>(*this);
+  }
+
+  // Defined as friends, rather than as members or free templates, so that
+  // they accept arguments implicitly convertible to Derived on either side
+  // (e.g. roo_time::Duration to Time, or Length to DoubleLength).
+
+  friend constexpr bool operator<(Derived a, Derived b) {
+    return a.inSiUnits() < b.inSiUnits();
+  }
+
+  friend constexpr bool operator==(Derived a, Derived b) {
+    return a.inSiUnits() == b.inSiUnits();
+  }
+
+  friend constexpr bool operator>(Derived a, Derived b) {
+    return b.inSiUnits() < a.inSiUnits();
+  }
+
+  friend constexpr bool operator<=(Derived a, Derived b) {
+    return !(b.inSiUnits() < a.inSiUnits());
+  }
+
+  friend constexpr bool operator>=(Derived a, Derived b) {
+    return !(a.inSiUnits() < b.inSiUnits());
+  }
+
+  friend constexpr bool operator!=(Derived a, Derived b) {
+    return !(a.inSiUnits() == b.inSiUnits());
+  }
+
+  friend constexpr Derived operator+(Derived a, Derived b) {
+    return FromSiUnits(a.inSiUnits() + b.inSiUnits());
+  }
+
+  friend constexpr Derived operator-(Derived a, Derived b) {
+    return FromSiUnits(a.inSiUnits() - b.inSiUnits());
+  }
+
+  friend constexpr Derived operator-(Derived a) {
+    return FromSiUnits(-a.inSiUnits());
+  }
+
+  friend constexpr Derived operator*(Derived a, Rep b) {
+    return FromSiUnits(a.inSiUnits() * b);
+  }
+
+  friend constexpr Derived operator*(Rep a, Derived b) {
+    return FromSiUnits(a * b.inSiUnits());
+  }
+
+  friend constexpr Derived operator/(Derived a, Rep b) {
+    return FromSiUnits(a.inSiUnits() / b);
+  }
+
+  friend constexpr Rep operator/(Derived a, Derived b) {
+    return a.inSiUnits() / b.inSiUnits();
+  }
+
+ protected:
+  constexpr QuantityBase() : value_(std::numeric_limits<Rep>::quiet_NaN()) {}
+
+  explicit constexpr QuantityBase(Rep value) : value_(value) {}
+
+  Rep value_;
+};
+
+template <typename Q, typename = void>
+struct IsQuantity : std::false_type {};
+
+template <typename Q>
+struct IsQuantity<Q, std::void_t<typename Q::Dim, typename Q::Rep>>
+    : std::is_base_of<QuantityBase<Q, typename Q::Dim, typename Q::Rep>, Q> {
+};
+
+}  // namespace internal
+
+/// Quantity of an arbitrary dimension, for which there is no named class (e.g.
+/// the product of force and current). Supports the same arithmetic as the
+/// named classes, but no unit accessors or formatting.
+template <typename D, typename R>
+class GenericQuantity
+    : public internal::QuantityBase<GenericQuantity<D, R>, D, R> {
+ public:
+  /// Creates an object representing an 'unknown' quantity.
+  constexpr GenericQuantity() = default;
+};
+
+class Area;
+class AreicNumber;
+class Capacitance;
+class Charge;
+class Current;
+class DoubleCharge;
+class DoubleLength;
+class DoubleTime;
+class DoubleWork;
+class Force;
+class Frequency;
+class Length;
+class LineicNumber;
+class Mass;
+class Power;
+class Pressure;
+class Resistance;
+class TemperatureDelta;
+class Time;
+class Velocity;
+class Voltage;
+class Volume;
+class VolumeFlowRate;
+class VolumicNumber;
+class Work;
+
+namespace internal {
+
+/// Maps a dimension and representation to the class representing it. All
+/// mappings are declared here, so that the result type of an operator does not
+/// depend on which headers happen to be included.
+template <typename D, typename R>
+struct QuantityFor {
+  using type = GenericQuantity<D, R>;
+};
+
+template <typename R>
+struct QuantityFor<Dimensionless, R> {
+  using type = R;
+};
+
+#define ROO_QUANTITY_NAMED(dim, rep, name) \
+  template <>                              \
+  struct QuantityFor<dimension::dim, rep> { \
+    using type = ::roo_quantity::name;     \
+  }
+
+ROO_QUANTITY_NAMED(Area, float, Area);
+ROO_QUANTITY_NAMED(AreicNumber, float, AreicNumber);
+ROO_QUANTITY_NAMED(Capacitance, float, Capacitance);
+ROO_QUANTITY_NAMED(Charge, float, Charge);
+ROO_QUANTITY_NAMED(Current, float, Current);
+ROO_QUANTITY_NAMED(Force, float, Force);
+ROO_QUANTITY_NAMED(Frequency, float, Frequency);
+ROO_QUANTITY_NAMED(Length, float, Length);
+ROO_QUANTITY_NAMED(LineicNumber, float, LineicNumber);
+ROO_QUANTITY_NAMED(Mass, float, Mass);
+ROO_QUANTITY_NAMED(Power, float, Power);
+ROO_QUANTITY_NAMED(Pressure, float, Pressure);
+ROO_QUANTITY_NAMED(Resistance, float, Resistance);
+ROO_QUANTITY_NAMED(TemperatureDelta, float, TemperatureDelta);
+ROO_QUANTITY_NAMED(Time, float, Time);
+ROO_QUANTITY_NAMED(Velocity, float, Velocity);
+ROO_QUANTITY_NAMED(Voltage, float, Voltage);
+ROO_QUANTITY_NAMED(Volume, float, Volume);
+ROO_QUANTITY_NAMED(VolumeFlowRate, float, VolumeFlowRate);
+ROO_QUANTITY_NAMED(VolumicNumber, float, VolumicNumber);
+ROO_QUANTITY_NAMED(Work, float, Work);
+
+ROO_QUANTITY_NAMED(Charge, double, DoubleCharge);
+ROO_QUANTITY_NAMED(Length, double, DoubleLength);
+ROO_QUANTITY_NAMED(Time, double, DoubleTime);
+ROO_QUANTITY_NAMED(Work, double, DoubleWork);
+
+#undef ROO_QUANTITY_NAMED
+
+// Constructs the result of a product or quotient from its value in SI units.
+// Dimensionless results are returned as plain numbers.
+template <typename Q, bool = std::is_arithmetic<Q>::value>
+struct MakeQuantity {
+  static constexpr Q make(typename Q::Rep value) {
+    return Q::FromSiUnits(value);
+  }
+};
+
+template <typename Q>
+struct MakeQuantity<Q, true> {
+  static constexpr Q make(Q value) { return value; }
+};
+
+template <typename Q1, typename Q2>
+using EnableIfQuantities =
+    std::enable_if_t<IsQuantity<Q1>::value && IsQuantity<Q2>::value>;
+
+// Representation of the result of arithmetic on quantities of representations
+// R1 and R2; e.g. double for float and double.
+template <typename R1, typename R2>
+using CommonRep = decltype(R1() * R2());
+
+}  // namespace internal
+
+/// The class representing quantities of dimension D, stored as R. For named
+/// dimensions with float representation, this is the named class, e.g.
+/// Quantity<dimension::Force> is Force. Otherwise, it is GenericQuantity<D, R>.
+/// For Dimensionless, it is R itself.
+template <typename D, typename R = float>
+using Quantity = typename internal::QuantityFor<D, R>::type;
+
+/// Multiplies quantities of arbitrary dimensions. For example, Pressure * Area
+/// is Force, and Voltage * Current is Power. The result type is always
+/// available, but it must be a complete type at the point of use; i.e. the
+/// header of the resulting named class (or roo_quantity.h) must be included.
+/// If either operand is double-precision, so is the result; e.g. DoubleTime *
+/// Current is DoubleCharge.
+template <typename Q1, typename Q2,
+          typename = internal::EnableIfQuantities<Q1, Q2>>
+constexpr Quantity<
+    DimensionProduct<typename Q1::Dim, typename Q2::Dim>,
+    internal::CommonRep<typename Q1::Rep, typename Q2::Rep>>
+operator*(Q1 a, Q2 b) {
+  using Rep = internal::CommonRep<typename Q1::Rep, typename Q2::Rep>;
+  return internal::MakeQuantity<
+      Quantity<DimensionProduct<typename Q1::Dim, typename Q2::Dim>, Rep>>::
+      make(static_cast<Rep>(a.inSiUnits()) * static_cast<Rep>(b.inSiUnits()));
+}
+
+/// Divides quantities of arbitrary dimensions. For example, Power / Velocity
+/// is Force.
+template <typename Q1, typename Q2,
+          typename = internal::EnableIfQuantities<Q1, Q2>>
+constexpr Quantity<
+    DimensionQuotient<typename Q1::Dim, typename Q2::Dim>,
+    internal::CommonRep<typename Q1::Rep, typename Q2::Rep>>
+operator/(Q1 a, Q2 b) {
+  using Rep = internal::CommonRep<typename Q1::Rep, typename Q2::Rep>;
+  return internal::MakeQuantity<
+      Quantity<DimensionQuotient<typename Q1::Dim, typename Q2::Dim>, Rep>>::
+      make(static_cast<Rep>(a.inSiUnits()) / static_cast<Rep>(b.inSiUnits()));
+}
+
+/// Divides a scalar by a quantity. For example, 1 / Time is Frequency.
+template <typename Q,
+          typename = std::enable_if_t<internal::IsQuantity<Q>::value>>
+constexpr Quantity<DimensionQuotient<Dimensionless, typename Q::Dim>,
+                   typename Q::Rep>
+operator/(typename Q::Rep a, Q b) {
+  return internal::MakeQuantity<
+      Quantity<DimensionQuotient<Dimensionless, typename Q::Dim>,
+               typename Q::Rep>>::make(a / b.inSiUnits());
+}
+
+}  // namespace roo_quantity
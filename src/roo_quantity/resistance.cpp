@@ -1,22 +1,18 @@
 #include "roo_quantity/resistance.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void ResistanceToString(const Resistance& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inOhms(), "Ω", out, maxlen);
+size_t Resistance::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inOhms(), "Ω", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Resistance::asString() const {
-  char out[16];
-  ResistanceToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,14 @@ std::string Resistance::asString() const {
 #if defined(ARDUINO)
 
 String Resistance::asArduinoString() const {
-  char out[16];
-  ResistanceToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const Resistance& val) {
-  char out[16];
-  ResistanceToString(val, out, 16);
-  os << out;
-  return os;
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const Resistance& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+#include "roo_quantity/span.h"
+#include "roo_time.h"
+
+namespace roo_quantity {
+
+/// Summary of the samples of a quantity within a time interval (a bucket of
+/// RollupHistory). If the bucket has no known samples, the count is zero, and
+/// the statistics are unknown.
+template <typename Q>
+struct Rollup {
+  /// The start of the interval.
+  roo_time::Uptime start;
+
+  Q min;
+  Q max;
+  Q mean;
+
+  /// The number of known samples.
+  uint32_t count;
+};
+
+namespace internal {
+
+/// The mergeable state of a rollup bucket: 16 bytes.
+struct RollupBucket {
+  float min;
+  float max;
+  float sum;
+  uint32_t count;
+
+  void clear() { count = 0; }
+
+  void add(float x) {
+    if (count == 0) {
+      min = x;
+      max = x;
+      sum = x;
+    } else {
+      if (x < min) min = x;
+      if (x > max) max = x;
+      sum += x;
+    }
+    ++count;
+  }
+
+  void merge(const RollupBucket& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+      *this = other;
+      return;
+    }
+    if (other.min < min) min = other.min;
+    if (other.max > max) max = other.max;
+    sum += other.sum;
+    count += other.count;
+  }
+};
+
+}  // namespace internal
+
+/// Fixed-memory history of a quantity at multiple resolutions, e.g. for
+/// dashboards showing the last minute, hour, and day of a sensor. Keeps
+/// kLevels rings of kCapacity buckets each, summarizing the samples (min,
+/// max, mean, count) over consecutive intervals of the level's resolution.
+///
+/// Samples are added to the finest level only. When a bucket is complete, it
+/// is merged (cascaded) into the enclosing bucket of the next level, so that
+/// adding a sample takes O(1) amortized time, regardless of the number of
+/// levels. Buckets are aligned to multiples of their resolution, since
+/// Uptime::Start(), and each resolution must be a multiple of the previous
+/// one. Each bucket takes 16 bytes, so that, e.g., RollupHistory<Temperature,
+/// 3, 60> takes under 3 KB, for 60 seconds, 60 minutes, and 60 hours of
+/// history.
+///
+/// Unknown samples are skipped. Timestamps must be non-decreasing; a sample
+/// older than the current bucket is added to the current bucket.
+///
+/// Example:
+///
+///   RollupHistory<Temperature, 3, 60> history(
+///       {roo_time::Seconds(1), roo_time::Minutes(1), roo_time::Hours(1)});
+///   ...
+///   history.add(roo_time::Uptime::Now(), sensor.read());
+///   ...
+///   Rollup<Temperature> hourly[24];
+///   size_t n = history.query(2, now - roo_time::Hours(24), now, hourly, 24);
+template <typename Q, size_t kLevels, size_t kCapacity>
+class RollupHistory {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  static_assert(std::is_same<Rep, float>::value,
+                "RollupHistory supports single-precision quantities only");
+  static_assert(kLevels >= 1, "RollupHistory needs at least one level");
+  static_assert(kCapacity >= 1, "RollupHistory needs at least one bucket");
+
+  /// Creates the history with the specified bucket resolutions, from the
+  /// finest to the coarsest.
+  explicit RollupHistory(const roo_time::Duration (&resolutions)[kLevels])
+      : newest_(), first_(), empty_(true) {
+    for (size_t i = 0; i < kLevels; ++i) {
+      resolution_[i] = resolutions[i].inMicros();
+    }
+  }
+
+  /// Adds the sample taken at time `t`.
+  void add(roo_time::Uptime t, const Q& q) {
+    int64_t index = t.inMicros() / resolution_[0];
+    if (empty_) {
+      start(index);
+    } else {
+      advance(0, index);
+    }
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    if (x == x) bucket(0, newest_[0]).add(x);
+  }
+
+  /// Writes the buckets of the specified level that overlap [from, to) and
+  /// are still retained, oldest first, to `out`, up to `max_count` of them.
+  /// Returns the number of buckets written. Buckets without samples are
+  /// included, with a zero count. The newest bucket of each level includes
+  /// the samples not yet cascaded from the finer levels.
+  size_t query(size_t level, roo_time::Uptime from, roo_time::Uptime to,
+               Rollup<Q>* out, size_t max_count) const {
+    int64_t first;
+    int64_t last;
+    if (!range(level, from, to, first, last)) return 0;
+    size_t n = 0;
+    for (int64_t i = first; i <= last && n < max_count; ++i) {
+      out[n++] = ToRollup(i * resolution_[level], collect(level, i));
+    }
+    return n;
+  }
+
+  /// Returns the summary of the samples in [from, to), from the finest level
+  /// still retaining `from`, or the coarsest one, if none does. Since whole
+  /// buckets are summarized, the range is effectively extended to bucket
+  /// boundaries at that level.
+  Rollup<Q> summary(roo_time::Uptime from, roo_time::Uptime to) const {
+    internal::RollupBucket result;
+    result.clear();
+    size_t level = 0;
+    // Buckets before the first one have no samples; those after it may have
+    // been dropped.
+    while (level + 1 < kLevels && !empty_ &&
+           from.inMicros() / resolution_[level] < oldest(level) &&
+           oldest(level) > first_[level]) {
+      ++level;
+    }
+    int64_t first;
+    int64_t last;
+    if (range(level, from, to, first, last)) {
+      for (int64_t i = first; i <= last; ++i) {
+        result.merge(collect(level, i));
+      }
+    }
+    return ToRollup(from.inMicros(), result);
+  }
+
+  /// Returns the resolution of the specified level.
+  roo_time::Duration resolution(size_t level) const {
+    return roo_time::Micros(resolution_[level]);
+  }
+
+  /// Forgets all samples.
+  void clear() { empty_ = true; }
+
+ private:
+  internal::RollupBucket& bucket(size_t level, int64_t index) {
+    return buckets_[level][static_cast<size_t>(index) % kCapacity];
+  }
+
+  const internal::RollupBucket& bucket(size_t level, int64_t index) const {
+    return buckets_[level][static_cast<size_t>(index) % kCapacity];
+  }
+
+  // Starts the history with the bucket of the specified finest-level index.
+  void start(int64_t index) {
+    int64_t micros = index * resolution_[0];
+    for (size_t level = 0; level < kLevels; ++level) {
+      newest_[level] = micros / resolution_[level];
+      first_[level] = newest_[level];
+      for (size_t i = 0; i < kCapacity; ++i) buckets_[level][i].clear();
+    }
+    empty_ = false;
+  }
+
+  // Makes the bucket with the specified index the newest one of the level,
+  // cascading the completed one into the newest bucket of the next level
+  // (which encloses it), advancing that level too, and clearing the skipped
+  // buckets.
+  void advance(size_t level, int64_t index) {
+    int64_t newest = newest_[level];
+    if (index <= newest) return;
+    if (level + 1 < kLevels) {
+      bucket(level + 1, newest_[level + 1]).merge(bucket(level, newest));
+      advance(level + 1, index * resolution_[level] / resolution_[level + 1]);
+    }
+    int64_t skipped = index - newest;
+    if (skipped > static_cast<int64_t>(kCapacity)) {
+      skipped = static_cast<int64_t>(kCapacity);
+    }
+    for (int64_t i = index - skipped + 1; i <= index; ++i) {
+      bucket(level, i).clear();
+    }
+    newest_[level] = index;
+  }
+
+  // Returns the index of the oldest retained bucket of the level (but not
+  // older than the start of the history).
+  int64_t oldest(size_t level) const {
+    int64_t oldest = newest_[level] - static_cast<int64_t>(kCapacity) + 1;
+    return oldest > first_[level] ? oldest : first_[level];
+  }
+
+  // Finds the indices of the retained buckets of the level overlapping
+  // [from, to). Returns false if there are none.
+  bool range(size_t level, roo_time::Uptime from, roo_time::Uptime to,
+             int64_t& first, int64_t& last) const {
+    if (empty_ || !(from < to)) return false;
+    first = from.inMicros() / resolution_[level];
+    last = (to.inMicros() - 1) / resolution_[level];
+    if (first < oldest(level)) first = oldest(level);
+    if (last > newest_[level]) last = newest_[level];
+    return first <= last;
+  }
+
+  // Returns the contents of the specified retained bucket. For the newest
+  // bucket of a level, includes the newest buckets of the finer levels, which
+  // have not been cascaded yet.
+  internal::RollupBucket collect(size_t level, int64_t index) const {
+    internal::RollupBucket result = bucket(level, index);
+    if (index == newest_[level]) {
+      for (size_t finer = level; finer-- > 0;) {
+        result.merge(bucket(finer, newest_[finer]));
+      }
+    }
+    return result;
+  }
+
+  static Rollup<Q> ToRollup(int64_t start_micros,
+                            const internal::RollupBucket& b) {
+    Rollup<Q> rollup;
+    rollup.start = roo_time::Uptime::Start() + roo_time::Micros(start_micros);
+    rollup.count = b.count;
+    if (b.count != 0) {
+      rollup.min = internal::RawTraits<Q>::FromRaw(b.min);
+      rollup.max = internal::RawTraits<Q>::FromRaw(b.max);
+      rollup.mean = internal::RawTraits<Q>::FromRaw(
+          b.sum / static_cast<float>(b.count));
+    }
+    return rollup;
+  }
+
+  internal::RollupBucket buckets_[kLevels][kCapacity];
+  int64_t resolution_[kLevels];
+  int64_t newest_[kLevels];
+  int64_t first_[kLevels];
+  bool empty_;
+};
+
+}  // namespace roo_quantity
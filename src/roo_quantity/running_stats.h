@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <limits>
+
+#include "roo_quantity/span.h"
+#include "roo_quantity/statistics.h"
+
+namespace roo_quantity {
+
+/// Streaming aggregator of count, mean, variance, min and max of a sequence
+/// of quantities, in constant memory. Uses Welford's algorithm, which, unlike
+/// accumulating sums of squares, does not lose precision when the mean is
+/// large relative to the spread. The running mean and sum of squared
+/// deviations are additionally compensated (as in Kahan summation), so that
+/// the results stay accurate over millions of float values. Unknown values are
+/// ignored.
+///
+/// Aggregators of disjoint sequences (e.g. filled by different threads, or
+/// covering consecutive time windows) can be combined with merge().
+///
+/// Q can be any quantity class, including Temperature, in which case mean(),
+/// min() and max() are Temperatures, and stddev() is a TemperatureDelta. The
+/// arithmetic is done in the representation of Q (float for all the
+/// single-precision classes, double for DoubleLength etc).
+///
+/// Example:
+///
+///   RunningStats<Temperature> stats;
+///   stats.add(TemperatureDegCelcius(21.5f));
+///   ...
+///   LOG(INFO) << stats.mean() << " +/- " << stats.stddev();
+template <typename Q>
+class RunningStats {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+  using Delta = typename internal::DeltaOf<Q>::type;
+  using Variance = internal::VarianceType<Q>;
+
+  /// Creates an empty aggregator.
+  constexpr RunningStats()
+      : count_(0),
+        mean_(0),
+        mean_compensation_(0),
+        m2_(0),
+        m2_compensation_(0),
+        min_(std::numeric_limits<Rep>::infinity()),
+        max_(-std::numeric_limits<Rep>::infinity()) {}
+
+  /// Adds a value. Unknown values are ignored.
+  void add(const Q& q) {
+    Rep x = internal::RawTraits<Q>::ToRaw(q);
+    if (x != x) return;
+    ++count_;
+    Rep delta = x - mean_;
+    CompensatedAdd(mean_, mean_compensation_,
+                   delta / static_cast<Rep>(count_));
+    CompensatedAdd(m2_, m2_compensation_, delta * (x - mean_));
+    if (x < min_) min_ = x;
+    if (x > max_) max_ = x;
+  }
+
+  /// Adds all values from the span.
+  void addAll(QuantitySpan<const Q> span) {
+    for (size_t i = 0; i < span.size(); ++i) add(span[i]);
+  }
+
+  /// Combines the statistics of `other` into this aggregator, as if all of
+  /// its values had been added here.
+  void merge(const RunningStats& other) {
+    if (other.count_ == 0) return;
+    if (count_ == 0) {
+      *this = other;
+      return;
+    }
+    size_t count = count_ + other.count_;
+    Rep delta = (other.mean_ - mean_) -
+                (other.mean_compensation_ - mean_compensation_);
+    Rep weight = static_cast<Rep>(other.count_) / static_cast<Rep>(count);
+    CompensatedAdd(mean_, mean_compensation_, delta * weight);
+    CompensatedAdd(m2_, m2_compensation_,
+                   other.m2_ - other.m2_compensation_);
+    CompensatedAdd(m2_, m2_compensation_,
+                   delta * delta * static_cast<Rep>(count_) * weight);
+    count_ = count;
+    if (other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+  }
+
+  /// Removes all values.
+  void reset() { *this = RunningStats(); }
+
+  /// Returns the number of (known) values added.
+  size_t count() const { return count_; }
+
+  /// Returns the mean, or unknown if no values have been added.
+  Q mean() const {
+    return count_ == 0 ? Q() : FromRaw(mean_ - mean_compensation_);
+  }
+
+  /// Returns the smallest value, or unknown if no values have been added.
+  Q min() const { return count_ == 0 ? Q() : FromRaw(min_); }
+
+  /// Returns the largest value, or unknown if no values have been added.
+  Q max() const { return count_ == 0 ? Q() : FromRaw(max_); }
+
+  /// Returns the sample variance (with Bessel's correction), or unknown if
+  /// fewer than two values have been added.
+  Variance variance() const {
+    if (count_ < 2) return Variance();
+    return Variance::FromSiUnits((m2_ - m2_compensation_) /
+                                 static_cast<Rep>(count_ - 1));
+  }
+
+  /// Returns the population variance, or unknown if no values have been
+  /// added.
+  Variance populationVariance() const {
+    if (count_ == 0) return Variance();
+    return Variance::FromSiUnits((m2_ - m2_compensation_) /
+                                 static_cast<Rep>(count_));
+  }
+
+  /// Returns the sample standard deviation, or unknown if fewer than two
+  /// values have been added.
+  Delta stddev() const {
+    return Delta::FromSiUnits(std::sqrt(variance().inSiUnits()));
+  }
+
+ private:
+  static Q FromRaw(Rep raw) { return internal::RawTraits<Q>::FromRaw(raw); }
+
+  // Adds x to sum, carrying the rounding error in compensation. (Relies on
+  // strict IEEE semantics; must not be compiled with -ffast-math.)
+  static void CompensatedAdd(Rep& sum, Rep& compensation, Rep x) {
+    Rep y = x - compensation;
+    Rep t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+  }
+
+  size_t count_;
+  Rep mean_;
+  Rep mean_compensation_;
+  Rep m2_;
+  Rep m2_compensation_;
+  Rep min_;
+  Rep max_;
+};
+
+}  // namespace roo_quantity
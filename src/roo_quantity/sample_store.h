@@ -0,0 +1,206 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "roo_quantity/span.h"
+#include "roo_time.h"
+
+namespace roo_quantity {
+
+/// A quantity with the time it was sampled at, stored compactly as a 32-bit
+/// microsecond offset from a base time (such as the start of a block of
+/// samples), which the user keeps separately. Spans up to about 71 minutes
+/// from the base. For single-precision quantities, takes 8 bytes, rather than
+/// 16 for a roo_time::Uptime and a padded quantity.
+template <typename Q>
+struct Sample {
+  /// Creates a sample with unknown value, at the base time.
+  constexpr Sample() : offset(0), value() {}
+
+  /// Creates a sample of the value at `time`, which must not be earlier than
+  /// `base`, nor later by more than 2^32 microseconds.
+  Sample(roo_time::Uptime base, roo_time::Uptime time, const Q& q)
+      : offset(static_cast<uint32_t>((time - base).inMicros())), value(q) {}
+
+  /// Returns the time of the sample, given the base time.
+  roo_time::Uptime time(roo_time::Uptime base) const {
+    return base + roo_time::Micros(offset);
+  }
+
+  /// Microseconds since the base time.
+  uint32_t offset;
+
+  Q value;
+};
+
+/// Fixed-memory store of the most recent timestamped samples of a quantity,
+/// organized in kBlocks blocks of up to kBlockSize samples. Each block stores
+/// a 64-bit base time, and the samples in two columns: 32-bit time offsets
+/// from the base (as in Sample), and the raw values. For single-precision
+/// quantities and large blocks, this takes about 8 bytes per sample, and lets
+/// range queries search the timestamps, and scan the values (e.g. with Mean()
+/// or Max()) as contiguous spans. When the store is full, appending a sample
+/// drops the oldest block.
+///
+/// A new block is started when the current one is full, or when the offset
+/// of a sample from the base would not fit in 32 bits (after about 71
+/// minutes). Timestamps must be non-decreasing.
+///
+/// Example:
+///
+///   SampleStore<Voltage, 256, 16> store;
+///   ...
+///   store.append(roo_time::Uptime::Now(), adc.read());
+///   ...
+///   Voltage peak = VoltageInVolts(0.0f);
+///   store.forEachRun(from, to, [&](QuantitySpan<const Voltage> run) {
+///     peak = std::max(peak, Max(run));
+///   });
+template <typename Q, size_t kBlockSize, size_t kBlocks>
+class SampleStore {
+ public:
+  using Rep = typename internal::RawTraits<Q>::Rep;
+
+  static_assert(kBlockSize >= 1, "Blocks must hold at least one sample");
+  static_assert(kBlocks >= 1, "The store needs at least one block");
+
+  SampleStore() : head_(0), blocks_used_(0) {}
+
+  /// Appends the sample taken at time `t`. Returns false, without storing
+  /// the sample, if `t` is earlier than the newest stored sample.
+  bool append(roo_time::Uptime t, const Q& q) {
+    int64_t micros = t.inMicros();
+    if (blocks_used_ == 0) {
+      startBlock(micros);
+    } else {
+      const Block& current = block(blocks_used_ - 1);
+      int64_t offset = micros - current.base;
+      int64_t last = current.base + current.offsets[current.count - 1];
+      if (micros < last) return false;
+      if (current.count == kBlockSize || offset > int64_t{0xFFFFFFFF}) {
+        startBlock(micros);
+      }
+    }
+    Block& current = block(blocks_used_ - 1);
+    current.offsets[current.count] =
+        static_cast<uint32_t>(micros - current.base);
+    current.values[current.count] = internal::RawTraits<Q>::ToRaw(q);
+    ++current.count;
+    return true;
+  }
+
+  /// Returns the number of stored samples.
+  size_t size() const {
+    size_t result = 0;
+    for (size_t i = 0; i < blocks_used_; ++i) result += block(i).count;
+    return result;
+  }
+
+  /// Returns whether the store is empty.
+  bool empty() const { return blocks_used_ == 0; }
+
+  /// Calls fn(time, value) for each stored sample with time in [from, to),
+  /// oldest first.
+  template <typename Fn>
+  void forEach(roo_time::Uptime from, roo_time::Uptime to, Fn&& fn) const {
+    forEachRange(from, to, [&fn](const Block& b, size_t begin, size_t end) {
+      roo_time::Uptime base =
+          roo_time::Uptime::Start() + roo_time::Micros(b.base);
+      for (size_t i = begin; i < end; ++i) {
+        fn(base + roo_time::Micros(b.offsets[i]),
+           internal::RawTraits<Q>::FromRaw(b.values[i]));
+      }
+    });
+  }
+
+  /// Calls fn(run) with the values of the stored samples with time in
+  /// [from, to), oldest first, as spans of consecutive values (one per
+  /// block).
+  template <typename Fn>
+  void forEachRun(roo_time::Uptime from, roo_time::Uptime to, Fn&& fn) const {
+    forEachRange(from, to, [&fn](const Block& b, size_t begin, size_t end) {
+      fn(QuantitySpan<const Q>(b.values + begin, end - begin));
+    });
+  }
+
+  /// Copies the samples with time in [from, to), oldest first, up to
+  /// `max_count` of them, to `out`, with offsets relative to `from`. The range
+  /// must not exceed 2^32 microseconds. Returns the number of samples copied.
+  size_t query(roo_time::Uptime from, roo_time::Uptime to, Sample<Q>* out,
+               size_t max_count) const {
+    size_t n = 0;
+    forEach(from, to, [&](roo_time::Uptime t, const Q& value) {
+      if (n < max_count) out[n++] = Sample<Q>(from, t, value);
+    });
+    return n;
+  }
+
+  /// Removes all samples.
+  void clear() {
+    head_ = 0;
+    blocks_used_ = 0;
+  }
+
+ private:
+  struct Block {
+    int64_t base;
+    uint32_t count;
+    uint32_t offsets[kBlockSize];
+    Rep values[kBlockSize];
+  };
+
+  // Returns the i-th oldest block in use.
+  Block& block(size_t i) { return blocks_[(head_ + i) % kBlocks]; }
+  const Block& block(size_t i) const { return blocks_[(head_ + i) % kBlocks]; }
+
+  void startBlock(int64_t base) {
+    if (blocks_used_ == kBlocks) {
+      head_ = (head_ + 1) % kBlocks;
+      --blocks_used_;
+    }
+    Block& b = block(blocks_used_++);
+    b.base = base;
+    b.count = 0;
+  }
+
+  // Index of the first sample of the block not earlier than `micros`.
+  static size_t LowerBound(const Block& b, int64_t micros) {
+    int64_t offset = micros - b.base;
+    if (offset <= 0) return 0;
+    size_t lo = 0;
+    size_t hi = b.count;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (static_cast<int64_t>(b.offsets[mid]) < offset) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  // Calls fn(block, begin, end) for the non-empty index ranges of the blocks
+  // with samples in [from, to), oldest first.
+  template <typename Fn>
+  void forEachRange(roo_time::Uptime from, roo_time::Uptime to,
+                    Fn&& fn) const {
+    int64_t lo = from.inMicros();
+    int64_t hi = to.inMicros();
+    for (size_t i = 0; i < blocks_used_; ++i) {
+      const Block& b = block(i);
+      if (b.base >= hi) break;
+      if (b.base + b.offsets[b.count - 1] < lo) continue;
+      size_t begin = LowerBound(b, lo);
+      size_t end = LowerBound(b, hi);
+      if (begin < end) fn(b, begin, end);
+    }
+  }
+
+  Block blocks_[kBlocks];
+  size_t head_;
+  size_t blocks_used_;
+};
+
+}  // namespace roo_quantity
@@ -1,61 +1,93 @@
 #include "roo_quantity/si.h"
 
 #include <cmath>
-#include <cstdio>
+#include <limits>
+
+#include "roo_quantity/format.h"
 
 namespace roo_quantity {
+namespace {
 
-void FormatSimpleSiValue(float val, const char* base_unit, char* out,
-                         int maxlen) {
-  if (isnanf(val)) {
-    snprintf(out, maxlen, "? %s", base_unit);
-    return;
-  }
-  if (val == 0.0f) {
-    snprintf(out, maxlen, "0 %s", base_unit);
-    return;
-  }
-  const char* prefix;
-  const char* sign = "";
-  if (val < 0.0f) {
-    sign = "-";
-    val = -val;
-  }
-  if (std::isinf(val)) {
-    snprintf(out, maxlen, "%s∞ %s", sign, base_unit);
-    return;
+struct SiPrefix {
+  // Smallest magnitude that is formatted using this prefix.
+  float threshold;
+  int exp10;
+  const char* symbol;
+};
+
+const SiPrefix kSiPrefixes[] = {
+    {1000000000000000.0f, 15, "P"}, {1000000000000.0f, 12, "T"},
+    {1000000000.0f, 9, "G"},        {1000000.0f, 6, "M"},
+    {1000.0f, 3, "k"},              {1.0f, 0, ""},
+    {0.001f, -3, "m"},              {0.000001f, -6, "µ"},
+    {0.000000001f, -9, "n"},        {0.0f, -12, "p"},
+};
+
+constexpr size_t kSiPrefixCount = sizeof(kSiPrefixes) / sizeof(kSiPrefixes[0]);
+
+// Returns the prefix to use for values whose leading digit has the specified
+// decimal exponent. Uses integer arithmetic only.
+const SiPrefix* PrefixForExp10(int exp10) {
+  size_t i = 0;
+  while (i + 1 < kSiPrefixCount && exp10 < kSiPrefixes[i].exp10) ++i;
+  return &kSiPrefixes[i];
+}
+
+}  // namespace
+
+size_t FormatSimpleSiValue(float val, const char* base_unit, char* out,
+                           size_t maxlen) {
+  internal::StringWriter writer(out, maxlen);
+  if (std::isnan(val)) {
+    writer.append("? ");
+  } else if (val == 0.0f) {
+    writer.append("0 ");
+  } else {
+    if (val < 0.0f) {
+      writer.append('-');
+      val = -val;
+    }
+    if (std::isinf(val)) {
+      writer.append("∞ ");
+    } else {
+      const SiPrefix* prefix = kSiPrefixes;
+      while (val < prefix->threshold) ++prefix;
+      char digits[internal::kMaxDecimal6Length];
+      size_t len = internal::WriteDecimal6(internal::ToDecimal6(val),
+                                           prefix->exp10, digits);
+      writer.append(digits, len);
+      writer.append(' ');
+      writer.append(prefix->symbol);
+    }
   }
-  if (val >= 1000000000000000.0f) {
-    prefix = "P";
-    val *= 0.000000000000001;
-  } else if (val >= 1000000000000.0f) {
-    prefix = "T";
-    val *= 0.000000000001;
-  } else if (val >= 1000000000.0f) {
-    prefix = "G";
-    val *= 0.000000001;
-  } else if (val >= 1000000.0f) {
-    prefix = "M";
-    val *= 0.000001;
-  } else if (val >= 1000.0f) {
-    prefix = "k";
-    val *= 0.001;
-  } else if (val >= 1.0f) {
-    prefix = "";
-  } else if (val >= 0.001f) {
-    prefix = "m";
-    val *= 1000.0f;
-  } else if (val >= 0.000001f) {
-    prefix = "µ";
-    val *= 1000000.0f;
-  } else if (val >= 0.000000001f) {
-    prefix = "n";
-    val *= 1000000000.0f;
+  writer.append(base_unit);
+  return writer.finish();
+}
+
+size_t FormatFixedSiValue(int64_t count, int exp10, const char* base_unit,
+                          char* out, size_t maxlen) {
+  internal::StringWriter writer(out, maxlen);
+  if (count == std::numeric_limits<int64_t>::min()) {
+    writer.append("? ");
+  } else if (count == 0) {
+    writer.append("0 ");
   } else {
-    prefix = "p";
-    val *= 1000000000000.0f;
+    uint64_t mantissa = (uint64_t)count;
+    if (count < 0) {
+      writer.append('-');
+      mantissa = 0 - mantissa;
+    }
+    const SiPrefix* prefix =
+        PrefixForExp10(internal::LeadingExp10(mantissa, exp10));
+    char digits[internal::kMaxDecimal6Length];
+    size_t len = internal::WriteDecimal6(
+        internal::ToDecimal6(mantissa, exp10), prefix->exp10, digits);
+    writer.append(digits, len);
+    writer.append(' ');
+    writer.append(prefix->symbol);
   }
-  snprintf(out, maxlen, "%s%g %s%s", sign, val, prefix, base_unit);
+  writer.append(base_unit);
+  return writer.finish();
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,13 +1,25 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace roo_quantity {
 
 /// Formats a value with an SI prefix and base unit.
 ///
 /// Writes a null-terminated string into `out` with at most `maxlen` bytes.
-void FormatSimpleSiValue(float val, const char* base_unit, char* out,
-                         int maxlen);
+/// Returns the number of characters written, excluding the terminating null.
+size_t FormatSimpleSiValue(float val, const char* base_unit, char* out,
+                           size_t maxlen);
+
+/// Formats the exact value count * 10^exp10, with an SI prefix and base unit,
+/// the same way as FormatSimpleSiValue, but using integer arithmetic only.
+/// INT64_MIN is formatted as an unknown value ("?").
+///
+/// Writes a null-terminated string into `out` with at most `maxlen` bytes.
+/// Returns the number of characters written, excluding the terminating null.
+size_t FormatFixedSiValue(int64_t count, int exp10, const char* base_unit,
+                          char* out, size_t maxlen);
 
 }  // namespace roo_quantity
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+// Internal helpers for the vectorized kernels (span.cpp, statistics.cpp,
+// differentiator.cpp, filter.cpp, barometric.cpp).
+//
+// On x86 with GCC or Clang, the kernels are compiled for SSE2 (the baseline on
+// x86-64), plus an AVX2 variant selected at runtime. Other targets use portable
+// loops.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    defined(__SSE2__)
+#define ROO_QUANTITY_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace roo_quantity {
+namespace internal {
+
+#ifdef ROO_QUANTITY_X86_SIMD
+
+/// Returns whether the CPU supports AVX2.
+inline bool HasAvx2() {
+  static const bool has_avx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return has_avx2;
+}
+
+#endif  // ROO_QUANTITY_X86_SIMD
+
+}  // namespace internal
+}  // namespace roo_quantity
@@ -0,0 +1,113 @@
+#include "roo_quantity/span.h"
+
+#include "roo_quantity/simd.h"
+
+namespace roo_quantity {
+namespace internal {
+namespace {
+
+// The kernels apply each IEEE operation separately (e.g. multiply, then add,
+// rather than a fused multiply-add), so that the results, including NaN
+// propagation and division by zero, are bit-identical to the scalar path.
+
+enum class Op { kMul, kMulAdd, kDiv };
+
+// Computes out[i] = a[i] op b[i] (+ c), where b is either an array or, if
+// kBroadcast, a single value.
+template <Op op, bool kBroadcast>
+void ApplyScalar(const float* a, const float* b, float c, float* out,
+                 size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    float y = kBroadcast ? b[0] : b[i];
+    if (op == Op::kDiv) {
+      y = a[i] / y;
+    } else {
+      y = a[i] * y;
+      if (op == Op::kMulAdd) y = y + c;
+    }
+    out[i] = y;
+  }
+}
+
+#ifdef ROO_QUANTITY_X86_SIMD
+
+template <Op op, bool kBroadcast>
+void ApplySse(const float* a, const float* b, float c, float* out, size_t n) {
+  const __m128 vb = _mm_set1_ps(kBroadcast ? b[0] : 0.0f);
+  const __m128 vc = _mm_set1_ps(c);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 y = kBroadcast ? vb : _mm_loadu_ps(b + i);
+    if (op == Op::kDiv) {
+      y = _mm_div_ps(_mm_loadu_ps(a + i), y);
+    } else {
+      y = _mm_mul_ps(_mm_loadu_ps(a + i), y);
+      if (op == Op::kMulAdd) y = _mm_add_ps(y, vc);
+    }
+    _mm_storeu_ps(out + i, y);
+  }
+  ApplyScalar<op, kBroadcast>(a + i, kBroadcast ? b : b + i, c, out + i,
+                              n - i);
+}
+
+template <Op op, bool kBroadcast>
+__attribute__((target("avx2"))) void ApplyAvx2(const float* a, const float* b,
+                                                float c, float* out,
+                                                size_t n) {
+  const __m256 vb = _mm256_set1_ps(kBroadcast ? b[0] : 0.0f);
+  const __m256 vc = _mm256_set1_ps(c);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 y = kBroadcast ? vb : _mm256_loadu_ps(b + i);
+    if (op == Op::kDiv) {
+      y = _mm256_div_ps(_mm256_loadu_ps(a + i), y);
+    } else {
+      y = _mm256_mul_ps(_mm256_loadu_ps(a + i), y);
+      if (op == Op::kMulAdd) y = _mm256_add_ps(y, vc);
+    }
+    _mm256_storeu_ps(out + i, y);
+  }
+  ApplySse<op, kBroadcast>(a + i, kBroadcast ? b : b + i, c, out + i, n - i);
+}
+
+#endif  // ROO_QUANTITY_X86_SIMD
+
+template <Op op, bool kBroadcast>
+void Apply(const float* a, const float* b, float c, float* out, size_t n) {
+  if (n == 0) return;
+#ifdef ROO_QUANTITY_X86_SIMD
+  if (HasAvx2()) {
+    ApplyAvx2<op, kBroadcast>(a, b, c, out, n);
+  } else {
+    ApplySse<op, kBroadcast>(a, b, c, out, n);
+  }
+#else
+  ApplyScalar<op, kBroadcast>(a, b, c, out, n);
+#endif
+}
+
+}  // namespace
+
+void AffineTransform(const float* in, float* out, size_t n, float scale,
+                     float offset) {
+  if (offset == 0.0f) {
+    Apply<Op::kMul, true>(in, &scale, 0.0f, out, n);
+  } else {
+    Apply<Op::kMulAdd, true>(in, &scale, offset, out, n);
+  }
+}
+
+void MultiplyArrays(const float* a, const float* b, float* out, size_t n) {
+  Apply<Op::kMul, false>(a, b, 0.0f, out, n);
+}
+
+void DivideArrays(const float* a, const float* b, float* out, size_t n) {
+  Apply<Op::kDiv, false>(a, b, 0.0f, out, n);
+}
+
+void DivideArray(const float* a, float b, float* out, size_t n) {
+  Apply<Op::kDiv, true>(a, &b, 0.0f, out, n);
+}
+
+}  // namespace internal
+}  // namespace roo_quantity
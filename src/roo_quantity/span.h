@@ -0,0 +1,283 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <type_traits>
+#include <utility>
+
+#include "roo_quantity/quantity.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// Describes how a quantity class maps to its raw (stored) value. For
+/// QuantityBase-derived classes, the raw value is the value in coherent SI
+/// units. Temperature, which is not an ordinary quantity, stores Celsius.
+template <typename Q>
+struct RawTraits {
+  using Rep = typename Q::Rep;
+  static constexpr Q FromRaw(Rep raw) { return Q::FromSiUnits(raw); }
+  static constexpr Rep ToRaw(const Q& q) { return q.inSiUnits(); }
+};
+
+template <>
+struct RawTraits<Temperature> {
+  using Rep = float;
+  static constexpr Temperature FromRaw(float raw) {
+    return TemperatureDegCelcius(raw);
+  }
+  static constexpr float ToRaw(const Temperature& t) { return t.degCelcius(); }
+};
+
+/// Result of fitting y = x * scale + offset to a float function.
+struct AffineFit {
+  bool exact;
+  float scale;
+  float offset;
+};
+
+template <typename F>
+constexpr bool MatchesAffine(F f, float scale, float offset) {
+  constexpr float kProbes[] = {1.0f,       -1.0f,   0.1f,     -3.75f,
+                               12345.678f, 1e-7f,   -2.5e-4f, 98.6f,
+                               1e9f,       -7.3e12f};
+  for (float x : kProbes) {
+    float y = x * scale;
+    if (offset != 0.0f) y = y + offset;
+    if (f(x) != y) return false;
+  }
+  return true;
+}
+
+/// Determines whether `f` computes exactly (i.e., with the same rounding)
+/// fl(fl(x * scale) + offset), as the unit accessors and factories do, and if
+/// so, finds the coefficients. Evaluated at compile time.
+///
+/// The scale is recovered from f(2^m) - f(0), for the smallest m for which
+/// that subtraction is exact: 2^m * scale is always exact, but its sum with
+/// the offset generally is not.
+template <typename F>
+constexpr AffineFit FitAffine(F f) {
+  float offset = f(0.0f);
+  float x = 1.0f;
+  for (int m = 0; m <= 30; ++m) {
+    float scale = (f(x) - offset) / x;
+    if (MatchesAffine(f, scale, offset)) return AffineFit{true, scale, offset};
+    x *= 2.0f;
+  }
+  return AffineFit{false, 0.0f, 0.0f};
+}
+
+/// Computes out[i] = in[i] * scale (+ offset, if non-zero), for i in [0, n).
+/// Uses AVX2 or SSE where available. `out` may be the same as `in`.
+void AffineTransform(const float* in, float* out, size_t n, float scale,
+                     float offset);
+
+/// Computes out[i] = a[i] * b[i], for i in [0, n).
+void MultiplyArrays(const float* a, const float* b, float* out, size_t n);
+
+/// Computes out[i] = a[i] / b[i], for i in [0, n).
+void DivideArrays(const float* a, const float* b, float* out, size_t n);
+
+/// Computes out[i] = a[i] / b, for i in [0, n).
+void DivideArray(const float* a, float b, float* out, size_t n);
+
+template <typename T>
+struct AccessorTraits;
+
+template <typename Q, typename R>
+struct AccessorTraits<R (Q::*)() const> {
+  using Quantity = Q;
+};
+
+template <typename Q>
+using RemoveConst = typename std::remove_const<Q>::type;
+
+/// The quantity type resulting from multiplying (or dividing) elements of the
+/// specified types.
+template <typename Q1, typename Q2>
+using ProductOf = decltype(std::declval<RemoveConst<Q1>>() *
+                           std::declval<RemoveConst<Q2>>());
+
+template <typename Q1, typename Q2>
+using QuotientOf = decltype(std::declval<RemoveConst<Q1>>() /
+                            std::declval<RemoveConst<Q2>>());
+
+template <typename Q>
+constexpr void CheckElementwise() {
+  static_assert(IsQuantity<Q>::value,
+                "Element-wise operations must yield a quantity");
+  static_assert(std::is_same<typename Q::Rep, float>::value,
+                "Element-wise operations support single-precision quantities "
+                "only");
+}
+
+template <typename T>
+struct FactoryTraits;
+
+template <typename Q, typename R>
+struct FactoryTraits<Q (*)(R)> {
+  using Quantity = Q;
+};
+
+}  // namespace internal
+
+/// Non-owning view of a contiguous sequence of quantities, stored as their raw
+/// values (see internal::RawTraits) in an array of Rep (float for all the
+/// single-precision classes). Use it to hold and bulk-convert large numbers of
+/// readings; see ConvertTo() and ConvertFrom().
+///
+/// Q may be const-qualified, for a read-only view. Quantity objects are laid
+/// out exactly like their Rep, so a span can also view an array of quantities.
+template <typename Q>
+class QuantitySpan {
+ public:
+  using value_type = typename std::remove_const<Q>::type;
+  using Rep = typename std::conditional<
+      std::is_const<Q>::value,
+      const typename internal::RawTraits<value_type>::Rep,
+      typename internal::RawTraits<value_type>::Rep>::type;
+
+  static_assert(sizeof(value_type) == sizeof(Rep) &&
+                    std::is_standard_layout<value_type>::value,
+                "Quantity must be layout-compatible with its representation");
+
+  /// Creates an empty span.
+  constexpr QuantitySpan() : data_(nullptr), size_(0) {}
+
+  /// Creates a span viewing `size` raw values starting at `data`.
+  constexpr QuantitySpan(Rep* data, size_t size) : data_(data), size_(size) {}
+
+  /// Creates a span viewing an array of `size` quantities.
+  QuantitySpan(Q* data, size_t size)
+      : data_(reinterpret_cast<Rep*>(data)), size_(size) {}
+
+  template <size_t N>
+  QuantitySpan(Q (&data)[N]) : QuantitySpan(data, N) {}
+
+  /// Converts a mutable span to a read-only one.
+  template <typename Q2,
+            typename = typename std::enable_if<
+                std::is_same<Q, const Q2>::value>::type>
+  constexpr QuantitySpan(const QuantitySpan<Q2>& other)
+      : data_(other.data()), size_(other.size()) {}
+
+  constexpr size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+
+  /// Returns the underlying raw values.
+  constexpr Rep* data() const { return data_; }
+
+  constexpr value_type operator[](size_t i) const {
+    return internal::RawTraits<value_type>::FromRaw(data_[i]);
+  }
+
+  /// Stores `q` at position `i`. Only for mutable spans.
+  void set(size_t i, const value_type& q) const {
+    data_[i] = internal::RawTraits<value_type>::ToRaw(q);
+  }
+
+  /// Returns a span viewing `count` elements starting at `offset`.
+  constexpr QuantitySpan subspan(size_t offset, size_t count) const {
+    return QuantitySpan(data_ + offset, count);
+  }
+
+ private:
+  Rep* data_;
+  size_t size_;
+};
+
+/// Writes the quantities from `in`, expressed in the unit of the specified
+/// accessor, into `out`, which must have room for in.size() elements.
+/// Equivalent to out[i] = in[i].inUnit(), with bit-identical results, but
+/// vectorized where possible. `out` may alias in.data(). For example:
+///
+///   ConvertTo<&Length::inMillimeters>(lengths, mm);
+///   ConvertTo<&Temperature::degFahrenheit>(temperatures, fahrenheit);
+template <auto Accessor>
+void ConvertTo(
+    QuantitySpan<const typename internal::AccessorTraits<
+        decltype(Accessor)>::Quantity> in,
+    float* out) {
+  using Q = typename internal::AccessorTraits<decltype(Accessor)>::Quantity;
+  using Traits = internal::RawTraits<Q>;
+  static_assert(std::is_same<typename Traits::Rep, float>::value,
+                "Bulk conversion supports single-precision quantities only");
+  constexpr internal::AffineFit fit = internal::FitAffine(
+      [](float x) { return (Traits::FromRaw(x).*Accessor)(); });
+  if constexpr (fit.exact) {
+    internal::AffineTransform(in.data(), out, in.size(), fit.scale,
+                              fit.offset);
+  } else {
+    for (size_t i = 0; i < in.size(); ++i) out[i] = (in[i].*Accessor)();
+  }
+}
+
+/// Fills `out` with quantities created by the specified factory from the
+/// values in `in`, which must have out.size() elements. Equivalent to
+/// out[i] = QuantityInUnit(in[i]), with bit-identical results, but vectorized
+/// where possible. `in` may alias out.data(). For example:
+///
+///   ConvertFrom<&LengthInMillimeters>(mm, lengths);
+template <auto Factory>
+void ConvertFrom(
+    const float* in,
+    QuantitySpan<typename internal::FactoryTraits<decltype(Factory)>::Quantity>
+        out) {
+  using Q = typename internal::FactoryTraits<decltype(Factory)>::Quantity;
+  using Traits = internal::RawTraits<Q>;
+  static_assert(std::is_same<typename Traits::Rep, float>::value,
+                "Bulk conversion supports single-precision quantities only");
+  constexpr internal::AffineFit fit = internal::FitAffine(
+      [](float x) { return Traits::ToRaw(Factory(x)); });
+  if constexpr (fit.exact) {
+    internal::AffineTransform(in, out.data(), out.size(), fit.scale,
+                              fit.offset);
+  } else {
+    for (size_t i = 0; i < out.size(); ++i) out.set(i, Factory(in[i]));
+  }
+}
+
+/// Computes out[i] = a[i] * b[i] for all elements of `out`; e.g. power from
+/// voltage and current samples. The inputs must have at least out.size()
+/// elements, and the output type must match the type of the product. Results,
+/// including unknown (NaN) propagation, are identical to the scalar operator.
+/// `out` may alias either input.
+template <typename Q1, typename Q2>
+void Multiply(QuantitySpan<Q1> a, QuantitySpan<Q2> b,
+              QuantitySpan<internal::ProductOf<Q1, Q2>> out) {
+  internal::CheckElementwise<internal::ProductOf<Q1, Q2>>();
+  internal::MultiplyArrays(a.data(), b.data(), out.data(), out.size());
+}
+
+/// Computes out[i] = a[i] * b for all elements of `out`.
+template <typename Q1, typename Q2>
+void Multiply(QuantitySpan<Q1> a, const Q2& b,
+              QuantitySpan<internal::ProductOf<Q1, Q2>> out) {
+  internal::CheckElementwise<internal::ProductOf<Q1, Q2>>();
+  internal::AffineTransform(a.data(), out.data(), out.size(), b.inSiUnits(),
+                            0.0f);
+}
+
+/// Computes out[i] = a[i] / b[i] for all elements of `out`; e.g. resistance
+/// from voltage and current samples. Division by zero yields infinity, and
+/// unknown operands yield unknown, as with the scalar operator. `out` may alias
+/// either input.
+template <typename Q1, typename Q2>
+void Divide(QuantitySpan<Q1> a, QuantitySpan<Q2> b,
+            QuantitySpan<internal::QuotientOf<Q1, Q2>> out) {
+  internal::CheckElementwise<internal::QuotientOf<Q1, Q2>>();
+  internal::DivideArrays(a.data(), b.data(), out.data(), out.size());
+}
+
+/// Computes out[i] = a[i] / b for all elements of `out`.
+template <typename Q1, typename Q2>
+void Divide(QuantitySpan<Q1> a, const Q2& b,
+            QuantitySpan<internal::QuotientOf<Q1, Q2>> out) {
+  internal::CheckElementwise<internal::QuotientOf<Q1, Q2>>();
+  internal::DivideArray(a.data(), b.inSiUnits(), out.data(), out.size());
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,183 @@
+#include "roo_quantity/statistics.h"
+
+#include <limits>
+
+#include "roo_quantity/simd.h"
+
+namespace roo_quantity {
+namespace internal {
+namespace {
+
+// Kahan-compensated float sum. (Relies on strict IEEE semantics; the library
+// must not be compiled with -ffast-math.)
+struct CompensatedSum {
+  float sum = 0.0f;
+  float compensation = 0.0f;
+
+  void add(float x) {
+    float y = x - compensation;
+    float t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+  }
+
+  // Adds the (sum, compensation) pair of another accumulator, e.g. a SIMD
+  // lane.
+  void merge(float other_sum, float other_compensation) {
+    add(other_sum);
+    add(-other_compensation);
+  }
+};
+
+// Accumulates the known (non-NaN) elements of data[0, n), or, if kSquares,
+// their squared deviations from `mean`, into `result`.
+template <bool kSquares>
+void AccumulateScalar(const float* data, size_t n, float mean,
+                      CompensatedSum& sum, KnownStats& result) {
+  for (size_t i = 0; i < n; ++i) {
+    float x = data[i];
+    if (x != x) continue;
+    ++result.count;
+    if (x < result.min) result.min = x;
+    if (x > result.max) result.max = x;
+    if (kSquares) {
+      float d = x - mean;
+      sum.add(d * d);
+    } else {
+      sum.add(x);
+    }
+  }
+}
+
+#ifdef ROO_QUANTITY_X86_SIMD
+
+template <bool kSquares>
+void AccumulateSse(const float* data, size_t n, float mean,
+                   CompensatedSum& sum, KnownStats& result) {
+  const __m128 vmean = _mm_set1_ps(mean);
+  __m128 vsum = _mm_setzero_ps();
+  __m128 vcomp = _mm_setzero_ps();
+  __m128 vmin = _mm_set1_ps(result.min);
+  __m128 vmax = _mm_set1_ps(result.max);
+  __m128i vcount = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(data + i);
+    __m128 known = _mm_cmpord_ps(x, x);
+    // minps and maxps return the second operand if either is NaN.
+    vmin = _mm_min_ps(x, vmin);
+    vmax = _mm_max_ps(x, vmax);
+    vcount = _mm_sub_epi32(vcount, _mm_castps_si128(known));
+    __m128 v = x;
+    if (kSquares) {
+      v = _mm_sub_ps(x, vmean);
+      v = _mm_mul_ps(v, v);
+    }
+    v = _mm_and_ps(v, known);
+    __m128 y = _mm_sub_ps(v, vcomp);
+    __m128 t = _mm_add_ps(vsum, y);
+    vcomp = _mm_sub_ps(_mm_sub_ps(t, vsum), y);
+    vsum = t;
+  }
+  alignas(16) float sums[4], comps[4], mins[4], maxs[4];
+  alignas(16) int32_t counts[4];
+  _mm_store_ps(sums, vsum);
+  _mm_store_ps(comps, vcomp);
+  _mm_store_ps(mins, vmin);
+  _mm_store_ps(maxs, vmax);
+  _mm_store_si128(reinterpret_cast<__m128i*>(counts), vcount);
+  for (int k = 0; k < 4; ++k) {
+    sum.merge(sums[k], comps[k]);
+    result.count += counts[k];
+    if (mins[k] < result.min) result.min = mins[k];
+    if (maxs[k] > result.max) result.max = maxs[k];
+  }
+  AccumulateScalar<kSquares>(data + i, n - i, mean, sum, result);
+}
+
+template <bool kSquares>
+__attribute__((target("avx2"))) void AccumulateAvx2(const float* data,
+                                                     size_t n, float mean,
+                                                     CompensatedSum& sum,
+                                                     KnownStats& result) {
+  const __m256 vmean = _mm256_set1_ps(mean);
+  __m256 vsum = _mm256_setzero_ps();
+  __m256 vcomp = _mm256_setzero_ps();
+  __m256 vmin = _mm256_set1_ps(result.min);
+  __m256 vmax = _mm256_set1_ps(result.max);
+  __m256i vcount = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 x = _mm256_loadu_ps(data + i);
+    __m256 known = _mm256_cmp_ps(x, x, _CMP_ORD_Q);
+    vmin = _mm256_min_ps(x, vmin);
+    vmax = _mm256_max_ps(x, vmax);
+    vcount = _mm256_sub_epi32(vcount, _mm256_castps_si256(known));
+    __m256 v = x;
+    if (kSquares) {
+      v = _mm256_sub_ps(x, vmean);
+      v = _mm256_mul_ps(v, v);
+    }
+    v = _mm256_and_ps(v, known);
+    __m256 y = _mm256_sub_ps(v, vcomp);
+    __m256 t = _mm256_add_ps(vsum, y);
+    vcomp = _mm256_sub_ps(_mm256_sub_ps(t, vsum), y);
+    vsum = t;
+  }
+  alignas(32) float sums[8], comps[8], mins[8], maxs[8];
+  alignas(32) int32_t counts[8];
+  _mm256_store_ps(sums, vsum);
+  _mm256_store_ps(comps, vcomp);
+  _mm256_store_ps(mins, vmin);
+  _mm256_store_ps(maxs, vmax);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(counts), vcount);
+  for (int k = 0; k < 8; ++k) {
+    sum.merge(sums[k], comps[k]);
+    result.count += counts[k];
+    if (mins[k] < result.min) result.min = mins[k];
+    if (maxs[k] > result.max) result.max = maxs[k];
+  }
+  AccumulateSse<kSquares>(data + i, n - i, mean, sum, result);
+}
+
+#endif  // ROO_QUANTITY_X86_SIMD
+
+template <bool kSquares>
+KnownStats Accumulate(const float* data, size_t n, float mean) {
+  KnownStats result;
+  result.count = 0;
+  result.min = std::numeric_limits<float>::infinity();
+  result.max = -std::numeric_limits<float>::infinity();
+  CompensatedSum sum;
+  // The SIMD lanes count in 32 bits; process very large inputs in chunks.
+  constexpr size_t kChunk = size_t{1} << 30;
+  while (n > 0) {
+    size_t chunk = n < kChunk ? n : kChunk;
+#ifdef ROO_QUANTITY_X86_SIMD
+    if (HasAvx2()) {
+      AccumulateAvx2<kSquares>(data, chunk, mean, sum, result);
+    } else {
+      AccumulateSse<kSquares>(data, chunk, mean, sum, result);
+    }
+#else
+    AccumulateScalar<kSquares>(data, chunk, mean, sum, result);
+#endif
+    data += chunk;
+    n -= chunk;
+  }
+  result.sum = sum.sum - sum.compensation;
+  return result;
+}
+
+}  // namespace
+
+KnownStats SumKnown(const float* data, size_t n) {
+  return Accumulate<false>(data, n, 0.0f);
+}
+
+float SumSquaredDeviations(const float* data, size_t n, float mean) {
+  return Accumulate<true>(data, n, mean).sum;
+}
+
+}  // namespace internal
+}  // namespace roo_quantity
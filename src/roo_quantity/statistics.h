@@ -0,0 +1,170 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <type_traits>
+
+#include "roo_quantity/quantity.h"
+#include "roo_quantity/span.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/unknown.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// Count, compensated sum, min, and max of the known (non-NaN) elements of an
+/// array. If there are no known elements, min and max are +inf and -inf.
+struct KnownStats {
+  size_t count;
+  float sum;
+  float min;
+  float max;
+};
+
+/// Computes KnownStats over data[0, n). Vectorized; see span.h.
+KnownStats SumKnown(const float* data, size_t n);
+
+/// Computes the compensated sum of (x - mean)^2 over the known elements x of
+/// data[0, n).
+float SumSquaredDeviations(const float* data, size_t n, float mean);
+
+/// The type representing differences between values of Q: Q itself for
+/// ordinary quantities, and TemperatureDelta for Temperature.
+template <typename Q>
+struct DeltaOf {
+  using type = Q;
+};
+
+template <>
+struct DeltaOf<Temperature> {
+  using type = TemperatureDelta;
+};
+
+template <typename Q>
+using DeltaType = typename DeltaOf<RemoveConst<Q>>::type;
+
+template <typename Q>
+using VarianceType = ProductOf<DeltaType<Q>, DeltaType<Q>>;
+
+template <typename Q>
+constexpr void CheckStatistics() {
+  static_assert(std::is_same<typename RawTraits<RemoveConst<Q>>::Rep,
+                             float>::value,
+                "Statistics support single-precision quantities only");
+}
+
+}  // namespace internal
+
+// Reductions over spans of quantities (see span.h). All of them skip unknown
+// elements, and are vectorized. Sums use compensated (Kahan) summation, so
+// their accuracy does not degrade with the number of elements.
+
+/// Returns the number of known (i.e. not unknown) elements.
+template <typename Q>
+size_t CountKnown(QuantitySpan<Q> span) {
+  internal::CheckStatistics<Q>();
+  return internal::SumKnown(span.data(), span.size()).count;
+}
+
+/// Returns the smallest known element, or unknown if there are none.
+template <typename Q>
+internal::RemoveConst<Q> Min(QuantitySpan<Q> span) {
+  internal::CheckStatistics<Q>();
+  internal::KnownStats stats = internal::SumKnown(span.data(), span.size());
+  return internal::RawTraits<internal::RemoveConst<Q>>::FromRaw(
+      stats.count == 0 ? internal::kUnknownValue : stats.min);
+}
+
+/// Returns the largest known element, or unknown if there are none.
+template <typename Q>
+internal::RemoveConst<Q> Max(QuantitySpan<Q> span) {
+  internal::CheckStatistics<Q>();
+  internal::KnownStats stats = internal::SumKnown(span.data(), span.size());
+  return internal::RawTraits<internal::RemoveConst<Q>>::FromRaw(
+      stats.count == 0 ? internal::kUnknownValue : stats.max);
+}
+
+/// Returns the sum of the known elements (zero if there are none). Not
+/// defined for Temperature, which is not additive; use Mean() instead.
+template <typename Q>
+internal::RemoveConst<Q> Sum(QuantitySpan<Q> span) {
+  internal::CheckStatistics<Q>();
+  static_assert(internal::IsQuantity<internal::RemoveConst<Q>>::value,
+                "Sum is only defined for additive quantities");
+  return internal::RemoveConst<Q>::FromSiUnits(
+      internal::SumKnown(span.data(), span.size()).sum);
+}
+
+/// Returns the mean of the known elements, or unknown if there are none. For
+/// Temperature, returns the mean Temperature.
+template <typename Q>
+internal::RemoveConst<Q> Mean(QuantitySpan<Q> span) {
+  internal::CheckStatistics<Q>();
+  internal::KnownStats stats = internal::SumKnown(span.data(), span.size());
+  return internal::RawTraits<internal::RemoveConst<Q>>::FromRaw(
+      stats.count == 0 ? internal::kUnknownValue
+                       : stats.sum / static_cast<float>(stats.count));
+}
+
+/// Returns the sample variance (with Bessel's correction) of the known
+/// elements, or unknown if there are fewer than two. The result has the
+/// squared dimension (e.g. Area for Length).
+template <typename Q>
+internal::VarianceType<Q> Variance(QuantitySpan<Q> span) {
+  internal::CheckStatistics<Q>();
+  internal::KnownStats stats = internal::SumKnown(span.data(), span.size());
+  if (stats.count < 2) return internal::VarianceType<Q>();
+  float mean = stats.sum / static_cast<float>(stats.count);
+  float m2 = internal::SumSquaredDeviations(span.data(), span.size(), mean);
+  return internal::VarianceType<Q>::FromSiUnits(
+      m2 / static_cast<float>(stats.count - 1));
+}
+
+/// Returns the sample standard deviation of the known elements, or unknown if
+/// there are fewer than two. For Temperature, returns a TemperatureDelta.
+template <typename Q>
+internal::DeltaType<Q> StdDev(QuantitySpan<Q> span) {
+  return internal::DeltaType<Q>::FromSiUnits(
+      std::sqrt(Variance(span).inSiUnits()));
+}
+
+/// Summary statistics of a span; see Summarize().
+template <typename Q>
+struct Summary {
+  /// Number of known elements.
+  size_t count;
+
+  Q min;
+  Q max;
+  Q mean;
+
+  /// Sample standard deviation.
+  typename internal::DeltaOf<Q>::type stddev;
+};
+
+/// Computes all the summary statistics in two passes over the data.
+template <typename Q>
+Summary<internal::RemoveConst<Q>> Summarize(QuantitySpan<Q> span) {
+  using Result = internal::RemoveConst<Q>;
+  using Traits = internal::RawTraits<Result>;
+  using Delta = internal::DeltaType<Q>;
+  internal::CheckStatistics<Q>();
+  internal::KnownStats stats = internal::SumKnown(span.data(), span.size());
+  Summary<Result> summary;
+  summary.count = stats.count;
+  if (stats.count == 0) return summary;
+  float mean = stats.sum / static_cast<float>(stats.count);
+  summary.min = Traits::FromRaw(stats.min);
+  summary.max = Traits::FromRaw(stats.max);
+  summary.mean = Traits::FromRaw(mean);
+  if (stats.count >= 2) {
+    float m2 = internal::SumSquaredDeviations(span.data(), span.size(), mean);
+    summary.stddev = Delta::FromSiUnits(
+        std::sqrt(m2 / static_cast<float>(stats.count - 1)));
+  }
+  return summary;
+}
+
+}  // namespace roo_quantity
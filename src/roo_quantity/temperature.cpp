@@ -1,79 +1,55 @@
 #include "roo_quantity/temperature.h"
 
+#include "roo_quantity/format.h"
+
 ROO_FLAG(char, roo_quantity_default_temperature_unit, 'C');
 
 namespace roo_quantity {
 namespace {
 
-void TemperatureToString(const Temperature& t, char* out, int maxlen) {
+size_t FormatDegrees(float deg, const char* symbol, char* out, size_t maxlen) {
+  internal::StringWriter writer(out, maxlen);
+  if (std::isnan(deg)) {
+    writer.append('?');
+  } else {
+    writer.appendFloat(deg);
+  }
+  writer.append(symbol);
+  return writer.finish();
+}
+
+}  // namespace
+
+size_t Temperature::formatTo(char* out, size_t maxlen) const {
   switch (GET_ROO_FLAG(roo_quantity_default_temperature_unit)) {
-    case 'F': {
-      if (t.isUnknown()) {
-        snprintf(out, maxlen, "?°F");
-      } else {
-        snprintf(out, maxlen, "%g°F", t.degFahrenheit());
-      }
-      break;
-    }
-    case 'K': {
-      if (t.isUnknown()) {
-        snprintf(out, maxlen, "?°K");
-      } else {
-        snprintf(out, maxlen, "%g°K", t.degKelvin());
-      }
-      break;
-    }
-    default: {
-      if (t.isUnknown()) {
-        snprintf(out, maxlen, "?°C");
-      } else {
-        snprintf(out, maxlen, "%g°C", t.degCelcius());
-      }
-    }
+    case 'F':
+      return FormatDegrees(degFahrenheit(), "°F", out, maxlen);
+    case 'K':
+      return FormatDegrees(degKelvin(), "°K", out, maxlen);
+    default:
+      return FormatDegrees(degCelcius(), "°C", out, maxlen);
   }
 }
 
-void TemperatureDeltaToString(const TemperatureDelta& dt, char* out, int maxlen) {
+size_t TemperatureDelta::formatTo(char* out, size_t maxlen) const {
   switch (GET_ROO_FLAG(roo_quantity_default_temperature_unit)) {
-    case 'F': {
-      if (dt.isUnknown()) {
-        snprintf(out, maxlen, "?°F");
-      } else {
-        snprintf(out, maxlen, "%g°F", dt.degFahrenheit());
-      }
-      break;
-    }
-    case 'K': {
-      if (dt.isUnknown()) {
-        snprintf(out, maxlen, "?°K");
-      } else {
-        snprintf(out, maxlen, "%g°K", dt.degKelvin());
-      }
-      break;
-    }
-    default: {
-      if (dt.isUnknown()) {
-        snprintf(out, maxlen, "?°C");
-      } else {
-        snprintf(out, maxlen, "%g°C", dt.degCelcius());
-      }
-    }
+    case 'F':
+      return FormatDegrees(degFahrenheit(), "°F", out, maxlen);
+    case 'K':
+      return FormatDegrees(degKelvin(), "°K", out, maxlen);
+    default:
+      return FormatDegrees(degCelcius(), "°C", out, maxlen);
   }
 }
-}  // namespace
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Temperature::asString() const {
-  char out[16];
-  TemperatureToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 std::string TemperatureDelta::asString() const {
-  char out[16];
-  TemperatureDeltaToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -81,31 +57,22 @@ std::string TemperatureDelta::asString() const {
 #if defined(ARDUINO)
 
 String Temperature::asArduinoString() const {
-  char out[16];
-  TemperatureToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 String TemperatureDelta::asArduinoString() const {
-  char out[16];
-  TemperatureDeltaToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Temperature& t) {
-  char out[16];
-  TemperatureToString(t, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, t);
 }
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const TemperatureDelta& dt) {
-  char out[16];
-  TemperatureDeltaToString(dt, out, 16);
-  os << out;
-  return os;
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const TemperatureDelta& dt) {
+  return internal::FormatToStream(os, dt);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
+#include "roo_quantity/quantity.h"
+#include "roo_quantity/unknown.h"
 #include "roo_time.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
@@ -26,46 +29,52 @@ class TemperatureDelta;
 class Temperature {
  public:
   /// Creates a temperature object representing an 'unknown' temperature.
-  Temperature() : tempC_(std::nanf("")) {}
+  constexpr Temperature() : tempC_(internal::kUnknownValue) {}
 
   /// Returns the temperature in degrees Celcius.
-  float degCelcius() const { return tempC_; }
+  constexpr float degCelcius() const { return tempC_; }
 
   /// Returns the temperature in degrees Kelvin.
-  float degKelvin() const { return tempC_ + 273.15; }
+  constexpr float degKelvin() const { return tempC_ + 273.15f; }
 
   /// Returns the temperature in degrees Fahrenheit.
-  float degFahrenheit() const { return tempC_ * 1.8 + 32.0; }
+  constexpr float degFahrenheit() const { return tempC_ * 1.8f + 32.0f; }
 
   /// Returns whether the object represents an unknown temperature.
-  bool isUnknown() const { return std::isnan(tempC_); }
+  constexpr bool isUnknown() const { return tempC_ != tempC_; }
 
-  bool operator<(const Temperature &other) const {
+  constexpr bool operator<(const Temperature &other) const {
     return tempC_ < other.tempC_;
   }
 
-  bool operator==(const Temperature &other) const {
+  constexpr bool operator==(const Temperature &other) const {
     return tempC_ == other.tempC_;
   }
 
-  bool operator>(const Temperature &other) const {
+  constexpr bool operator>(const Temperature &other) const {
     return other.tempC_ < tempC_;
   }
 
-  bool operator<=(const Temperature &other) const {
+  constexpr bool operator<=(const Temperature &other) const {
     return !(other.tempC_ < tempC_);
   }
 
-  bool operator>=(const Temperature &other) const {
+  constexpr bool operator>=(const Temperature &other) const {
     return !(tempC_ < other.tempC_);
   }
 
-  bool operator!=(const Temperature &other) const {
+  constexpr bool operator!=(const Temperature &other) const {
     return !(tempC_ == other.tempC_);
   }
 
-  inline Temperature &operator+=(const TemperatureDelta &other);
-  inline Temperature &operator-=(const TemperatureDelta &other);
+  constexpr Temperature &operator+=(const TemperatureDelta &other);
+  constexpr Temperature &operator-=(const TemperatureDelta &other);
+
+  /// Writes the string representation of the temperature into `out`, using the
+  /// unit defined by the 'roo_temperature_default_unit' flag. Writes at most
+  /// `maxlen` bytes, including the terminating null, and returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char *out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the temperature, using the unit
@@ -78,80 +87,45 @@ class Temperature {
 #endif
 
  private:
-  friend Temperature UnknownTemperature();
+  friend constexpr Temperature UnknownTemperature();
 
-  friend Temperature TemperatureDegCelcius(float);
-  friend Temperature TemperatureDegKelvin(float);
-  friend Temperature TemperatureDegFahrenheit(float);
+  friend constexpr Temperature TemperatureDegCelcius(float);
+  friend constexpr Temperature TemperatureDegKelvin(float);
+  friend constexpr Temperature TemperatureDegFahrenheit(float);
 
-  explicit Temperature(float tempC) : tempC_(tempC) {}
+  explicit constexpr Temperature(float tempC) : tempC_(tempC) {}
 
   /// Using Celsius for the internal representation, so that integer C
   /// temperatures (particularly, zero) behave well when compared for equality.
   float tempC_;
 };
 
-class TemperatureDelta {
+/// Representation of a temperature difference, internally stored as
+/// floating-point Kelvin (equivalently, Celsius) degrees. Unlike Temperature,
+/// it is an ordinary quantity, and can be combined with other quantities.
+class TemperatureDelta
+    : public internal::QuantityBase<TemperatureDelta,
+                                    dimension::TemperatureDelta, float> {
  public:
   /// Creates a temperature delta object representing an 'unknown' temperature
   /// delta.
-  TemperatureDelta() : tempC_(std::nanf("")) {}
+  constexpr TemperatureDelta() = default;
 
   /// Returns the temperature delta in degrees Celcius.
-  float degCelcius() const { return tempC_; }
+  constexpr float degCelcius() const { return value_; }
 
   /// Returns the temperature delta in degrees Kelvin.
-  float degKelvin() const { return tempC_; }
+  constexpr float degKelvin() const { return value_; }
 
   /// Returns the temperature delta in degrees Fahrenheit.
-  float degFahrenheit() const { return tempC_ * 1.8; }
-
-  /// Returns whether the object represents an unknown temperature delta.
-  bool isUnknown() const { return std::isnan(tempC_); }
-
-  bool operator<(const TemperatureDelta &other) const {
-    return tempC_ < other.tempC_;
-  }
-
-  bool operator==(const TemperatureDelta &other) const {
-    return tempC_ == other.tempC_;
-  }
-
-  bool operator>(const TemperatureDelta &other) const {
-    return other.tempC_ < tempC_;
-  }
+  constexpr float degFahrenheit() const { return value_ * 1.8f; }
 
-  bool operator<=(const TemperatureDelta &other) const {
-    return !(other.tempC_ < tempC_);
-  }
-
-  bool operator>=(const TemperatureDelta &other) const {
-    return !(tempC_ < other.tempC_);
-  }
-
-  bool operator!=(const TemperatureDelta &other) const {
-    return !(tempC_ == other.tempC_);
-  }
-
-  inline TemperatureDelta &operator+=(const TemperatureDelta &other) {
-    tempC_ += other.degCelcius();
-    return *this;
-  }
-
-  inline TemperatureDelta &operator-=(const TemperatureDelta &other) {
-    tempC_ -= other.degCelcius();
-    return *this;
-  }
-
-  inline TemperatureDelta &operator*=(float multi) {
-    tempC_ *= multi;
-    return *this;
-  }
-
-  inline TemperatureDelta &operator/=(float div) {
-    tempC_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the temperature delta into `out`,
+  /// using the unit defined by the 'roo_temperature_default_unit' flag. Writes
+  /// at most `maxlen` bytes, including the terminating null, and returns the
+  /// number of characters written, excluding the terminating null. Does not
+  /// allocate.
+  size_t formatTo(char *out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the temperature delta, using the unit
@@ -164,17 +138,13 @@ class TemperatureDelta {
 #endif
 
  private:
-  friend TemperatureDelta UnknownTemperatureDelta();
-
-  friend TemperatureDelta TemperatureDeltaDegCelcius(float);
-  friend TemperatureDelta TemperatureDeltaDegKelvin(float);
-  friend TemperatureDelta TemperatureDeltaDegFahrenheit(float);
+  friend constexpr TemperatureDelta UnknownTemperatureDelta();
 
-  explicit TemperatureDelta(float tempC) : tempC_(tempC) {}
+  friend constexpr TemperatureDelta TemperatureDeltaDegCelcius(float);
+  friend constexpr TemperatureDelta TemperatureDeltaDegKelvin(float);
+  friend constexpr TemperatureDelta TemperatureDeltaDegFahrenheit(float);
 
-  /// Using Celsius (equivalent to Kelvin) for the internal delta
-  /// representation.
-  float tempC_;
+  explicit constexpr TemperatureDelta(float tempC) : QuantityBase(tempC) {}
 };
 
 roo_logging::Stream &operator<<(roo_logging::Stream &os, const Temperature &t);
@@ -182,11 +152,11 @@ roo_logging::Stream &operator<<(roo_logging::Stream &os,
                                 const TemperatureDelta &t);
 
 /// Returns a temperature object representing an unknown temperature.
-inline Temperature UnknownTemperature() { return Temperature(); }
+constexpr Temperature UnknownTemperature() { return Temperature(); }
 
 /// Returns a temperature object equivalent to the specified temperature
 /// expressed in Celcius degrees.
-inline Temperature TemperatureDegCelcius(float tempC) {
+constexpr Temperature TemperatureDegCelcius(float tempC) {
   return Temperature(tempC);
 }
 
@@ -196,8 +166,8 @@ inline Temperature TemperatureDegCelcius(float tempC) {
 /// Due to floating-point rounding errors, and since the temperature is
 /// internally stored in Celcius degrees, generally,
 /// DegKelvin(x).degKelvin() != x.
-inline Temperature TemperatureDegKelvin(float tempK) {
-  return Temperature(tempK - 273.15);
+constexpr Temperature TemperatureDegKelvin(float tempK) {
+  return Temperature(tempK - 273.15f);
 }
 
 /// Returns a temperature object approximately equal to the specified
@@ -206,23 +176,25 @@ inline Temperature TemperatureDegKelvin(float tempK) {
 /// Due to floating-point rounding errors, and since the temperature is
 /// internally stored in Celcius degrees, generally,
 /// DegFahrenheit(x).degFahrenheit() != x.
-inline Temperature TemperatureDegFahrenheit(float tempF) {
-  return TemperatureDegCelcius((tempF - 32.0) / 1.8);
+constexpr Temperature TemperatureDegFahrenheit(float tempF) {
+  return TemperatureDegCelcius((tempF - 32.0f) * 0.5555555556f);
 }
 
 /// Returns a temperature object representing an unknown temperature delta.
-inline TemperatureDelta UnknownTemperatureDelta() { return TemperatureDelta(); }
+constexpr TemperatureDelta UnknownTemperatureDelta() {
+  return TemperatureDelta();
+}
 
 /// Returns a temperature delta object equivalent to the specified temperature
 /// expressed in Celcius degrees.
-inline TemperatureDelta TemperatureDeltaDegCelcius(float tempC) {
+constexpr TemperatureDelta TemperatureDeltaDegCelcius(float tempC) {
   return TemperatureDelta(tempC);
 }
 
 /// Returns a temperature delta object equivalent to the specified temperature
 /// delta expressed in Kelvin degrees. It is in fact equivalent to
 /// TemperatureDeltaDegCelcius.
-inline TemperatureDelta TemperatureDeltaDegKelvin(float tempK) {
+constexpr TemperatureDelta TemperatureDeltaDegKelvin(float tempK) {
   return TemperatureDelta(tempK);
 }
 
@@ -232,58 +204,34 @@ inline TemperatureDelta TemperatureDeltaDegKelvin(float tempK) {
 /// Due to floating-point rounding errors, and since the temperature is
 /// internally stored in Celcius degrees, generally,
 /// DegFahrenheit(x).degFahrenheit() != x.
-inline TemperatureDelta TemperatureDeltaDegFahrenheit(float tempF) {
-  return TemperatureDeltaDegCelcius(tempF / 1.8);
+constexpr TemperatureDelta TemperatureDeltaDegFahrenheit(float tempF) {
+  return TemperatureDeltaDegCelcius(tempF * 0.5555555556f);
 }
 
-inline Temperature &Temperature::operator+=(const TemperatureDelta &other) {
+constexpr Temperature &Temperature::operator+=(const TemperatureDelta &other) {
   tempC_ += other.degCelcius();
   return *this;
 }
 
-inline Temperature &Temperature::operator-=(const TemperatureDelta &other) {
+constexpr Temperature &Temperature::operator-=(const TemperatureDelta &other) {
   tempC_ -= other.degCelcius();
   return *this;
 }
 
-inline Temperature operator+(Temperature a, TemperatureDelta b) {
+constexpr Temperature operator+(Temperature a, TemperatureDelta b) {
   return TemperatureDegCelcius(a.degCelcius() + b.degCelcius());
 }
 
-inline Temperature operator-(Temperature a, TemperatureDelta b) {
+constexpr Temperature operator-(Temperature a, TemperatureDelta b) {
   return TemperatureDegCelcius(a.degCelcius() - b.degCelcius());
 }
 
-inline Temperature operator+(TemperatureDelta a, Temperature b) {
+constexpr Temperature operator+(TemperatureDelta a, Temperature b) {
   return TemperatureDegCelcius(a.degCelcius() + b.degCelcius());
 }
 
-inline TemperatureDelta operator+(TemperatureDelta a, TemperatureDelta b) {
-  return TemperatureDeltaDegCelcius(a.degCelcius() + b.degCelcius());
-}
-
-inline TemperatureDelta operator-(TemperatureDelta a, TemperatureDelta b) {
+constexpr TemperatureDelta operator-(Temperature a, Temperature b) {
   return TemperatureDeltaDegCelcius(a.degCelcius() - b.degCelcius());
 }
 
-inline TemperatureDelta operator-(TemperatureDelta a) {
-  return TemperatureDeltaDegCelcius(-a.degCelcius());
-}
-
-inline TemperatureDelta operator-(Temperature a, Temperature b) {
-  return TemperatureDeltaDegCelcius(a.degCelcius() - b.degCelcius());
-}
-
-inline TemperatureDelta operator*(TemperatureDelta a, float b) {
-  return TemperatureDeltaDegCelcius(a.degCelcius() * b);
-}
-
-inline TemperatureDelta operator*(float a, TemperatureDelta b) {
-  return TemperatureDeltaDegCelcius(a * b.degCelcius());
-}
-
-inline TemperatureDelta operator/(TemperatureDelta a, float b) {
-  return TemperatureDeltaDegCelcius(a.degCelcius() / b);
-}
-
 }  // namespace roo_quantity
\ No newline at end of file
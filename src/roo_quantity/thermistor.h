@@ -0,0 +1,170 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+
+#include "roo_quantity/calibration.h"
+#include "roo_quantity/resistance.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+
+namespace internal {
+
+/// e^x, evaluable at compile time (std::exp is not constexpr). Accurate to
+/// about 1 ulp of double for the arguments used to model thermistors.
+constexpr double ConstexprExp(double x) {
+  constexpr double kLn2 = 0.6931471805599453;
+  // x = k * ln(2) + r, with |r| <= ln(2) / 2.
+  int k = static_cast<int>(x / kLn2 + (x < 0 ? -0.5 : 0.5));
+  double r = x - k * kLn2;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int i = 1; i < 24; ++i) {
+    term *= r / i;
+    sum += term;
+  }
+  for (; k > 0; --k) sum *= 2.0;
+  for (; k < 0; ++k) sum *= 0.5;
+  return sum;
+}
+
+constexpr double kZeroCelsiusInKelvin = 273.15;
+
+}  // namespace internal
+
+// Models of NTC thermistors, converting between their resistance and
+// temperature. Converting resistance to temperature needs a logarithm, which
+// is slow on microcontrollers without an FPU; use ThermistorTable to replace
+// it with a lookup table generated at compile time.
+
+/// The Beta (B-parameter) model: 1/T = 1/T0 + ln(R/R0) / B. Described by the
+/// nominal resistance R0 at the temperature T0 (usually 25 C), and B, which
+/// thermistor datasheets specify.
+class BetaThermistor {
+ public:
+  /// Creates the model of a thermistor with resistance r0 at temperature t0,
+  /// and the specified B constant (in Kelvin).
+  constexpr BetaThermistor(const Resistance& r0, const Temperature& t0,
+                           float beta)
+      : r0_(r0.inOhms()), inv_t0_(1.0f / t0.degKelvin()), beta_(beta) {}
+
+  /// Returns the temperature at which the thermistor has the specified
+  /// resistance.
+  Temperature temperature(const Resistance& r) const {
+    return TemperatureDegKelvin(
+        1.0f / (inv_t0_ + std::log(r.inOhms() / r0_) / beta_));
+  }
+
+  /// Returns the resistance of the thermistor at the specified temperature.
+  /// Evaluated in double precision, so that it can generate accurate lookup
+  /// tables at compile time.
+  constexpr Resistance resistance(const Temperature& t) const {
+    double kelvin = static_cast<double>(t.degCelcius()) +
+                    internal::kZeroCelsiusInKelvin;
+    return ResistanceInOhms(static_cast<float>(
+        static_cast<double>(r0_) *
+        internal::ConstexprExp(static_cast<double>(beta_) *
+                               (1.0 / kelvin - static_cast<double>(inv_t0_)))));
+  }
+
+ private:
+  float r0_;
+  float inv_t0_;
+  float beta_;
+};
+
+/// The Steinhart-Hart model: 1/T = A + B ln(R) + C ln(R)^3, with R in Ohms
+/// and T in Kelvin. More accurate than the Beta model over wide temperature
+/// ranges. Thermistor datasheets specify the coefficients.
+class SteinhartHartThermistor {
+ public:
+  constexpr SteinhartHartThermistor(float a, float b, float c)
+      : a_(a), b_(b), c_(c) {}
+
+  /// Returns the temperature at which the thermistor has the specified
+  /// resistance.
+  Temperature temperature(const Resistance& r) const {
+    float ln_r = std::log(r.inOhms());
+    return TemperatureDegKelvin(1.0f / (a_ + (b_ + c_ * ln_r * ln_r) * ln_r));
+  }
+
+  /// Returns the resistance of the thermistor at the specified temperature.
+  /// Evaluated in double precision, so that it can generate accurate lookup
+  /// tables at compile time.
+  constexpr Resistance resistance(const Temperature& t) const {
+    double a = static_cast<double>(a_);
+    double b = static_cast<double>(b_);
+    double c = static_cast<double>(c_);
+    double y = 1.0 / (static_cast<double>(t.degCelcius()) +
+                      internal::kZeroCelsiusInKelvin);
+    // Solve c x^3 + b x + (a - y) = 0 for x = ln(R) with Newton's method,
+    // starting from the solution for c = 0. The cubic is increasing, and
+    // convex for x > 0, so the iteration converges monotonically.
+    double x = (y - a) / b;
+    for (int i = 0; i < 32; ++i) {
+      double f = (c * x * x + b) * x + (a - y);
+      x -= f / (3.0 * c * x * x + b);
+    }
+    return ResistanceInOhms(static_cast<float>(internal::ConstexprExp(x)));
+  }
+
+ private:
+  float a_;
+  float b_;
+  float c_;
+};
+
+/// Lookup table converting a thermistor's resistance to temperature, without
+/// logarithms: the resistance is looked up (by binary search) among N
+/// resistances at uniformly spaced temperatures, and the temperature is
+/// linearly interpolated between them. Outside of the range of the table, the
+/// temperature is extrapolated from the end segments. Generated from a model
+/// (BetaThermistor or SteinhartHartThermistor), at compile time if the table
+/// is constexpr:
+///
+///   static constexpr ThermistorTable<67> kNtc(
+///       BetaThermistor(ResistanceInKiloOhms(10), TemperatureDegCelcius(25),
+///                      3950),
+///       TemperatureDegCelcius(-40), TemperatureDegCelcius(125));
+///   ...
+///   Temperature t = kNtc.temperature(voltage / current);
+///
+/// The error of the interpolation shrinks quadratically with the temperature
+/// step. For a typical 10 kOhm thermistor over -40..125 C, it is below 0.07 C
+/// with a 2.5 C step (67 points), and 0.25 C with a 5 C step (34 points).
+template <size_t N>
+class ThermistorTable {
+ public:
+  static_assert(N >= 2, "The table needs at least two points");
+
+  /// Generates the table from the model, for temperatures from `min` to `max`.
+  template <typename Model>
+  constexpr ThermistorTable(const Model& model, const Temperature& min,
+                            const Temperature& max)
+      : points_() {
+    float step = (max.degCelcius() - min.degCelcius()) /
+                 static_cast<float>(N - 1);
+    // Resistance decreases with temperature; the points must be sorted by
+    // increasing raw value (resistance).
+    for (size_t i = 0; i < N; ++i) {
+      Temperature t = TemperatureDegCelcius(
+          i == N - 1 ? max.degCelcius()
+                     : min.degCelcius() + step * static_cast<float>(i));
+      points_[N - 1 - i] =
+          CalibrationPoint<Temperature>{model.resistance(t).inOhms(), t};
+    }
+  }
+
+  /// Returns the temperature at which the thermistor has the specified
+  /// resistance.
+  constexpr Temperature temperature(const Resistance& r) const {
+    return CalibrationTable<Temperature>(points_)(r.inOhms());
+  }
+
+ private:
+  CalibrationPoint<Temperature> points_[N];
+};
+
+}  // namespace roo_quantity
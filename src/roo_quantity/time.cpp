@@ -1,48 +1,28 @@
 #include "roo_quantity/time.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void TimeToString(Time val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? s", maxlen);
-  } else {
-    const char* format;
-    const char* sign = "";
-    float num;
-    if (val.inSeconds() == 0.0f) {
-      snprintf(out, maxlen, "0 s");
-      return;
-    }
-    if (val.inSeconds() < 0) {
-      sign = "-";
-      val = -val;
-    }
-    if (val >= TimeInSeconds(1.0f)) {
-      format = "%s%g s";
-      num = val.inSeconds();
-    } else if (val >= TimeInMilliseconds(1.0f)) {
-      format = "%s%g ms";
-      num = val.inMilliseconds();
-    } else if (val >= TimeInMicroseconds(1.0f)) {
-      format = "%s%g µs";
-      num = val.inMicroseconds();
-    } else {
-      format = "%s%g ns";
-      num = val.inNanoseconds();
-    }
-    snprintf(out, maxlen, format, sign, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kTimeUnits[] = {
+    {1.0f,      1.0f,          " s"},
+    {0.001f,    1000.0f,       " ms"},
+    {0.000001f, 1000000.0f,    " µs"},
+    {0.0f,      1000000000.0f, " ns"},
+};
 
 }  // namespace
 
+size_t Time::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inSeconds(), kTimeUnits, " s", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Time::asString() const {
-  char out[16];
-  TimeToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -50,18 +30,38 @@ std::string Time::asString() const {
 #if defined(ARDUINO)
 
 String Time::asArduinoString() const {
-  char out[16];
-  TimeToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Time& val) {
-  char out[16];
-  TimeToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
+}
+
+size_t DoubleTime::formatTo(char* out, size_t maxlen) const {
+  return toFloat().formatTo(out, maxlen);
+}
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+
+std::string DoubleTime::asString() const {
+  return internal::FormatAsString(*this);
+}
+
+#endif
+
+#if defined(ARDUINO)
+
+String DoubleTime::asArduinoString() const {
+  return internal::FormatAsArduinoString(*this);
+}
+
+#endif
+
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const DoubleTime& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
+#include "roo_quantity/quantity.h"
 
 /// For convenience conversion from roo_time::Duration.
 #include "roo_time.h"
@@ -18,60 +23,98 @@
 
 namespace roo_quantity {
 
+namespace internal {
+
+/// Converts a microsecond count to the nearest float number of seconds, using
+/// integer arithmetic (and a single int-to-float conversion) rather than a
+/// float division.
+inline float MicrosToSeconds(int64_t micros) {
+  if (micros == 0) return 0.0f;
+  uint64_t n = micros < 0 ? -static_cast<uint64_t>(micros)
+                          : static_cast<uint64_t>(micros);
+  // Scale n by 2^k so that the quotient below has at least 26 significant
+  // bits; one more than float's 24, plus a sticky bit, makes the final
+  // conversion round correctly.
+  int k = __builtin_clzll(n) - 17;
+  if (k < 0) k = 0;
+  n <<= k;
+  uint64_t q = n / 1000000;
+  uint64_t sticky = (n - q * 1000000) != 0;
+  // Scale back by 2^-(k+1), exactly.
+  uint32_t scale_bits = static_cast<uint32_t>(126 - k) << 23;
+  float scale;
+  memcpy(&scale, &scale_bits, sizeof(scale));
+  float result = static_cast<float>((q << 1) | sticky) * scale;
+  return micros < 0 ? -result : result;
+}
+
+/// Converts float seconds to the nearest number of microseconds (rounding
+/// ties away from zero), exactly, using integer arithmetic. Saturates at the
+/// int64_t range. NaN converts to zero.
+inline int64_t SecondsToMicros(float seconds) {
+  uint32_t bits;
+  memcpy(&bits, &seconds, sizeof(bits));
+  int exp = (bits >> 23) & 0xFF;
+  if (exp == 0xFF && (bits & 0x7FFFFF) != 0) return 0;
+  bool negative = (bits & 0x80000000u) != 0;
+  // Subnormals are well below a microsecond.
+  if (exp == 0) return 0;
+  // |seconds| = mantissa * 2^shift, and mantissa * 10^6 < 2^44.
+  uint64_t micros = ((bits & 0x7FFFFF) | 0x800000) * uint64_t{1000000};
+  int shift = exp - 150;
+  if (shift >= 0) {
+    if (shift > 19) {
+      return negative ? std::numeric_limits<int64_t>::min()
+                      : std::numeric_limits<int64_t>::max();
+    }
+    micros <<= shift;
+  } else if (shift > -64) {
+    micros = (micros + (uint64_t{1} << (-shift - 1))) >> -shift;
+  } else {
+    micros = 0;
+  }
+  return negative ? -static_cast<int64_t>(micros)
+                  : static_cast<int64_t>(micros);
+}
+
+}  // namespace internal
+
 /// Representation of elapsed, internally stored as floating-point seconds.
-class Time {
+class Time : public internal::QuantityBase<Time, dimension::Time, float> {
  public:
   /// Creates a time object representing an 'unknown' time.
-  Time() : time_(std::nanf("")) {}
+  constexpr Time() = default;
 
-  Time(const roo_time::Duration& duration) : time_(duration.inSecondsFloat()) {}
+  /// Converts from roo_time::Duration, rounding to the nearest representable
+  /// time. Durations shorter than 16 s survive a round trip through Time
+  /// (see toDuration()) exactly.
+  Time(const roo_time::Duration& duration)
+      : QuantityBase(internal::MicrosToSeconds(duration.inMicros())) {}
 
   /// Returns the time in seconds.
-  float inSeconds() const { return time_; }
+  constexpr float inSeconds() const { return value_; }
 
   /// Returns the time in milliseconds.
-  float inMilliseconds() const { return time_ * 1000.0f; }
+  constexpr float inMilliseconds() const { return value_ * 1000.0f; }
 
   /// Returns the time in microseconds.
-  float inMicroseconds() const { return time_ * 1000000.0f; }
+  constexpr float inMicroseconds() const { return value_ * 1000000.0f; }
 
   /// Returns the time in nanoseconds.
-  float inNanoseconds() const { return time_ * 1000000000.0f; }
-
-  /// Returns whether the object represents an unknown time.
-  bool isUnknown() const { return std::isnan(time_); }
-
-  bool operator<(const Time& other) const { return time_ < other.time_; }
-
-  bool operator==(const Time& other) const { return time_ == other.time_; }
-
-  bool operator>(const Time& other) const { return other.time_ < time_; }
-
-  bool operator<=(const Time& other) const { return !(other.time_ < time_); }
-
-  bool operator>=(const Time& other) const { return !(time_ < other.time_); }
-
-  bool operator!=(const Time& other) const { return !(time_ == other.time_); }
-
-  inline Time& operator+=(const Time& other) {
-    time_ += other.inSeconds();
-    return *this;
+  constexpr float inNanoseconds() const { return value_ * 1000000000.0f; }
+
+  /// Returns the time as roo_time::Duration, rounded to the nearest
+  /// microsecond. Converting back to Time yields the original value whenever
+  /// the time is at least 16 s; shorter times are below the microsecond
+  /// resolution of Duration. Unknown time converts to zero.
+  roo_time::Duration toDuration() const {
+    return roo_time::Micros(internal::SecondsToMicros(value_));
   }
 
-  inline Time& operator-=(const Time& other) {
-    time_ -= other.inSeconds();
-    return *this;
-  }
-
-  inline Time& operator*=(float multi) {
-    time_ *= multi;
-    return *this;
-  }
-
-  inline Time& operator/=(float div) {
-    time_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the time into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the time.
@@ -83,75 +126,169 @@ class Time {
 #endif
 
  private:
-  friend Time UnknownTime();
-
-  friend Time TimeInSeconds(float);
+  friend constexpr Time UnknownTime();
 
-  explicit Time(float time) : time_(time) {}
+  friend constexpr Time TimeInSeconds(float);
 
-  /// Stored in seconds.
-  float time_;
+  explicit constexpr Time(float time) : QuantityBase(time) {}
 };
 
-inline Time TimeInSeconds(float time);
+constexpr Time TimeInSeconds(float time);
 
 /// Returns a time object representing an unknown time.
-inline Time UnknownTime() { return Time(); }
+constexpr Time UnknownTime() { return Time(); }
 
 /// Returns a time object equivalent to the specified time
 /// expressed in minutes (60 seconds).
-inline Time TimeInMinutes(float time) { return TimeInSeconds(time * 60.0f); }
+constexpr Time TimeInMinutes(float time) { return TimeInSeconds(time * 60.0f); }
 
 /// Returns a time object equivalent to the specified time
 /// expressed in hours (3600 seconds).
-inline Time TimeInHours(float time) { return TimeInSeconds(time * 3600.0f); }
+constexpr Time TimeInHours(float time) { return TimeInSeconds(time * 3600.0f); }
 
 /// Returns a time object equivalent to the specified time
 /// expressed in seconds.
-inline Time TimeInSeconds(float time) { return Time(time); }
+constexpr Time TimeInSeconds(float time) { return Time(time); }
 
 /// Returns a time object equivalent to the specified time
 /// expressed in milliseconds.
-inline Time TimeInMilliseconds(float time) {
+constexpr Time TimeInMilliseconds(float time) {
   return TimeInSeconds(time * 0.001f);
 }
 
 /// Returns a time object equivalent to the specified time
 /// expressed in microseconds.
-inline Time TimeInMicroseconds(float time) {
+constexpr Time TimeInMicroseconds(float time) {
   return TimeInSeconds(time * 0.000001f);
 }
 
 /// Returns a time object equivalent to the specified time
 /// expressed in nanoseconds.
-inline Time TimeInNanoseconds(float time) {
+constexpr Time TimeInNanoseconds(float time) {
   return TimeInSeconds(time * 0.000000001f);
 }
 
-inline Time operator+(Time a, Time b) {
-  return TimeInSeconds(a.inSeconds() + b.inSeconds());
+/// Returns the time elapsed between the two uptime readings.
+inline Time TimeElapsed(roo_time::Uptime start, roo_time::Uptime end) {
+  return Time(end - start);
 }
 
-inline Time operator-(Time a, Time b) {
-  return TimeInSeconds(a.inSeconds() - b.inSeconds());
+/// Returns the time elapsed since the specified uptime reading.
+inline Time TimeSince(roo_time::Uptime start) {
+  return TimeElapsed(start, roo_time::Uptime::Now());
 }
 
-inline Time operator-(Time a) { return TimeInSeconds(-a.inSeconds()); }
+roo_logging::Stream& operator<<(roo_logging::Stream& os, const Time& val);
+
+/// Representation of time, internally stored as double-precision seconds.
+/// Use instead of Time where float precision is insufficient, e.g. for long-
+/// running accumulations. Converts implicitly from Time, and can be mixed with
+/// it in arithmetic; the results are double-precision.
+class DoubleTime
+    : public internal::QuantityBase<DoubleTime, dimension::Time, double> {
+ public:
+  /// Creates a time object representing an 'unknown' time.
+  constexpr DoubleTime() = default;
 
-inline Time operator*(Time a, float b) {
-  return TimeInSeconds(a.inSeconds() * b);
+  /// Converts from the single-precision time. The conversion is exact.
+  constexpr DoubleTime(const Time& time)
+      : QuantityBase(static_cast<double>(time.inSiUnits())) {}
+
+  /// Converts from roo_time::Duration. The result is correctly rounded (the
+  /// double nearest to the duration) for durations up to 2^53 microseconds
+  /// (about 285 years). Unlike Time(Duration), this uses a floating-point
+  /// division.
+  DoubleTime(const roo_time::Duration& duration)
+      : QuantityBase(static_cast<double>(duration.inMicros()) /
+                     1000000.0) {}
+
+  /// Returns the time in seconds.
+  constexpr double inSeconds() const { return value_; }
+
+  /// Returns the time in milliseconds.
+  constexpr double inMilliseconds() const { return value_ * 1000.0; }
+
+  /// Returns the time in microseconds.
+  constexpr double inMicroseconds() const { return value_ * 1000000.0; }
+
+  /// Returns the time in nanoseconds.
+  constexpr double inNanoseconds() const { return value_ * 1000000000.0; }
+
+  /// Returns the time as roo_time::Duration, rounded to the nearest
+  /// microsecond. Unknown time converts to zero.
+  roo_time::Duration toDuration() const {
+    if (isUnknown()) return roo_time::Micros(0);
+    return roo_time::Micros(std::llround(value_ * 1000000.0));
+  }
+
+  /// Returns the time, rounded to single precision.
+  constexpr Time toFloat() const {
+    return Time::FromSiUnits(static_cast<float>(value_));
+  }
+
+  /// Writes the string representation of the time into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+  /// Returns the string representation of the time.
+  std::string asString() const;
+#endif
+
+#if defined(ARDUINO)
+  String asArduinoString() const;
+#endif
+
+ private:
+  friend constexpr DoubleTime UnknownDoubleTime();
+
+  friend constexpr DoubleTime DoubleTimeInSeconds(double);
+
+  explicit constexpr DoubleTime(double time) : QuantityBase(time) {}
+};
+
+constexpr DoubleTime DoubleTimeInSeconds(double time);
+
+/// Returns a double-precision time object representing an unknown time.
+constexpr DoubleTime UnknownDoubleTime() { return DoubleTime(); }
+
+/// Returns a double-precision time object equivalent to the specified
+/// time expressed in hours (3600 seconds).
+constexpr DoubleTime DoubleTimeInHours(double time) {
+  return DoubleTimeInSeconds(time * 3600.0);
 }
 
-inline Time operator*(float a, Time b) {
-  return TimeInSeconds(a * b.inSeconds());
+/// Returns a double-precision time object equivalent to the specified
+/// time expressed in minutes (60 seconds).
+constexpr DoubleTime DoubleTimeInMinutes(double time) {
+  return DoubleTimeInSeconds(time * 60.0);
 }
 
-inline Time operator/(Time a, float b) {
-  return TimeInSeconds(a.inSeconds() / b);
+/// Returns a double-precision time object equivalent to the specified
+/// time expressed in seconds.
+constexpr DoubleTime DoubleTimeInSeconds(double time) {
+  return DoubleTime(time);
 }
 
-inline float operator/(Time a, Time b) { return a.inSeconds() / b.inSeconds(); }
+/// Returns a double-precision time object equivalent to the specified
+/// time expressed in milliseconds.
+constexpr DoubleTime DoubleTimeInMilliseconds(double time) {
+  return DoubleTimeInSeconds(time / 1000.0);
+}
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const Time& val);
+/// Returns a double-precision time object equivalent to the specified
+/// time expressed in microseconds.
+constexpr DoubleTime DoubleTimeInMicroseconds(double time) {
+  return DoubleTimeInSeconds(time / 1000000.0);
+}
+
+/// Returns a double-precision time object equivalent to the specified
+/// time expressed in nanoseconds.
+constexpr DoubleTime DoubleTimeInNanoseconds(double time) {
+  return DoubleTimeInSeconds(time / 1000000000.0);
+}
+
+roo_logging::Stream& operator<<(roo_logging::Stream& os, const DoubleTime& val);
 
 }  // namespace roo_quantity
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <limits>
+
+namespace roo_quantity {
+namespace internal {
+
+/// The quiet NaN used to represent 'unknown' quantities. Unlike
+/// std::nanf(""), it is a compile-time constant, so that constructing unknown
+/// quantities costs no more than a store.
+constexpr float kUnknownValue = std::numeric_limits<float>::quiet_NaN();
+
+static_assert(std::numeric_limits<float>::has_quiet_NaN,
+              "roo_quantity requires quiet NaN support");
+
+}  // namespace internal
+}  // namespace roo_quantity
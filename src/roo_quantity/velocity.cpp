@@ -1,48 +1,28 @@
 #include "roo_quantity/velocity.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void VelocityToString(Velocity val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? m/s", maxlen);
-  } else {
-    const char* format;
-    const char* sign = "";
-    float num;
-    if (val.inMetersPerSecond() == 0.0f) {
-      snprintf(out, maxlen, "0 m/s");
-      return;
-    }
-    if (val.inMetersPerSecond() < 0) {
-      sign = "-";
-      val = -val;
-    }
-    if (val >= VelocityInKilometersPerSecond(1.0f)) {
-      format = "%s%g km/s";
-      num = val.inKilometersPerSecond();
-    } else if (val >= VelocityInMetersPerSecond(1.0f)) {
-      format = "%s%g m/s";
-      num = val.inMetersPerSecond();
-    } else if (val >= VelocityInMillimetersPerSecond(1.0f)) {
-      format = "%s%g mm/s";
-      num = val.inMillimetersPerSecond();
-    } else {
-      format = "%s%g µm/s";
-      num = val.inMicrometersPerSecond();
-    }
-    snprintf(out, maxlen, format, sign, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kVelocityUnits[] = {
+    {1000.0f, 0.001f,     " km/s"},
+    {1.0f,    1.0f,       " m/s"},
+    {0.001f,  1000.0f,    " mm/s"},
+    {0.0f,    1000000.0f, " µm/s"},
+};
 
 }  // namespace
 
+size_t Velocity::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inMetersPerSecond(), kVelocityUnits, " m/s", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Velocity::asString() const {
-  char out[16];
-  VelocityToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -50,18 +30,13 @@ std::string Velocity::asString() const {
 #if defined(ARDUINO)
 
 String Velocity::asArduinoString() const {
-  char out[16];
-  VelocityToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Velocity& val) {
-  char out[16];
-  VelocityToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
 #include "roo_quantity/length.h"
 #include "roo_quantity/time.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -19,83 +21,42 @@ namespace roo_quantity {
 
 /// Representation of velocity, internally stored as floating-point meters per
 /// second.
-class Velocity {
+class Velocity
+    : public internal::QuantityBase<Velocity, dimension::Velocity, float> {
  public:
   /// Creates a velocity object representing an 'unknown' velocity.
-  Velocity() : velocity_(std::nanf("")) {}
+  constexpr Velocity() = default;
 
   /// Returns the velocity in kilometers per second.
-  float inKilometersPerSecond() const { return velocity_ * 0.001f; }
+  constexpr float inKilometersPerSecond() const { return value_ * 0.001f; }
 
   /// Returns the velocity in kilometers per hour.
-  float inKilometersPerHour() const { return velocity_ * 3.6f; }
+  constexpr float inKilometersPerHour() const { return value_ * 3.6f; }
 
   /// Returns the velocity in kilometers per hour.
-  float inKph() const { return inKilometersPerHour(); }
+  constexpr float inKph() const { return inKilometersPerHour(); }
 
   /// Returns the velocity in meters per second.
-  float inMetersPerSecond() const { return velocity_; }
+  constexpr float inMetersPerSecond() const { return value_; }
 
   /// Returns the velocity in millimeters per second.
-  float inMillimetersPerSecond() const { return velocity_ * 1000.0f; }
+  constexpr float inMillimetersPerSecond() const { return value_ * 1000.0f; }
 
   /// Returns the velocity in micrometers per second.
-  float inMicrometersPerSecond() const { return velocity_ * 1000000.0f; }
+  constexpr float inMicrometersPerSecond() const { return value_ * 1000000.0f; }
 
   /// Returns the velocity in miles per hour.
-  float inMilesPerHour() const { return velocity_ * 2.2369362921f; }
+  constexpr float inMilesPerHour() const { return value_ * 2.2369362921f; }
 
   /// Returns the velocity in miles per hour.
-  float inMph() const { return inMilesPerHour(); }
+  constexpr float inMph() const { return inMilesPerHour(); }
 
-  float inKnots() const { return velocity_ * 1.9438444924f; }
+  constexpr float inKnots() const { return value_ * 1.9438444924f; }
 
-  /// Returns whether the object represents an unknown velocity.
-  bool isUnknown() const { return std::isnan(velocity_); }
-
-  bool operator<(const Velocity& other) const {
-    return velocity_ < other.velocity_;
-  }
-
-  bool operator==(const Velocity& other) const {
-    return velocity_ == other.velocity_;
-  }
-
-  bool operator>(const Velocity& other) const {
-    return other.velocity_ < velocity_;
-  }
-
-  bool operator<=(const Velocity& other) const {
-    return !(other.velocity_ < velocity_);
-  }
-
-  bool operator>=(const Velocity& other) const {
-    return !(velocity_ < other.velocity_);
-  }
-
-  bool operator!=(const Velocity& other) const {
-    return !(velocity_ == other.velocity_);
-  }
-
-  inline Velocity& operator+=(const Velocity& other) {
-    velocity_ += other.inMetersPerSecond();
-    return *this;
-  }
-
-  inline Velocity& operator-=(const Velocity& other) {
-    velocity_ -= other.inMetersPerSecond();
-    return *this;
-  }
-
-  inline Velocity& operator*=(float multi) {
-    velocity_ *= multi;
-    return *this;
-  }
-
-  inline Velocity& operator/=(float div) {
-    velocity_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the velocity into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the velocity.
@@ -107,111 +68,68 @@ class Velocity {
 #endif
 
  private:
-  friend Velocity UnknownVelocity();
+  friend constexpr Velocity UnknownVelocity();
 
-  friend Velocity VelocityInMetersPerSecond(float);
+  friend constexpr Velocity VelocityInMetersPerSecond(float);
 
-  explicit Velocity(float velocity) : velocity_(velocity) {}
-
-  /// Stored in MetersPerSecond.
-  float velocity_;
+  explicit constexpr Velocity(float velocity) : QuantityBase(velocity) {}
 };
 
-inline Velocity VelocityInMetersPerSecond(float velocity);
+constexpr Velocity VelocityInMetersPerSecond(float velocity);
 
 /// Returns a velocity object representing an unknown velocity.
-inline Velocity UnknownVelocity() { return Velocity(); }
+constexpr Velocity UnknownVelocity() { return Velocity(); }
 
 /// Returns a velocity object equivalent to the specified velocity
 /// expressed in kilometers per second.
-inline Velocity VelocityInKilometersPerSecond(float velocity) {
+constexpr Velocity VelocityInKilometersPerSecond(float velocity) {
   return VelocityInMetersPerSecond(velocity * 1000.0f);
 }
 
 /// Returns a velocity object equivalent to the specified velocity
 /// expressed in meters per second.
-inline Velocity VelocityInMetersPerSecond(float velocity) {
+constexpr Velocity VelocityInMetersPerSecond(float velocity) {
   return Velocity(velocity);
 }
 
 /// Returns a velocity object equivalent to the specified velocity
 /// expressed in millimeters per second.
-inline Velocity VelocityInMillimetersPerSecond(float velocity) {
+constexpr Velocity VelocityInMillimetersPerSecond(float velocity) {
   return VelocityInMetersPerSecond(velocity * 0.001f);
 }
 
 /// Returns a velocity object equivalent to the specified velocity
 /// expressed in micrometers per second.
-inline Velocity VelocityInMicrometersPerSecond(float velocity) {
+constexpr Velocity VelocityInMicrometersPerSecond(float velocity) {
   return VelocityInMetersPerSecond(velocity * 0.000001f);
 }
 
 /// Returns a velocity object equivalent to the specified velocity
 /// expressed in kilometers per hour.
-inline Velocity VelocityInKilometersPerHour(float velocity) {
+constexpr Velocity VelocityInKilometersPerHour(float velocity) {
   return VelocityInMetersPerSecond(velocity * 0.2777777778f);
 }
 
-inline Velocity VelocityInKph(float velocity) {
+constexpr Velocity VelocityInKph(float velocity) {
   return VelocityInKilometersPerHour(velocity);
 }
 
 /// Returns a velocity object equivalent to the specified velocity
 /// expressed in miles per hour.
-inline Velocity VelocityInMilesPerHour(float velocity) {
+constexpr Velocity VelocityInMilesPerHour(float velocity) {
   return VelocityInMetersPerSecond(velocity * 0.44704f);
 }
 
-inline Velocity VelocityInMph(float velocity) {
+constexpr Velocity VelocityInMph(float velocity) {
   return VelocityInMilesPerHour(velocity);
 }
 
-inline Velocity operator+(Velocity a, Velocity b) {
-  return VelocityInMetersPerSecond(a.inMetersPerSecond() +
-                                   b.inMetersPerSecond());
-}
-
-inline Velocity operator-(Velocity a, Velocity b) {
-  return VelocityInMetersPerSecond(a.inMetersPerSecond() -
-                                   b.inMetersPerSecond());
-}
-
-inline Velocity operator-(Velocity a) {
-  return VelocityInMetersPerSecond(-a.inMetersPerSecond());
-}
-
-inline Velocity operator*(Velocity a, float b) {
-  return VelocityInMetersPerSecond(a.inMetersPerSecond() * b);
-}
-
-inline Velocity operator*(float a, Velocity b) {
-  return VelocityInMetersPerSecond(a * b.inMetersPerSecond());
-}
-
-inline Velocity operator/(Velocity a, float b) {
-  return VelocityInMetersPerSecond(a.inMetersPerSecond() / b);
-}
-
-inline float operator/(Velocity a, Velocity b) {
-  return a.inMetersPerSecond() / b.inMetersPerSecond();
-}
-
-/// Vs time.
-
-inline Length operator*(Velocity a, Time b) {
-  return LengthInMeters(a.inMetersPerSecond() * b.inSeconds());
-}
-
-inline Length operator*(Time a, Velocity b) {
-  return LengthInMeters(a.inSeconds() * b.inMetersPerSecond());
-}
-
-inline Velocity operator/(Length a, Time b) {
-  return VelocityInMetersPerSecond(a.inMeters() / b.inSeconds());
-}
-
-inline Time operator/(Length a, Velocity b) {
-  return TimeInSeconds(a.inMeters() / b.inMetersPerSecond());
+/// Returns the average velocity of covering the specified distance over the
+/// specified time interval.
+inline Velocity VelocityFromDistance(const Length& distance,
+                                     const roo_time::Duration& interval) {
+  return VelocityInMetersPerSecond(distance.inMeters() * 1000000.0f /
+                                   static_cast<float>(interval.inMicros()));
 }
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Velocity& val);
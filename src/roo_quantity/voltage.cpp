@@ -1,22 +1,18 @@
 #include "roo_quantity/voltage.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void VoltageToString(const Voltage& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inVolts(), "V", out, maxlen);
+size_t Voltage::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inVolts(), "V", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Voltage::asString() const {
-  char out[16];
-  VoltageToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,13 @@ std::string Voltage::asString() const {
 #if defined(ARDUINO)
 
 String Voltage::asArduinoString() const {
-  char out[16];
-  VoltageToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Voltage& val) {
-  char out[16];
-  VoltageToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,45 +1,30 @@
 #include "roo_quantity/volume.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void VolumeToString(const Volume& val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? m³", maxlen);
-  } else {
-    const char* format;
-    float num;
-    if (val > VolumeInCubicKilometers(1.0f)) {
-      format = "%g km³";
-      num = val.inCubicKilometers();
-    } else if (val > VolumeInCubicMeters(1.0f)) {
-      format = "%g m³";
-      num = val.inCubicMeters();
-    } else if (val > VolumeInCubicDecimeters(1.0f)) {
-      format = "%g dm³";
-      num = val.inCubicDecimeters();
-    } else if (val > VolumeInMilliliters(1.0f)) {
-      format = "%g ml";
-      num = val.inMilliliters();
-    } else if (val > VolumeInCubicMillimeters(1.0f)) {
-      format = "%g mm³";
-      num = val.inCubicMillimeters();
-    } else {
-      format = "%g µm³";
-      num = val.inCubicMicrometers();
-    }
-    snprintf(out, maxlen, format, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kVolumeUnits[] = {
+    {1000000000.0f, 0.000000001f,           " km³"},
+    {1.0f,          1.0f,                   " m³"},
+    {0.001f,        1000.0f,                " dm³"},
+    {0.000001f,     1000000.0f,             " ml"},
+    {0.000000001f,  1000000000.0f,          " mm³"},
+    {0.0f,          1000000000000000000.0f, " µm³"},
+};
 
 }  // namespace
 
+size_t Volume::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inCubicMeters(), kVolumeUnits, " m³", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Volume::asString() const {
-  char out[16];
-  VolumeToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -47,18 +32,13 @@ std::string Volume::asString() const {
 #if defined(ARDUINO)
 
 String Volume::asArduinoString() const {
-  char out[16];
-  VolumeToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Volume& val) {
-  char out[16];
-  VolumeToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
 #include "roo_quantity/area.h"
 #include "roo_quantity/length.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -18,83 +20,47 @@
 namespace roo_quantity {
 
 /// Representation of volume, internally stored as floating-point cubic meters.
-class Volume {
+class Volume : public internal::QuantityBase<Volume, dimension::Volume, float> {
  public:
   /// Creates a volume object representing an 'unknown' volume.
-  Volume() : volume_(std::nanf("")) {}
+  constexpr Volume() = default;
 
   /// Returns the volume in cubic kilometers.
-  float inCubicKilometers() const { return volume_ * 0.000000001f; }
+  constexpr float inCubicKilometers() const { return value_ * 0.000000001f; }
 
   /// Returns the volume in cubic meters.
-  float inCubicMeters() const { return volume_; }
+  constexpr float inCubicMeters() const { return value_; }
 
   /// Returns the volume in liters.
-  float inLiters() const { return volume_ * 1000.0f; }
+  constexpr float inLiters() const { return value_ * 1000.0f; }
 
   /// Returns the volume in liters.
-  float inCubicDecimeters() const { return inLiters(); }
+  constexpr float inCubicDecimeters() const { return inLiters(); }
 
   /// Returns the volume in milliliters.
-  float inMilliliters() const { return volume_ * 1000000.0f; }
+  constexpr float inMilliliters() const { return value_ * 1000000.0f; }
 
   /// Returns the volume in milliliters.
-  float inCubicCentimeters() const { return inMilliliters(); }
+  constexpr float inCubicCentimeters() const { return inMilliliters(); }
 
   /// Returns the volume in microliters.
-  float inMicroliters() const { return volume_ * 1000000000.0f; }
+  constexpr float inMicroliters() const { return value_ * 1000000000.0f; }
 
   /// Returns the volume in microliters.
-  float inCubicMillimeters() const { return inMicroliters(); }
+  constexpr float inCubicMillimeters() const { return inMicroliters(); }
 
   /// Returns the volume in cubic micrometers.
-  float inCubicMicrometers() const { return volume_ * 1000000000000000000.0f; }
-
-  /// Returns the volume in cubic inches.
-  float inCubicInches() const { return volume_ * 61023.744095f; }
-
-  /// Returns whether the object represents an unknown volume.
-  bool isUnknown() const { return std::isnan(volume_); }
-
-  bool operator<(const Volume &other) const { return volume_ < other.volume_; }
-
-  bool operator==(const Volume &other) const {
-    return volume_ == other.volume_;
+  constexpr float inCubicMicrometers() const {
+    return value_ * 1000000000000000000.0f;
   }
 
-  bool operator>(const Volume &other) const { return other.volume_ < volume_; }
-
-  bool operator<=(const Volume &other) const {
-    return !(other.volume_ < volume_);
-  }
-
-  bool operator>=(const Volume &other) const {
-    return !(volume_ < other.volume_);
-  }
-
-  bool operator!=(const Volume &other) const {
-    return !(volume_ == other.volume_);
-  }
-
-  inline Volume &operator+=(const Volume &other) {
-    volume_ += other.inCubicMeters();
-    return *this;
-  }
-
-  inline Volume &operator-=(const Volume &other) {
-    volume_ -= other.inCubicMeters();
-    return *this;
-  }
-
-  inline Volume &operator*=(float multi) {
-    volume_ *= multi;
-    return *this;
-  }
+  /// Returns the volume in cubic inches.
+  constexpr float inCubicInches() const { return value_ * 61023.744095f; }
 
-  inline Volume &operator/=(float div) {
-    volume_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the volume into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char *out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the volume.
@@ -106,117 +72,70 @@ class Volume {
 #endif
 
  private:
-  friend Volume UnknownVolume();
+  friend constexpr Volume UnknownVolume();
 
-  friend Volume VolumeInCubicMeters(float);
+  friend constexpr Volume VolumeInCubicMeters(float);
 
-  explicit Volume(float volume) : volume_(volume) {}
-
-  /// Stored in cubic meters.
-  float volume_;
+  explicit constexpr Volume(float volume) : QuantityBase(volume) {}
 };
 
-inline Volume VolumeInCubicMeters(float volume);
+constexpr Volume VolumeInCubicMeters(float volume);
 
 /// Returns a volume object representing an unknown volume.
-inline Volume UnknownVolume() { return Volume(); }
+constexpr Volume UnknownVolume() { return Volume(); }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in cubic kilometers.
-inline Volume VolumeInCubicKilometers(float volume) {
+constexpr Volume VolumeInCubicKilometers(float volume) {
   return VolumeInCubicMeters(volume * 1000000000.0f);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in cubic meters.
-inline Volume VolumeInCubicMeters(float volume) { return Volume(volume); }
+constexpr Volume VolumeInCubicMeters(float volume) { return Volume(volume); }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in liters.
-inline Volume VolumeInLiters(float volume) {
+constexpr Volume VolumeInLiters(float volume) {
   return VolumeInCubicMeters(volume * 0.001f);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in liters.
-inline Volume VolumeInCubicDecimeters(float volume) {
+constexpr Volume VolumeInCubicDecimeters(float volume) {
   return VolumeInLiters(volume);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in milliliters.
-inline Volume VolumeInMilliliters(float volume) {
+constexpr Volume VolumeInMilliliters(float volume) {
   return VolumeInCubicMeters(volume * 0.000001f);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in milliliters.
-inline Volume VolumeInCubicCentimeters(float volume) {
+constexpr Volume VolumeInCubicCentimeters(float volume) {
   return VolumeInMilliliters(volume);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in cubic millimeters.
-inline Volume VolumeInCubicMillimeters(float volume) {
+constexpr Volume VolumeInCubicMillimeters(float volume) {
   return VolumeInCubicMeters(volume * 0.000000001f);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in cubic micrometers.
-inline Volume VolumeInCubicMicrometers(float volume) {
+constexpr Volume VolumeInCubicMicrometers(float volume) {
   return VolumeInCubicMeters(volume * 0.000000000000000001f);
 }
 
 /// Returns a volume object equivalent to the specified volume
 /// expressed in cubic inches.
-inline Volume VolumeInCubicInches(float volume) {
+constexpr Volume VolumeInCubicInches(float volume) {
   return VolumeInCubicMeters(volume * 1.6387e-5f);
 }
 
-inline Volume operator+(Volume a, Volume b) {
-  return VolumeInCubicMeters(a.inCubicMeters() + b.inCubicMeters());
-}
-
-inline Volume operator-(Volume a, Volume b) {
-  return VolumeInCubicMeters(a.inCubicMeters() - b.inCubicMeters());
-}
-
-inline Volume operator-(Volume a) {
-  return VolumeInCubicMeters(-a.inCubicMeters());
-}
-
-inline Volume operator*(Volume a, float b) {
-  return VolumeInCubicMeters(a.inCubicMeters() * b);
-}
-
-inline Volume operator*(float a, Volume b) {
-  return VolumeInCubicMeters(a * b.inCubicMeters());
-}
-
-inline Volume operator/(Volume a, float b) {
-  return VolumeInCubicMeters(a.inCubicMeters() / b);
-}
-
-inline float operator/(Volume a, Volume b) {
-  return a.inCubicMeters() / b.inCubicMeters();
-}
-
-inline Volume operator*(Length a, Area b) {
-  return VolumeInCubicMeters(a.inMeters() * b.inSquareMeters());
-}
-
-inline Volume operator*(Area a, Length b) {
-  return VolumeInCubicMeters(a.inSquareMeters() * b.inMeters());
-}
-
-inline Area operator/(Volume a, Length b) {
-  return AreaInSquareMeters(a.inCubicMeters() / b.inMeters());
-}
-
-inline Length operator/(Volume a, Area b) {
-  return LengthInMeters(a.inCubicMeters() / b.inSquareMeters());
-}
-
 roo_logging::Stream &operator<<(roo_logging::Stream &os, const Volume &val);
 
 }  // namespace roo_quantity
\ No newline at end of file
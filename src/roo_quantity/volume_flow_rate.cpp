@@ -1,36 +1,27 @@
 #include "roo_quantity/volume_flow_rate.h"
 
+#include "roo_quantity/format.h"
+
 namespace roo_quantity {
 namespace {
 
-void VolumeFlowRateToString(const VolumeFlowRate& val, char* out, int maxlen) {
-  if (val.isUnknown()) {
-    strncpy(out, "? m³/s", maxlen);
-  } else {
-    const char* format;
-    float num;
-    if (val > VolumeFlowRateInCubicMetersPerSecond(1.0f)) {
-      format = "%g m³/s";
-      num = val.inCubicMetersPerSecond();
-    } else if (val > VolumeFlowRateInLitersPerSecond(1.0f)) {
-      format = "%g L/s";
-      num = val.inLitersPerSecond();
-    } else {
-      format = "%g mL/s";
-      num = val.inMillilitersPerSecond();
-    }
-    snprintf(out, maxlen, format, num);
-  }
-}
+// Units to pretty-print in, by decreasing magnitude threshold (in base units).
+constexpr UnitFormat kVolumeFlowRateUnits[] = {
+    {1.0f,   1.0f,       " m³/s"},
+    {0.001f, 1000.0f,    " L/s"},
+    {0.0f,   1000000.0f, " mL/s"},
+};
 
 }  // namespace
 
+size_t VolumeFlowRate::formatTo(char* out, size_t maxlen) const {
+  return FormatInUnits(inCubicMetersPerSecond(), kVolumeFlowRateUnits, " m³/s", out, maxlen);
+}
+
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string VolumeFlowRate::asString() const {
-  char out[16];
-  VolumeFlowRateToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -38,18 +29,14 @@ std::string VolumeFlowRate::asString() const {
 #if defined(ARDUINO)
 
 String VolumeFlowRate::asArduinoString() const {
-  char out[16];
-  VolumeFlowRateToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const VolumeFlowRate& val) {
-  char out[16];
-  VolumeFlowRateToString(val, out, 16);
-  os << out;
-  return os;
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const VolumeFlowRate& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
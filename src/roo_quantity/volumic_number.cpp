@@ -1,22 +1,20 @@
 #include "roo_quantity/volumic_number.h"
 
-#include "roo_quantity/si.h"
+#include "roo_quantity/format.h"
 
 namespace roo_quantity {
-namespace {
 
-void VolumicNumberToString(const VolumicNumber& val, char* out, int maxlen) {
-  snprintf(out, maxlen, "%.6g/m³", val.inUnitsPerCubicMeter());
+size_t VolumicNumber::formatTo(char* out, size_t maxlen) const {
+  internal::StringWriter writer(out, maxlen);
+  writer.appendFloat(inUnitsPerCubicMeter());
+  writer.append("/m³");
+  return writer.finish();
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string VolumicNumber::asString() const {
-  char out[16];
-  VolumicNumberToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,19 +22,14 @@ std::string VolumicNumber::asString() const {
 #if defined(ARDUINO)
 
 String VolumicNumber::asArduinoString() const {
-  char out[16];
-  VolumicNumberToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os,
                                 const VolumicNumber& val) {
-  char out[16];
-  VolumicNumberToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
 #include "roo_quantity/areic_number.h"
+#include "roo_quantity/quantity.h"
 #include "roo_quantity/volume.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
@@ -19,100 +21,72 @@ namespace roo_quantity {
 
 /// Representation of volumic number, a reciprocal of volume, internally
 /// stored as floating-point units per cubic meter.
-class VolumicNumber {
+class VolumicNumber
+    : public internal::QuantityBase<VolumicNumber, dimension::VolumicNumber,
+                                    float> {
  public:
   /// Creates an volumic number object representing an 'unknown'
   /// volumic number.
-  VolumicNumber() : volumic_number_(std::nanf("")) {}
+  constexpr VolumicNumber() = default;
 
   /// Returns the volumic number in GigaUnitsPerCubicMeter.
-  float inGigaUnitsPerCubicMeter() const {
-    return volumic_number_ * 0.000000001f;
+  constexpr float inGigaUnitsPerCubicMeter() const {
+    return value_ * 0.000000001f;
   }
 
   /// Returns the volumic number in Mega-units per cubic meter.
-  float inMegaUnitsPerCubicMeter() const { return volumic_number_ * 0.000001f; }
+  constexpr float inMegaUnitsPerCubicMeter() const {
+    return value_ * 0.000001f;
+  }
 
   /// Returns the volumic number in kilo-units per cubic meter.
-  float inKiloUnitsPerCubicMeter() const { return volumic_number_ * 0.001f; }
+  constexpr float inKiloUnitsPerCubicMeter() const { return value_ * 0.001f; }
 
   /// Returns the volumic number in units per cubic meter.
-  float inUnitsPerCubicMeter() const { return volumic_number_; }
+  constexpr float inUnitsPerCubicMeter() const { return value_; }
 
   /// Returns the volumic number in milli-units per cubic meter.
-  float inMilliUnitsPerCubicMeter() const { return volumic_number_ * 1000.0f; }
+  constexpr float inMilliUnitsPerCubicMeter() const { return value_ * 1000.0f; }
 
   /// Returns the volumic number in micro-units per cubic meter.
-  float inMicroUnitsPerCubicMeter() const {
-    return volumic_number_ * 1000000.0f;
+  constexpr float inMicroUnitsPerCubicMeter() const {
+    return value_ * 1000000.0f;
   }
 
   /// Returns the volumic number in units per cubic decimeter (liter).
-  float inUnitsPerCubicDecimeter() const { return volumic_number_ * 0.001f; }
+  constexpr float inUnitsPerCubicDecimeter() const { return value_ * 0.001f; }
 
   /// Returns the volumic number in units per cubic decimeter (liter).
-  float inUnitsPerLiter() const { return inUnitsPerCubicDecimeter(); }
+  constexpr float inUnitsPerLiter() const { return inUnitsPerCubicDecimeter(); }
 
   /// Returns the volumic number in units per cubic centimeter.
-  float inUnitsPerCubicCentimeter() const {
-    return volumic_number_ * 0.000001f;
+  constexpr float inUnitsPerCubicCentimeter() const {
+    return value_ * 0.000001f;
   }
 
   /// Returns the volumic number in units per cubic millimeter.
-  float inUnitsPerCubicMillimeter() const {
-    return volumic_number_ * 0.000000001f;
+  constexpr float inUnitsPerCubicMillimeter() const {
+    return value_ * 0.000000001f;
   }
 
   /// Returns the volumic number in units per cubic kilometer.
-  float inUnitsPerCubicKilometer() const {
-    return volumic_number_ * 1000000000.0f;
+  constexpr float inUnitsPerCubicKilometer() const {
+    return value_ * 1000000000.0f;
   }
 
   /// Returns the volumic number in units per cubic inch.
-  float inUnitsPerCubicInch() const { return volumic_number_ * 1.6387064E-5f; }
+  constexpr float inUnitsPerCubicInch() const { return value_ * 1.6387064E-5f; }
 
   /// Returns the volumic number in units per cubic foot.
-  float inUnitsPerCubicFoot() const { return volumic_number_ * 0.0283168466f; }
+  constexpr float inUnitsPerCubicFoot() const { return value_ * 0.0283168466f; }
 
   /// Returns the volumic number in units per cubic yard.
-  float inUnitsPerCubicYard() const { return volumic_number_ * 0.764554858f; }
-
-  /// Returns whether the object represents an unknown volumic number.
-  bool isUnknown() const { return std::isnan(volumic_number_); }
-
-  bool operator<(const VolumicNumber &other) const {
-    return volumic_number_ < other.volumic_number_;
-  }
-
-  bool operator==(const VolumicNumber &other) const {
-    return volumic_number_ == other.volumic_number_;
-  }
-
-  bool operator>(const VolumicNumber &other) const {
-    return other.volumic_number_ < volumic_number_;
-  }
-
-  bool operator<=(const VolumicNumber &other) const {
-    return !(other.volumic_number_ < volumic_number_);
-  }
+  constexpr float inUnitsPerCubicYard() const { return value_ * 0.764554858f; }
 
-  bool operator>=(const VolumicNumber &other) const {
-    return !(volumic_number_ < other.volumic_number_);
-  }
-
-  bool operator!=(const VolumicNumber &other) const {
-    return !(volumic_number_ == other.volumic_number_);
-  }
-
-  VolumicNumber &operator*=(float multi) {
-    volumic_number_ *= multi;
-    return *this;
-  }
-
-  VolumicNumber &operator/=(float div) {
-    volumic_number_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the volumic number into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char *out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the volumic number.
@@ -124,156 +98,114 @@ class VolumicNumber {
 #endif
 
  private:
-  friend VolumicNumber UnknownVolumicNumber();
-
-  friend VolumicNumber VolumicNumberInUnitsPerCubicMeter(float);
+  friend constexpr VolumicNumber UnknownVolumicNumber();
 
-  explicit VolumicNumber(float volumic_number)
-      : volumic_number_(volumic_number) {}
+  friend constexpr VolumicNumber VolumicNumberInUnitsPerCubicMeter(float);
 
-  /// Stored in units per cubic meter.
-  float volumic_number_;
+  explicit constexpr VolumicNumber(float volumic_number)
+      : QuantityBase(volumic_number) {}
 };
 
-inline VolumicNumber VolumicNumberInUnitsPerCubicMeter(float volumic_number);
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicMeter(float volumic_number);
 
 /// Returns a volumic number object representing an unknown
 /// volumic number.
-inline VolumicNumber UnknownVolumicNumber() { return VolumicNumber(); }
+constexpr VolumicNumber UnknownVolumicNumber() { return VolumicNumber(); }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in giga-units per cubic meter.
-inline VolumicNumber VolumicNumberInGigaUnitsPerCubicMeter(
+constexpr VolumicNumber VolumicNumberInGigaUnitsPerCubicMeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1000000000.0f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in mega-units per cubic meter.
-inline VolumicNumber VolumicNumberInMegaUnitsPerCubicMeter(
+constexpr VolumicNumber VolumicNumberInMegaUnitsPerCubicMeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1000000.0f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in kilo-units per cubic meter.
-inline VolumicNumber VolumicNumberInKiloUnitsPerCubicMeter(
+constexpr VolumicNumber VolumicNumberInKiloUnitsPerCubicMeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1000.0f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic meter.
-inline VolumicNumber VolumicNumberInUnitsPerCubicMeter(float volumic_number) {
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicMeter(
+    float volumic_number) {
   return VolumicNumber(volumic_number);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in milli-units per cubic meter.
-inline VolumicNumber VolumicNumberInMilliUnitsPerCubicMeter(
+constexpr VolumicNumber VolumicNumberInMilliUnitsPerCubicMeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 0.001f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in micro-units per cubic meter.
-inline VolumicNumber VolumicNumberInMicroUnitsPerCubicMeter(
+constexpr VolumicNumber VolumicNumberInMicroUnitsPerCubicMeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 0.000001f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic decimeter (liter).
-inline VolumicNumber VolumicNumberInUnitsPerCubicDecimeter(
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicDecimeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1000.0f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic decimeter (liter).
-inline VolumicNumber VolumicNumberInUnitsPerLiter(float volumic_number) {
+constexpr VolumicNumber VolumicNumberInUnitsPerLiter(float volumic_number) {
   return VolumicNumberInUnitsPerCubicDecimeter(volumic_number);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic centimeter.
-inline VolumicNumber VolumicNumberInUnitsPerCubicCentimeter(
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicCentimeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1000000.0f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic millimeter.
-inline VolumicNumber VolumicNumberInUnitsPerCubicMillimeter(
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicMillimeter(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1000000000.0f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic kilometer.
-inline VolumicNumber VolumicNumberInUnitsPerCubicKilometer(
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicKilometer(
     float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 0.000000001f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic inch.
-inline VolumicNumber VolumicNumberInUnitsPerCubicInch(float volumic_number) {
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicInch(float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 61023.744094732f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic foot.
-inline VolumicNumber VolumicNumberInUnitsPerCubicFoot(float volumic_number) {
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicFoot(float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 35.3146667215f);
 }
 
 /// Returns a volumic number object equivalent to the specified
 /// volumic number expressed in units per cubic yard.
-inline VolumicNumber VolumicNumberInUnitsPerCubicYard(float volumic_number) {
+constexpr VolumicNumber VolumicNumberInUnitsPerCubicYard(float volumic_number) {
   return VolumicNumberInUnitsPerCubicMeter(volumic_number * 1.3079506193f);
 }
 
-inline VolumicNumber operator*(VolumicNumber a, float b) {
-  return VolumicNumberInUnitsPerCubicMeter(a.inUnitsPerCubicMeter() * b);
-}
-
-inline VolumicNumber operator*(float a, VolumicNumber b) {
-  return VolumicNumberInUnitsPerCubicMeter(a * b.inUnitsPerCubicMeter());
-}
-
-inline float operator*(Volume a, VolumicNumber b) {
-  return a.inCubicMeters() * b.inUnitsPerCubicMeter();
-}
-
-inline float operator*(VolumicNumber a, Volume b) {
-  return a.inUnitsPerCubicMeter() * b.inCubicMeters();
-}
-
-inline LineicNumber operator*(Length a, VolumicNumber b) {
-  return LineicNumberInUnitsPerMeter(a.inMeters() * b.inUnitsPerCubicMeter());
-}
-
-inline LineicNumber operator*(VolumicNumber a, Length b) {
-  return LineicNumberInUnitsPerMeter(a.inUnitsPerCubicMeter() * b.inMeters());
-}
-
-inline VolumicNumber operator/(VolumicNumber a, float b) {
-  return VolumicNumberInUnitsPerCubicMeter(a.inUnitsPerCubicMeter() / b);
-}
-
-inline float operator/(VolumicNumber a, VolumicNumber b) {
-  return a.inUnitsPerCubicMeter() / b.inUnitsPerCubicMeter();
-}
-
-inline Volume operator/(float a, VolumicNumber b) {
-  return VolumeInCubicMeters(a / b.inUnitsPerCubicMeter());
-}
-
-inline VolumicNumber operator/(float a, Volume b) {
-  return VolumicNumberInUnitsPerCubicMeter(a / b.inCubicMeters());
-}
-
 roo_logging::Stream& operator<<(roo_logging::Stream& os,
                                 const VolumicNumber& val);
 
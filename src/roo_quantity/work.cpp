@@ -1,22 +1,18 @@
 #include "roo_quantity/work.h"
 
+#include "roo_quantity/format.h"
 #include "roo_quantity/si.h"
 
 namespace roo_quantity {
-namespace {
 
-void WorkToString(const Work& val, char* out, int maxlen) {
-  FormatSimpleSiValue(val.inJoules(), "J", out, maxlen);
+size_t Work::formatTo(char* out, size_t maxlen) const {
+  return FormatSimpleSiValue(inJoules(), "J", out, maxlen);
 }
 
-}  // namespace
-
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 
 std::string Work::asString() const {
-  char out[16];
-  WorkToString(*this, out, 16);
-  return out;
+  return internal::FormatAsString(*this);
 }
 
 #endif
@@ -24,18 +20,38 @@ std::string Work::asString() const {
 #if defined(ARDUINO)
 
 String Work::asArduinoString() const {
-  char out[16];
-  WorkToString(*this, out, 16);
-  return out;
+  return internal::FormatAsArduinoString(*this);
 }
 
 #endif
 
 roo_logging::Stream& operator<<(roo_logging::Stream& os, const Work& val) {
-  char out[16];
-  WorkToString(val, out, 16);
-  os << out;
-  return os;
+  return internal::FormatToStream(os, val);
+}
+
+size_t DoubleWork::formatTo(char* out, size_t maxlen) const {
+  return toFloat().formatTo(out, maxlen);
+}
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+
+std::string DoubleWork::asString() const {
+  return internal::FormatAsString(*this);
+}
+
+#endif
+
+#if defined(ARDUINO)
+
+String DoubleWork::asArduinoString() const {
+  return internal::FormatAsArduinoString(*this);
+}
+
+#endif
+
+roo_logging::Stream& operator<<(roo_logging::Stream& os,
+                                const DoubleWork& val) {
+  return internal::FormatToStream(os, val);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+}  // namespace roo_quantity
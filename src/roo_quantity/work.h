@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 
 #include "roo_flags.h"
 #include "roo_logging.h"
+#include "roo_quantity/quantity.h"
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
 #include <string>
@@ -16,57 +18,27 @@
 namespace roo_quantity {
 
 /// Representation of work, internally stored as floating-point Joules.
-class Work {
+class Work : public internal::QuantityBase<Work, dimension::Work, float> {
  public:
   /// Creates a work object representing an 'unknown' work.
-  Work() : work_(std::nanf("")) {}
+  constexpr Work() = default;
 
   /// Returns the work in kilojoules.
-  float inKiloJoules() const { return work_ / 1000.0f; }
+  constexpr float inKiloJoules() const { return value_ / 1000.0f; }
 
   /// Returns the work in joules.
-  float inJoules() const { return work_; }
+  constexpr float inJoules() const { return value_; }
 
   /// Returns the work in millijoules.
-  float inMilliJoules() const { return work_ * 1000.0f; }
+  constexpr float inMilliJoules() const { return value_ * 1000.0f; }
 
   /// Returns the work in microjoules.
-  float inMicroJoules() const { return work_ * 1000000.0f; }
+  constexpr float inMicroJoules() const { return value_ * 1000000.0f; }
 
-  /// Returns whether the object represents an unknown work.
-  bool isUnknown() const { return std::isnan(work_); }
-
-  bool operator<(const Work& other) const { return work_ < other.work_; }
-
-  bool operator==(const Work& other) const { return work_ == other.work_; }
-
-  bool operator>(const Work& other) const { return other.work_ < work_; }
-
-  bool operator<=(const Work& other) const { return !(other.work_ < work_); }
-
-  bool operator>=(const Work& other) const { return !(work_ < other.work_); }
-
-  bool operator!=(const Work& other) const { return !(work_ == other.work_); }
-
-  inline Work& operator+=(const Work& other) {
-    work_ += other.inJoules();
-    return *this;
-  }
-
-  inline Work& operator-=(const Work& other) {
-    work_ -= other.inJoules();
-    return *this;
-  }
-
-  inline Work& operator*=(float multi) {
-    work_ *= multi;
-    return *this;
-  }
-
-  inline Work& operator/=(float div) {
-    work_ /= div;
-    return *this;
-  }
+  /// Writes the string representation of the work into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
 
 #if defined(ESP32) || defined(ESP8266) || defined(__linux__)
   /// Returns the string representation of the work.
@@ -78,79 +50,148 @@ class Work {
 #endif
 
  private:
-  friend Work UnknownWork();
-
-  friend Work WorkInJoules(float);
+  friend constexpr Work UnknownWork();
 
-  explicit Work(float work) : work_(work) {}
+  friend constexpr Work WorkInJoules(float);
 
-  /// Stored in joules.
-  float work_;
+  explicit constexpr Work(float work) : QuantityBase(work) {}
 };
 
-inline Work WorkInJoules(float work);
+constexpr Work WorkInJoules(float work);
 
 /// Returns a work object representing an unknown work.
-inline Work UnknownWork() { return Work(); }
+constexpr Work UnknownWork() { return Work(); }
 
 /// Returns a work object equivalent to the specified work
 /// expressed in gigaJoules.
-inline Work WorkInGigaJoules(float work) {
+constexpr Work WorkInGigaJoules(float work) {
   return WorkInJoules(work * 1000000000.0f);
 }
 
 /// Returns a work object equivalent to the specified work
 /// expressed in megaJoules.
-inline Work WorkInMegaJoules(float work) {
+constexpr Work WorkInMegaJoules(float work) {
   return WorkInJoules(work * 1000000.0f);
 }
 
 /// Returns a work object equivalent to the specified work
 /// expressed in kiloJoules.
-inline Work WorkInKiloJoules(float work) {
+constexpr Work WorkInKiloJoules(float work) {
   return WorkInJoules(work * 1000.0f);
 }
 
 /// Returns a work object equivalent to the specified work
 /// expressed in Joules.
-inline Work WorkInJoules(float work) { return Work(work); }
+constexpr Work WorkInJoules(float work) { return Work(work); }
 
 /// Returns a work object equivalent to the specified work
 /// expressed in milliJoules.
-inline Work WorkInMilliJoules(float work) {
+constexpr Work WorkInMilliJoules(float work) {
   return WorkInJoules(work / 1000.0f);
 }
 
 /// Returns a work object equivalent to the specified work
 /// expressed in microJoules.
-inline Work WorkInMicroJoules(float work) {
+constexpr Work WorkInMicroJoules(float work) {
   return WorkInJoules(work / 1000000.0f);
 }
 
-inline Work operator+(Work a, Work b) {
-  return WorkInJoules(a.inJoules() + b.inJoules());
-}
+roo_logging::Stream& operator<<(roo_logging::Stream& os, const Work& val);
+
+/// Representation of work, internally stored as double-precision Joules.
+/// Use instead of Work where float precision is insufficient, e.g. for long-
+/// running accumulations. Converts implicitly from Work, and can be mixed with
+/// it in arithmetic; the results are double-precision.
+class DoubleWork
+    : public internal::QuantityBase<DoubleWork, dimension::Work, double> {
+ public:
+  /// Creates a work object representing an 'unknown' work.
+  constexpr DoubleWork() = default;
+
+  /// Converts from the single-precision work. The conversion is exact.
+  constexpr DoubleWork(const Work& work)
+      : QuantityBase(static_cast<double>(work.inSiUnits())) {}
+
+  /// Returns the work in kiloJoules.
+  constexpr double inKiloJoules() const { return value_ / 1000.0; }
+
+  /// Returns the work in Joules.
+  constexpr double inJoules() const { return value_; }
+
+  /// Returns the work in milliJoules.
+  constexpr double inMilliJoules() const { return value_ * 1000.0; }
 
-inline Work operator-(Work a, Work b) {
-  return WorkInJoules(a.inJoules() - b.inJoules());
+  /// Returns the work in microJoules.
+  constexpr double inMicroJoules() const { return value_ * 1000000.0; }
+
+  /// Returns the work, rounded to single precision.
+  constexpr Work toFloat() const {
+    return Work::FromSiUnits(static_cast<float>(value_));
+  }
+
+  /// Writes the string representation of the work into `out`, as a
+  /// null-terminated string of at most `maxlen` bytes. Returns the number of
+  /// characters written, excluding the terminating null. Does not allocate.
+  size_t formatTo(char* out, size_t maxlen) const;
+
+#if defined(ESP32) || defined(ESP8266) || defined(__linux__)
+  /// Returns the string representation of the work.
+  std::string asString() const;
+#endif
+
+#if defined(ARDUINO)
+  String asArduinoString() const;
+#endif
+
+ private:
+  friend constexpr DoubleWork UnknownDoubleWork();
+
+  friend constexpr DoubleWork DoubleWorkInJoules(double);
+
+  explicit constexpr DoubleWork(double work) : QuantityBase(work) {}
+};
+
+constexpr DoubleWork DoubleWorkInJoules(double work);
+
+/// Returns a double-precision work object representing an unknown work.
+constexpr DoubleWork UnknownDoubleWork() { return DoubleWork(); }
+
+/// Returns a double-precision work object equivalent to the specified
+/// work expressed in gigaJoules.
+constexpr DoubleWork DoubleWorkInGigaJoules(double work) {
+  return DoubleWorkInJoules(work * 1000000000.0);
 }
 
-inline Work operator-(Work a) { return WorkInJoules(-a.inJoules()); }
+/// Returns a double-precision work object equivalent to the specified
+/// work expressed in megaJoules.
+constexpr DoubleWork DoubleWorkInMegaJoules(double work) {
+  return DoubleWorkInJoules(work * 1000000.0);
+}
 
-inline Work operator*(Work a, float b) {
-  return WorkInJoules(a.inJoules() * b);
+/// Returns a double-precision work object equivalent to the specified
+/// work expressed in kiloJoules.
+constexpr DoubleWork DoubleWorkInKiloJoules(double work) {
+  return DoubleWorkInJoules(work * 1000.0);
 }
 
-inline Work operator*(float a, Work b) {
-  return WorkInJoules(a * b.inJoules());
+/// Returns a double-precision work object equivalent to the specified
+/// work expressed in Joules.
+constexpr DoubleWork DoubleWorkInJoules(double work) {
+  return DoubleWork(work);
 }
 
-inline Work operator/(Work a, float b) {
-  return WorkInJoules(a.inJoules() / b);
+/// Returns a double-precision work object equivalent to the specified
+/// work expressed in milliJoules.
+constexpr DoubleWork DoubleWorkInMilliJoules(double work) {
+  return DoubleWorkInJoules(work / 1000.0);
 }
 
-inline float operator/(Work a, Work b) { return a.inJoules() / b.inJoules(); }
+/// Returns a double-precision work object equivalent to the specified
+/// work expressed in microJoules.
+constexpr DoubleWork DoubleWorkInMicroJoules(double work) {
+  return DoubleWorkInJoules(work / 1000000.0);
+}
 
-roo_logging::Stream& operator<<(roo_logging::Stream& os, const Work& val);
+roo_logging::Stream& operator<<(roo_logging::Stream& os, const DoubleWork& val);
 
 }  // namespace roo_quantity
\ No newline at end of file
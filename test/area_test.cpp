@@ -12,7 +12,7 @@ TEST(Area, ConversionSi) {
   EXPECT_FLOAT_EQ(1500000.0f, a.inSquareMillimeters());
   EXPECT_FLOAT_EQ(1500000000000.0f, a.inSquareMicrometers());
   EXPECT_FLOAT_EQ(0.0000015f, a.inSquareKilometers());
-  EXPECT_FLOAT_EQ(0.000015f, a.inHectares());
+  EXPECT_FLOAT_EQ(0.00015f, a.inHectares());
   EXPECT_FLOAT_EQ(0.015f, a.inAres());
 }
 
@@ -27,6 +27,13 @@ TEST(Area, ConversionNonSi) {
   EXPECT_FLOAT_EQ(3875007.75f, a.inSquareInches());
 }
 
+TEST(Area, Hectares) {
+  Area a = AreaInSquareMeters(25000.0f);
+  EXPECT_FLOAT_EQ(2.5f, a.inHectares());
+  EXPECT_EQ("2.5 ha", a.asString());
+  EXPECT_FLOAT_EQ(25000.0f, AreaInHectares(2.5f).inSquareMeters());
+}
+
 TEST(Area, Comparison) {
   EXPECT_TRUE(AreaInSquareMeters(1.0f) < AreaInSquareMeters(2.0f));
   EXPECT_TRUE(AreaInSquareMeters(2.0f) > AreaInSquareMeters(1.0f));
@@ -72,4 +79,12 @@ TEST(Area, AsString) {
   EXPECT_EQ("1.5 km²", AreaInSquareKilometers(1.5f).asString());
 }
 
+TEST(Area, AsStringEdgeCases) {
+  EXPECT_EQ("1 m²", AreaInSquareMeters(1.0f).asString());
+  EXPECT_EQ("2.5 ha", AreaInSquareMeters(25000.0f).asString());
+  EXPECT_EQ("-1.5 m²", AreaInSquareMeters(-1.5f).asString());
+  EXPECT_EQ("0 m²", AreaInSquareMeters(0.0f).asString());
+  EXPECT_EQ("? m²", UnknownArea().asString());
+}
+
 }  // namespace roo_quantity
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "roo_quantity/barometric.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace roo_quantity {
+
+namespace {
+
+const Pressure kStandardSeaLevel = PressureInPascals(101325.0f);
+
+}  // namespace
+
+TEST(Barometric, FastLog) {
+  float max_error = 0.0f;
+  for (float x = 1e-6f; x < 1e6f; x *= 1.0007f) {
+    double expected = std::log(static_cast<double>(x));
+    double error = std::fabs(internal::FastLog(x) - expected);
+    // Relative error, but absolute near x = 1, where ln(x) crosses zero.
+    max_error = std::max(
+        max_error,
+        static_cast<float>(error / std::max(1.0, std::fabs(expected))));
+  }
+  EXPECT_LT(max_error, 3e-7f);
+  EXPECT_EQ(0.0f, internal::FastLog(1.0f));
+  EXPECT_TRUE(std::isnan(internal::FastLog(0.0f)));
+  EXPECT_TRUE(std::isnan(internal::FastLog(-1.0f)));
+  EXPECT_TRUE(std::isnan(internal::FastLog(NAN)));
+  EXPECT_EQ(INFINITY, internal::FastLog(INFINITY));
+}
+
+TEST(Barometric, FastExp) {
+  float max_error = 0.0f;
+  for (float y = -87.0f; y < 88.0f; y += 0.0013f) {
+    double expected = std::exp(static_cast<double>(y));
+    max_error = std::max(
+        max_error,
+        static_cast<float>(std::fabs(internal::FastExp(y) - expected) /
+                           expected));
+  }
+  EXPECT_LT(max_error, 3e-7f);
+  EXPECT_EQ(1.0f, internal::FastExp(0.0f));
+  EXPECT_TRUE(std::isnan(internal::FastExp(NAN)));
+  EXPECT_EQ(INFINITY, internal::FastExp(INFINITY));
+}
+
+TEST(Barometric, StandardAtmosphere) {
+  // At 1000 m in the standard atmosphere: 898.746 hPa, and 8.5 C.
+  EXPECT_NEAR(1000.0f,
+              AltitudeFromPressure(PressureInPascals(89874.6f),
+                                   kStandardSeaLevel,
+                                   TemperatureDegCelcius(8.5f))
+                  .inMeters(),
+              0.5f);
+  // At 5000 m: 540.199 hPa, and -17.5 C.
+  EXPECT_NEAR(5000.0f,
+              AltitudeFromPressure(PressureInPascals(54019.9f),
+                                   kStandardSeaLevel,
+                                   TemperatureDegCelcius(-17.5f))
+                  .inMeters(),
+              0.5f);
+  EXPECT_EQ(0.0f, AltitudeFromPressure(kStandardSeaLevel, kStandardSeaLevel,
+                                       TemperatureDegCelcius(15.0f))
+                      .inMeters());
+  EXPECT_NEAR(101325.0f,
+              SeaLevelPressure(PressureInPascals(89874.6f),
+                               LengthInMeters(1000.0f),
+                               TemperatureDegCelcius(8.5f))
+                  .inPascals(),
+              5.0f);
+}
+
+TEST(Barometric, RoundTrip) {
+  Temperature t = TemperatureDegCelcius(22.0f);
+  Pressure sea_level = PressureInHectoPascals(1021.0f);
+  for (float hpa = 300.0f; hpa <= 1100.0f; hpa += 10.0f) {
+    Pressure p = PressureInHectoPascals(hpa);
+    Length h = AltitudeFromPressure(p, sea_level, t);
+    EXPECT_NEAR(sea_level.inPascals(),
+                SeaLevelPressure(p, h, t).inPascals(), 0.1f)
+        << hpa;
+  }
+}
+
+TEST(Barometric, FastAltitude) {
+  float max_error = 0.0f;
+  for (float celsius = -40.0f; celsius <= 40.0f; celsius += 10.0f) {
+    Temperature t = TemperatureDegCelcius(celsius);
+    for (float hpa = 250.0f; hpa <= 1100.0f; hpa += 0.37f) {
+      Pressure p = PressureInHectoPascals(hpa);
+      max_error = std::max(
+          max_error,
+          std::fabs(FastAltitudeFromPressure(p, kStandardSeaLevel, t)
+                        .inMeters() -
+                    AltitudeFromPressure(p, kStandardSeaLevel, t).inMeters()));
+    }
+  }
+  EXPECT_LT(max_error, 0.05f);
+}
+
+TEST(Barometric, FastSeaLevelPressure) {
+  float max_error = 0.0f;
+  Pressure p = PressureInHectoPascals(900.0f);
+  for (float celsius = -40.0f; celsius <= 40.0f; celsius += 10.0f) {
+    Temperature t = TemperatureDegCelcius(celsius);
+    for (float m = -500.0f; m <= 9000.0f; m += 1.3f) {
+      Length h = LengthInMeters(m);
+      max_error = std::max(
+          max_error, std::fabs(FastSeaLevelPressure(p, h, t).inPascals() -
+                               SeaLevelPressure(p, h, t).inPascals()));
+    }
+  }
+  EXPECT_LT(max_error, 0.2f);
+}
+
+TEST(Barometric, Unknown) {
+  Temperature t = TemperatureDegCelcius(15.0f);
+  EXPECT_TRUE(
+      AltitudeFromPressure(Pressure(), kStandardSeaLevel, t).isUnknown());
+  EXPECT_TRUE(
+      FastAltitudeFromPressure(Pressure(), kStandardSeaLevel, t).isUnknown());
+  EXPECT_TRUE(FastAltitudeFromPressure(kStandardSeaLevel, kStandardSeaLevel,
+                                       Temperature())
+                  .isUnknown());
+  EXPECT_TRUE(
+      FastSeaLevelPressure(kStandardSeaLevel, Length(), t).isUnknown());
+}
+
+TEST(Barometric, ZeroPressure) {
+  // As reported by sensors that are not ready.
+  Temperature t = TemperatureDegCelcius(15.0f);
+  Pressure zero = PressureInPascals(0.0f);
+  float exact = AltitudeFromPressure(zero, kStandardSeaLevel, t).inMeters();
+  EXPECT_EQ(INFINITY, exact);
+  EXPECT_EQ(exact,
+            FastAltitudeFromPressure(zero, kStandardSeaLevel, t).inMeters());
+}
+
+TEST(Barometric, Spans) {
+  Temperature t = TemperatureDegCelcius(5.0f);
+  Length altitude = LengthInMeters(420.0f);
+  std::vector<Pressure> pressures;
+  for (float hpa = 300.0f; hpa <= 1100.0f; hpa += 3.3f) {
+    pressures.push_back(PressureInHectoPascals(hpa));
+  }
+  // Within the vectorized part.
+  pressures[5] = PressureInPascals(0.0f);
+  pressures.push_back(Pressure());
+  size_t n = pressures.size();
+  std::vector<Length> altitudes(n);
+  std::vector<Length> fast_altitudes(n);
+  std::vector<Pressure> sea_levels(n);
+  std::vector<Pressure> fast_sea_levels(n);
+  AltitudeFromPressure(QuantitySpan<const Pressure>(pressures.data(), n),
+                       kStandardSeaLevel, t,
+                       QuantitySpan<Length>(altitudes.data(), n));
+  FastAltitudeFromPressure(QuantitySpan<const Pressure>(pressures.data(), n),
+                           kStandardSeaLevel, t,
+                           QuantitySpan<Length>(fast_altitudes.data(), n));
+  SeaLevelPressure(QuantitySpan<const Pressure>(pressures.data(), n), altitude,
+                   t, QuantitySpan<Pressure>(sea_levels.data(), n));
+  FastSeaLevelPressure(QuantitySpan<const Pressure>(pressures.data(), n),
+                       altitude, t,
+                       QuantitySpan<Pressure>(fast_sea_levels.data(), n));
+  for (size_t i = 0; i + 1 < n; ++i) {
+    Pressure p = pressures[i];
+    EXPECT_EQ(AltitudeFromPressure(p, kStandardSeaLevel, t).inMeters(),
+              altitudes[i].inMeters());
+    EXPECT_EQ(FastAltitudeFromPressure(p, kStandardSeaLevel, t).inMeters(),
+              fast_altitudes[i].inMeters());
+    EXPECT_EQ(SeaLevelPressure(p, altitude, t).inPascals(),
+              sea_levels[i].inPascals());
+    EXPECT_EQ(FastSeaLevelPressure(p, altitude, t).inPascals(),
+              fast_sea_levels[i].inPascals());
+  }
+  EXPECT_EQ(INFINITY, fast_altitudes[5].inMeters());
+  EXPECT_TRUE(altitudes[n - 1].isUnknown());
+  EXPECT_TRUE(fast_altitudes[n - 1].isUnknown());
+  EXPECT_TRUE(sea_levels[n - 1].isUnknown());
+  EXPECT_TRUE(fast_sea_levels[n - 1].isUnknown());
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,100 @@
+#include "roo_quantity/calibration.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/voltage.h"
+
+namespace roo_quantity {
+
+namespace {
+
+constexpr CalibrationPoint<Temperature> kThermistor[] = {
+    {412.0f, TemperatureDegCelcius(-20.0f)},
+    {1310.0f, TemperatureDegCelcius(25.0f)},
+    {2000.0f, TemperatureDegCelcius(50.0f)},
+    {3390.0f, TemperatureDegCelcius(100.0f)},
+};
+
+constexpr CalibrationTable<Temperature> kThermistorTable(kThermistor);
+
+static_assert(kThermistorTable.valid(), "");
+static_assert(kThermistorTable(1310.0f).degCelcius() == 25.0f, "");
+
+constexpr CalibrationPoint<Length> kUnsorted[] = {
+    {1.0f, LengthInMeters(1.0f)},
+    {1.0f, LengthInMeters(2.0f)},
+};
+
+static_assert(!CalibrationTable<Length>(kUnsorted).valid(), "");
+
+constexpr Voltage kDivider[] = {
+    VoltageInMilliVolts(0.0f),    VoltageInMilliVolts(100.0f),
+    VoltageInMilliVolts(250.0f),  VoltageInMilliVolts(450.0f),
+    VoltageInMilliVolts(1000.0f),
+};
+
+constexpr UniformCalibrationTable<Voltage> kDividerTable(0.0f, 1024.0f,
+                                                         kDivider);
+
+static_assert(kDividerTable(2048.0f).inMilliVolts() == 250.0f, "");
+
+}  // namespace
+
+TEST(Calibration, Interpolates) {
+  for (const CalibrationPoint<Temperature>& p : kThermistor) {
+    EXPECT_EQ(p.value, kThermistorTable(p.raw));
+  }
+  EXPECT_FLOAT_EQ(2.5f, kThermistorTable(861.0f).degCelcius());
+  EXPECT_FLOAT_EQ(75.0f, kThermistorTable(2695.0f).degCelcius());
+}
+
+TEST(Calibration, Extrapolates) {
+  EXPECT_FLOAT_EQ(-65.0f, kThermistorTable(-486.0f).degCelcius());
+  EXPECT_FLOAT_EQ(150.0f, kThermistorTable(4780.0f).degCelcius());
+  EXPECT_TRUE(kThermistorTable(NAN).isUnknown());
+}
+
+TEST(Calibration, Uniform) {
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(kDivider[i], kDividerTable((float)(i * 1024)));
+  }
+  EXPECT_FLOAT_EQ(50.0f, kDividerTable(512.0f).inMilliVolts());
+  EXPECT_FLOAT_EQ(350.0f, kDividerTable(2560.0f).inMilliVolts());
+  EXPECT_FLOAT_EQ(-50.0f, kDividerTable(-512.0f).inMilliVolts());
+  EXPECT_FLOAT_EQ(1550.0f, kDividerTable(5120.0f).inMilliVolts());
+  EXPECT_TRUE(kDividerTable(NAN).isUnknown());
+  EXPECT_EQ(1024.0f, kDividerTable.rawStep());
+}
+
+TEST(Calibration, UniformMatchesBinarySearch) {
+  CalibrationPoint<Voltage> points[5] = {};
+  for (int i = 0; i < 5; ++i) {
+    points[i] = CalibrationPoint<Voltage>{(float)(i * 1024), kDivider[i]};
+  }
+  CalibrationTable<Voltage> table(points);
+  for (int raw = -2000; raw < 6000; raw += 7) {
+    EXPECT_FLOAT_EQ(table((float)raw).inVolts(),
+                    kDividerTable((float)raw).inVolts())
+        << raw;
+  }
+}
+
+TEST(Calibration, Batch) {
+  uint16_t counts[] = {0, 512, 1024, 4095};
+  Voltage out[4];
+  kDividerTable.apply(counts, QuantitySpan<Voltage>(out));
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(kDividerTable(counts[i]), out[i]);
+  Temperature temperatures[4];
+  float raw[] = {412.0f, 861.0f, NAN, 3390.0f};
+  kThermistorTable.apply(raw, QuantitySpan<Temperature>(temperatures));
+  EXPECT_EQ(TemperatureDegCelcius(-20.0f), temperatures[0]);
+  EXPECT_FLOAT_EQ(2.5f, temperatures[1].degCelcius());
+  EXPECT_TRUE(temperatures[2].isUnknown());
+  EXPECT_EQ(TemperatureDegCelcius(100.0f), temperatures[3]);
+}
+
+}  // namespace roo_quantity
@@ -1,6 +1,8 @@
 #include "roo_quantity/charge.h"
 
 #include "gtest/gtest.h"
+#include "roo_quantity/current.h"
+#include "roo_quantity/time.h"
 
 namespace roo_quantity {
 
@@ -77,4 +79,13 @@ TEST(Charge, AsString) {
   EXPECT_EQ("0 C", ChargeInCoulombs(0).asString());
 }
 
+TEST(DoubleCharge, MixedPrecision) {
+  DoubleCharge q = CurrentInAmperes(0.5f) * DoubleTimeInHours(40.0);
+  EXPECT_DOUBLE_EQ(72000.0, q.inCoulombs());
+  q -= ChargeInMilliCoulombs(1.0f);
+  EXPECT_NEAR(71999.999, q.inCoulombs(), 1e-6);
+  EXPECT_DOUBLE_EQ(72.0, DoubleChargeInKiloCoulombs(72.0).inKiloCoulombs());
+  EXPECT_EQ("72 kC", q.asString());
+}
+
 }  // namespace roo_quantity
@@ -0,0 +1,238 @@
+#include "roo_quantity/compression.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/voltage.h"
+
+namespace roo_quantity {
+
+namespace {
+
+roo_time::Uptime At(int64_t micros) {
+  return roo_time::Uptime::Start() + roo_time::Micros(micros);
+}
+
+template <typename Q>
+struct Series {
+  std::vector<roo_time::Uptime> t;
+  std::vector<Q> q;
+};
+
+template <typename Q>
+Series<Q> Decode(const uint8_t* data, size_t size, size_t count) {
+  Series<Q> result;
+  SeriesDecoder<Q> decoder(data, size, count);
+  roo_time::Uptime t;
+  Q q;
+  while (decoder.next(t, q)) {
+    result.t.push_back(t);
+    result.q.push_back(q);
+  }
+  return result;
+}
+
+// Bitwise equality, so that unknown values compare equal.
+template <typename Q>
+bool SameBits(const Q& a, const Q& b) {
+  float x = internal::RawTraits<Q>::ToRaw(a);
+  float y = internal::RawTraits<Q>::ToRaw(b);
+  return memcmp(&x, &y, sizeof(x)) == 0;
+}
+
+}  // namespace
+
+TEST(SeriesEncoder, RoundTripIsLossless) {
+  uint8_t buffer[4096];
+  SeriesEncoder<Voltage> encoder(buffer, sizeof(buffer));
+  Series<Voltage> input;
+  uint32_t seed = 1;
+  int64_t micros = -5000000;
+  for (int i = 0; i < 300; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    // Irregular intervals, covering all the delta-of-delta ranges.
+    micros += (i % 50 == 49) ? 10000000 : 1000 + (seed >> 20) % 5000;
+    input.t.push_back(At(micros));
+    input.q.push_back(i % 17 == 0 ? Voltage()
+                                  : VoltageInVolts(3.3f * (seed >> 8) /
+                                                   16777216.0f));
+    ASSERT_TRUE(encoder.append(input.t.back(), input.q.back()));
+  }
+  EXPECT_EQ(300u, encoder.count());
+  Series<Voltage> output =
+      Decode<Voltage>(buffer, encoder.size(), encoder.count());
+  ASSERT_EQ(300u, output.q.size());
+  for (size_t i = 0; i < output.q.size(); ++i) {
+    EXPECT_EQ(input.t[i].inMicros(), output.t[i].inMicros()) << i;
+    EXPECT_TRUE(SameBits(input.q[i], output.q[i])) << i;
+  }
+}
+
+TEST(SeriesEncoder, RegularSeriesIsCompact) {
+  uint8_t buffer[4096];
+  SeriesEncoder<Temperature> encoder(buffer, sizeof(buffer),
+                                     roo_time::Millis(10));
+  // An hour of readings every second, with some jitter, slowly changing.
+  for (int i = 0; i < 3600; ++i) {
+    ASSERT_TRUE(encoder.append(At(i * 1000000LL + (i * 7919) % 3000),
+                               TemperatureDegCelcius(21.5f + (i / 600) * 0.5f)));
+  }
+  // Repeated values and deltas take 2 bits per sample.
+  EXPECT_LT(encoder.size(), 3600u * 2 / 8 + 64);
+  Series<Temperature> output =
+      Decode<Temperature>(buffer, encoder.size(), encoder.count());
+  ASSERT_EQ(3600u, output.t.size());
+  EXPECT_EQ(3599000000LL, output.t.back().inMicros());
+  EXPECT_EQ(24.0f, output.q.back().degCelcius());
+}
+
+TEST(SeriesEncoder, Quantization) {
+  uint8_t buffer[4096];
+  SeriesEncoder<Pressure> lossless(buffer, sizeof(buffer));
+  uint8_t quantized_buffer[4096];
+  // Rounded down to 1/8 Pa.
+  SeriesEncoder<Pressure> quantized(quantized_buffer, sizeof(quantized_buffer),
+                                    roo_time::Micros(1),
+                                    PressureInPascals(0.2f));
+  std::vector<Pressure> input;
+  for (int i = 0; i < 500; ++i) {
+    input.push_back(
+        PressureInPascals(101325.0f + 40.0f * std::sin(i * 0.01f)));
+    ASSERT_TRUE(lossless.append(At(i * 1000000LL), input.back()));
+    ASSERT_TRUE(quantized.append(At(i * 1000000LL), input.back()));
+  }
+  EXPECT_LT(quantized.size() * 4, lossless.size() * 3);
+  Series<Pressure> output = Decode<Pressure>(
+      quantized_buffer, quantized.size(), quantized.count());
+  ASSERT_EQ(500u, output.q.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_NEAR(input[i].inPascals(), output.q[i].inPascals(), 0.0625f);
+    float steps = output.q[i].inPascals() * 8.0f;
+    EXPECT_EQ(std::round(steps), steps);
+  }
+}
+
+TEST(SeriesEncoder, TemperatureQuantization) {
+  uint8_t buffer[64];
+  SeriesEncoder<Temperature> encoder(buffer, sizeof(buffer),
+                                     roo_time::Micros(1),
+                                     TemperatureDeltaDegCelcius(0.5f));
+  ASSERT_TRUE(encoder.append(At(0), TemperatureDegCelcius(21.3f)));
+  ASSERT_TRUE(encoder.append(At(1), Temperature()));
+  Series<Temperature> output =
+      Decode<Temperature>(buffer, encoder.size(), encoder.count());
+  ASSERT_EQ(2u, output.q.size());
+  EXPECT_EQ(21.5f, output.q[0].degCelcius());
+  EXPECT_TRUE(output.q[1].isUnknown());
+}
+
+TEST(SeriesEncoder, FullBuffer) {
+  uint8_t buffer[32];
+  SeriesEncoder<Voltage> encoder(buffer, sizeof(buffer));
+  std::vector<Voltage> input;
+  uint32_t seed = 7;
+  while (true) {
+    seed = seed * 1664525 + 1013904223;
+    Voltage v = VoltageInVolts(static_cast<float>(seed >> 8));
+    if (!encoder.append(At(input.size() * 1000), v)) break;
+    input.push_back(v);
+  }
+  EXPECT_EQ(input.size(), encoder.count());
+  EXPECT_LE(encoder.size(), sizeof(buffer));
+  // A failed append leaves the stream intact.
+  EXPECT_FALSE(encoder.append(At(input.size() * 1000), VoltageInVolts(1e9f)));
+  Series<Voltage> output =
+      Decode<Voltage>(buffer, encoder.size(), encoder.count());
+  ASSERT_EQ(input.size(), output.q.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(input[i].inVolts(), output.q[i].inVolts());
+  }
+}
+
+TEST(SeriesEncoder, TimeResolutionIsClamped) {
+  uint8_t buffer[256];
+  SeriesEncoder<Voltage> zero(buffer, sizeof(buffer), roo_time::Micros(0));
+  ASSERT_TRUE(zero.append(At(1234), VoltageInVolts(1.0f)));
+  Series<Voltage> output = Decode<Voltage>(buffer, zero.size(), zero.count());
+  ASSERT_EQ(1u, output.t.size());
+  EXPECT_EQ(1234, output.t[0].inMicros());
+
+  // Two hours, clamped to about 71.6 minutes.
+  constexpr int64_t kMaxTick = 0xFFFFFFFF;
+  SeriesEncoder<Voltage> large(buffer, sizeof(buffer),
+                               roo_time::Micros(7200000000LL));
+  ASSERT_TRUE(large.append(At(0), VoltageInVolts(1.0f)));
+  ASSERT_TRUE(large.append(At(3 * kMaxTick), VoltageInVolts(2.0f)));
+  output = Decode<Voltage>(buffer, large.size(), large.count());
+  ASSERT_EQ(2u, output.t.size());
+  EXPECT_EQ(0, output.t[0].inMicros());
+  EXPECT_EQ(3 * kMaxTick, output.t[1].inMicros());
+}
+
+TEST(SeriesDecoder, Truncated) {
+  uint8_t buffer[256];
+  SeriesEncoder<Voltage> encoder(buffer, sizeof(buffer));
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(encoder.append(At(i), VoltageInVolts(i * 0.37f)));
+  }
+  Series<Voltage> output = Decode<Voltage>(buffer, 20, encoder.count());
+  EXPECT_LT(output.q.size(), 20u);
+  for (size_t i = 0; i < output.q.size(); ++i) {
+    EXPECT_EQ(i * 0.37f, output.q[i].inVolts());
+  }
+  EXPECT_EQ(0u, Decode<Voltage>(buffer, 3, 5).q.size());
+
+  // Cut at every byte, including within the control bits of the first
+  // changed value, before any XOR window has been defined.
+  SeriesEncoder<Voltage> repeated(buffer, sizeof(buffer));
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(repeated.append(At(i), VoltageInVolts(1.0f)));
+  }
+  ASSERT_TRUE(repeated.append(At(4), VoltageInVolts(2.0f)));
+  for (size_t size = 0; size < repeated.size(); ++size) {
+    output = Decode<Voltage>(buffer, size, repeated.count());
+    EXPECT_LT(output.q.size(), 5u);
+    for (size_t i = 0; i < output.q.size(); ++i) {
+      EXPECT_EQ(1.0f, output.q[i].inVolts());
+    }
+  }
+  EXPECT_EQ(5u, Decode<Voltage>(buffer, repeated.size(), 5).q.size());
+}
+
+TEST(SeriesDecoder, CorruptWindow) {
+  // Tick length, first sample, then a delta-of-delta of zero (0), and a
+  // changed value (11) with 31 leading zeros and a length of 32.
+  uint8_t buffer[32] = {};
+  buffer[16] = 0x7F;
+  buffer[17] = 0xF8;
+  internal::GorillaReader reader(buffer, sizeof(buffer), 2);
+  int64_t ticks;
+  uint32_t value;
+  EXPECT_TRUE(reader.next(ticks, value));
+  EXPECT_FALSE(reader.next(ticks, value));
+}
+
+TEST(SeriesDecoder, Span) {
+  uint8_t buffer[256];
+  SeriesEncoder<Voltage> encoder(buffer, sizeof(buffer));
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(encoder.append(At(i * 100), VoltageInVolts(i)));
+  }
+  SeriesDecoder<Voltage> decoder(buffer, encoder.size(), encoder.count());
+  roo_time::Uptime t[6];
+  Voltage v[6];
+  EXPECT_EQ(6u, decoder.next(t, QuantitySpan<Voltage>(v)));
+  EXPECT_EQ(500, t[5].inMicros());
+  EXPECT_EQ(5.0f, v[5].inVolts());
+  EXPECT_EQ(4u, decoder.next(t, QuantitySpan<Voltage>(v)));
+  EXPECT_EQ(900, t[3].inMicros());
+  EXPECT_EQ(9.0f, v[3].inVolts());
+  EXPECT_EQ(0u, decoder.next(t, QuantitySpan<Voltage>(v)));
+}
+
+}  // namespace roo_quantity
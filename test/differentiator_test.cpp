@@ -0,0 +1,179 @@
+#include "roo_quantity/differentiator.h"
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/charge.h"
+#include "roo_quantity/current.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/velocity.h"
+#include "roo_quantity/volume.h"
+#include "roo_quantity/volume_flow_rate.h"
+
+namespace roo_quantity {
+
+TEST(Differentiator, Types) {
+  static_assert(std::is_same<FiniteDifference<Length>::Derivative,
+                             Velocity>::value,
+                "");
+  static_assert(std::is_same<LeastSquaresSlope<Volume, 4>::Derivative,
+                             VolumeFlowRate>::value,
+                "");
+  static_assert(std::is_same<SavitzkyGolayDerivative<Charge, 5>::Derivative,
+                             Current>::value,
+                "");
+  static_assert(
+      std::is_same<FiniteDifference<Temperature>::Derivative,
+                   internal::QuotientOf<TemperatureDelta, Time>>::value,
+      "");
+}
+
+TEST(Differentiator, FiniteDifference) {
+  FiniteDifference<Length> speed;
+  EXPECT_TRUE(speed.derivative().isUnknown());
+  speed.addSample(LengthInMeters(1.0f), TimeInSeconds(100.0f));
+  EXPECT_TRUE(speed.derivative().isUnknown());
+  speed.addSample(LengthInMeters(4.0f), TimeInSeconds(2.0f));
+  EXPECT_EQ(VelocityInMetersPerSecond(1.5f), speed.derivative());
+  speed.addSample(UnknownLength(), TimeInSeconds(1.0f));
+  EXPECT_TRUE(speed.derivative().isUnknown());
+  speed.addSample(LengthInMeters(4.0f), TimeInSeconds(1.0f));
+  EXPECT_TRUE(speed.derivative().isUnknown());
+  speed.addSample(LengthInMeters(3.0f), TimeInSeconds(0.5f));
+  EXPECT_EQ(VelocityInMetersPerSecond(-2.0f), speed.derivative());
+}
+
+TEST(Differentiator, FiniteDifferenceTemperature) {
+  FiniteDifference<Temperature> rate;
+  rate.addSample(TemperatureDegFahrenheit(50.0f), TimeInSeconds(1.0f));
+  rate.addSample(TemperatureDegFahrenheit(59.0f), TimeInSeconds(10.0f));
+  EXPECT_NEAR(0.5f, rate.derivative().inSiUnits(), 1e-5f);
+}
+
+TEST(Differentiator, LeastSquaresSlope) {
+  LeastSquaresSlope<Volume, 4> flow;
+  EXPECT_TRUE(flow.derivative().isUnknown());
+  flow.addSample(VolumeInLiters(100.0f), TimeInSeconds(1.0f));
+  EXPECT_TRUE(flow.derivative().isUnknown());
+  // Non-uniformly spaced samples on a line.
+  flow.addSample(VolumeInLiters(102.0f), TimeInSeconds(1.0f));
+  flow.addSample(VolumeInLiters(108.0f), TimeInSeconds(3.0f));
+  EXPECT_NEAR(2.0f, flow.derivative().inLitersPerSecond(), 1e-4f);
+  // Unknown samples are skipped.
+  flow.addSample(UnknownVolume(), TimeInSeconds(1.0f));
+  flow.addSample(VolumeInLiters(112.0f), TimeInSeconds(1.0f));
+  EXPECT_NEAR(2.0f, flow.derivative().inLitersPerSecond(), 1e-4f);
+  // Noise is averaged out: the best fit to 0, 1, 0, 1 has slope 0.2.
+  for (float v : {0.0f, 1.0f, 0.0f, 1.0f}) {
+    flow.addSample(VolumeInCubicMeters(v), TimeInSeconds(1.0f));
+  }
+  EXPECT_NEAR(0.2f, flow.derivative().inCubicMetersPerSecond(), 1e-6f);
+  flow.reset();
+  EXPECT_TRUE(flow.derivative().isUnknown());
+}
+
+TEST(Differentiator, SavitzkyGolayWeights) {
+  // The 3-point formula: (3 x2 - 4 x1 + x0) / 2.
+  constexpr internal::SavitzkyGolayWeights<3> w3;
+  EXPECT_DOUBLE_EQ(0.5, w3.w[0]);
+  EXPECT_DOUBLE_EQ(-2.0, w3.w[1]);
+  EXPECT_DOUBLE_EQ(1.5, w3.w[2]);
+}
+
+TEST(Differentiator, SavitzkyGolayExactForParabola) {
+  SavitzkyGolayDerivative<Charge, 7> current(TimeInMilliseconds(10.0f));
+  for (int i = 0; i < 20; ++i) {
+    float t = (float)i * 0.01f;
+    current.addSample(ChargeInCoulombs(3.0f * t * t - t + 5.0f));
+    if (i < 6) {
+      EXPECT_TRUE(current.derivative().isUnknown());
+    } else {
+      EXPECT_NEAR(6.0f * t - 1.0f, current.derivative().inAmperes(), 1e-3f);
+    }
+  }
+  current.addSample(UnknownCharge());
+  EXPECT_TRUE(current.derivative().isUnknown());
+  current.reset();
+  EXPECT_TRUE(current.derivative().isUnknown());
+}
+
+TEST(Differentiator, DifferentiateCentral) {
+  float positions[] = {0.0f, 1.0f, 4.0f, 9.0f, 16.0f};
+  Velocity velocities[5];
+  Differentiate(QuantitySpan<const Length>(positions, 5), TimeInSeconds(1.0f),
+                QuantitySpan<Velocity>(velocities));
+  // As numpy.gradient: one-sided differences at the ends.
+  EXPECT_FLOAT_EQ(1.0f, velocities[0].inMetersPerSecond());
+  EXPECT_FLOAT_EQ(2.0f, velocities[1].inMetersPerSecond());
+  EXPECT_FLOAT_EQ(4.0f, velocities[2].inMetersPerSecond());
+  EXPECT_FLOAT_EQ(6.0f, velocities[3].inMetersPerSecond());
+  EXPECT_FLOAT_EQ(7.0f, velocities[4].inMetersPerSecond());
+}
+
+TEST(Differentiator, DifferentiateWindowMatchesStreaming) {
+  constexpr size_t kCount = 1001;
+  std::vector<float> positions(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    positions[i] = std::sin((float)i * 0.01f) + ((i % 2) ? 0.01f : -0.01f);
+  }
+  positions[500] = NAN;
+  std::vector<float> velocities(kCount);
+  QuantitySpan<const Length> in(positions.data(), kCount);
+  Differentiate(in, TimeInMilliseconds(1.0f),
+                QuantitySpan<Velocity>(velocities.data(), kCount), 9);
+  // The centered slope at i is the trailing slope at i + 4.
+  LeastSquaresSlope<Length, 9> slope;
+  for (size_t i = 0; i < kCount; ++i) {
+    slope.addSample(in[i], TimeInMilliseconds(1.0f));
+    if (i < 8) continue;
+    size_t center = i - 4;
+    if (center >= 496 && center <= 504) {
+      EXPECT_TRUE(std::isnan(velocities[center])) << center;
+    } else {
+      EXPECT_NEAR(slope.derivative().inMetersPerSecond(), velocities[center],
+                  1e-2f)
+          << center;
+      // The noise is suppressed; the derivative of sin(i / 100 ms) is close.
+      EXPECT_NEAR(10.0f * std::cos((float)center * 0.01f), velocities[center],
+                  0.5f)
+          << center;
+    }
+  }
+  // Clipped windows at the ends.
+  EXPECT_FALSE(std::isnan(velocities[0]));
+  EXPECT_FALSE(std::isnan(velocities[kCount - 1]));
+}
+
+TEST(Differentiator, DifferentiateShort) {
+  float one[] = {5.0f};
+  float out[1];
+  Differentiate(QuantitySpan<const Length>(one, 1), TimeInSeconds(1.0f),
+                QuantitySpan<Velocity>(out, 1), 5);
+  EXPECT_TRUE(std::isnan(out[0]));
+  float two[] = {5.0f, 7.0f};
+  float out2[2];
+  Differentiate(QuantitySpan<const Length>(two, 2), TimeInSeconds(0.5f),
+                QuantitySpan<Velocity>(out2, 2), 5);
+  EXPECT_FLOAT_EQ(4.0f, out2[0]);
+  EXPECT_FLOAT_EQ(4.0f, out2[1]);
+}
+
+TEST(DifferentiatorDeathTest, DifferentiateChecksArguments) {
+  float in[8] = {};
+  float out[9];
+  QuantitySpan<const Length> positions(in, 8);
+  EXPECT_DEBUG_DEATH(Differentiate(positions, TimeInSeconds(1.0f),
+                                   QuantitySpan<Velocity>(out, 9)),
+                     "in.size\\(\\) == out.size\\(\\)");
+  EXPECT_DEBUG_DEATH(Differentiate(positions, TimeInSeconds(1.0f),
+                                   QuantitySpan<Velocity>(out, 8), 4),
+                     "window % 2 == 1");
+  EXPECT_DEBUG_DEATH(Differentiate(positions, TimeInSeconds(1.0f),
+                                   QuantitySpan<Velocity>(out, 8), 1),
+                     "window >= 3");
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,31 @@
+// This test, and the whole library, are compiled with
+// -Werror=double-promotion (see BUILD), to catch accidental double-precision
+// arithmetic, which is emulated in software on most microcontrollers.
+
+#include "gtest/gtest.h"
+#include "roo_quantity.h"
+
+namespace roo_quantity {
+
+TEST(DoublePromotion, TemperatureConversions) {
+  Temperature t = TemperatureDegFahrenheit(212.0f);
+  EXPECT_FLOAT_EQ(100.0f, t.degCelcius());
+  EXPECT_FLOAT_EQ(373.15f, t.degKelvin());
+  EXPECT_FLOAT_EQ(212.0f, t.degFahrenheit());
+  t = TemperatureDegKelvin(0.0f);
+  EXPECT_FLOAT_EQ(-273.15f, t.degCelcius());
+  TemperatureDelta dt = TemperatureDeltaDegFahrenheit(9.0f);
+  EXPECT_FLOAT_EQ(5.0f, dt.degCelcius());
+  EXPECT_FLOAT_EQ(9.0f, dt.degFahrenheit());
+}
+
+TEST(DoublePromotion, Formatting) {
+  EXPECT_EQ("1.5 kV", VoltageInVolts(1500.0f).asString());
+  EXPECT_EQ("15 bar", PressureInMegaPascals(1.5f).asString());
+}
+
+TEST(DoublePromotion, RadiansPerSecond) {
+  EXPECT_FLOAT_EQ(6.2831853f, FrequencyInHertz(1.0f).inRadiansPerSecond());
+}
+
+}  // namespace roo_quantity
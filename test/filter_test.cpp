@@ -0,0 +1,142 @@
+#include "roo_quantity/filter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+
+TEST(Filter, Ema) {
+  Ema<Temperature> ema(0.25f);
+  EXPECT_TRUE(ema.value().isUnknown());
+  EXPECT_TRUE(ema.update(UnknownTemperature()).isUnknown());
+  // Starts at the first sample.
+  EXPECT_EQ(TemperatureDegCelcius(20.0f),
+            ema.update(TemperatureDegCelcius(20.0f)));
+  EXPECT_EQ(TemperatureDegCelcius(21.0f),
+            ema.update(TemperatureDegCelcius(24.0f)));
+  // Unknown samples are ignored.
+  EXPECT_EQ(TemperatureDegCelcius(21.0f), ema.update(UnknownTemperature()));
+  EXPECT_EQ(TemperatureDegCelcius(21.0f), ema.value());
+  ema.reset();
+  EXPECT_TRUE(ema.value().isUnknown());
+}
+
+TEST(Filter, LowPassFilter) {
+  LowPassFilter<Pressure> filter(FrequencyInHertz(1.0f));
+  filter.update(PressureInPascals(0.0f), TimeInSeconds(1.0f));
+  // After one time constant, a step response reaches 1 - 1/e.
+  Pressure p = filter.update(PressureInPascals(1000.0f),
+                             TimeInSeconds(1.0f / (2.0f * (float)M_PI)));
+  EXPECT_NEAR(1000.0f * (1.0f - std::exp(-1.0f)), p.inPascals(), 0.01f);
+  // Independent of the sampling rate.
+  LowPassFilter<Pressure> fine(FrequencyInHertz(1.0f));
+  fine.update(PressureInPascals(0.0f), TimeInSeconds(1.0f));
+  for (int i = 0; i < 100; ++i) {
+    p = fine.update(PressureInPascals(1000.0f),
+                    TimeInSeconds(0.01f / (2.0f * (float)M_PI)));
+  }
+  EXPECT_NEAR(1000.0f * (1.0f - std::exp(-1.0f)), p.inPascals(), 0.05f);
+}
+
+TEST(Filter, BiquadEmaMatchesEma) {
+  Ema<Length> ema(0.1f);
+  Biquad<Length> biquad(BiquadEma(0.1f));
+  for (int i = 0; i < 100; ++i) {
+    Length x = LengthInMeters((float)(i % 7));
+    EXPECT_NEAR(ema.update(x).inMeters(), biquad.update(x).inMeters(), 1e-5f);
+  }
+}
+
+TEST(Filter, BiquadLowPass) {
+  BiquadCoefficients c =
+      BiquadLowPass(FrequencyInHertz(10.0f), FrequencyInHertz(1000.0f));
+  EXPECT_NEAR(1.0f, c.dcGain(), 1e-5f);
+  Biquad<Temperature> filter(c);
+  // Starts in the steady state.
+  EXPECT_NEAR(20.0f, filter.update(TemperatureDegCelcius(20.0f)).degCelcius(),
+              1e-4f);
+  EXPECT_NEAR(20.0f, filter.update(TemperatureDegCelcius(20.0f)).degCelcius(),
+              1e-4f);
+  // Attenuates a 200 Hz signal (-26 dB per octave, from 10 Hz).
+  float peak = 0.0f;
+  for (int i = 0; i < 1000; ++i) {
+    float x =
+        20.0f + std::sin(2.0f * (float)M_PI * 200.0f * (float)i / 1000.0f);
+    float y = filter.update(TemperatureDegCelcius(x)).degCelcius();
+    if (i > 500) peak = std::max(peak, std::fabs(y - 20.0f));
+  }
+  EXPECT_LT(peak, 0.01f);
+  EXPECT_FALSE(filter.update(UnknownTemperature()).isUnknown());
+  filter.reset();
+  EXPECT_TRUE(filter.value().isUnknown());
+}
+
+TEST(Filter, BiquadHighPass) {
+  BiquadCoefficients c =
+      BiquadHighPass(FrequencyInHertz(10.0f), FrequencyInHertz(1000.0f));
+  EXPECT_NEAR(0.0f, c.dcGain(), 1e-5f);
+  Biquad<Length> filter(c);
+  EXPECT_NEAR(0.0f, filter.update(LengthInMeters(5.0f)).inMeters(), 1e-5f);
+  // Passes a 200 Hz signal.
+  float peak = 0.0f;
+  for (int i = 0; i < 1000; ++i) {
+    float x = 5.0f + std::sin(2.0f * (float)M_PI * 200.0f * (float)i / 1000.0f);
+    float y = filter.update(LengthInMeters(x)).inMeters();
+    if (i > 500) peak = std::max(peak, std::fabs(y));
+  }
+  EXPECT_NEAR(1.0f, peak, 0.05f);
+}
+
+TEST(Filter, FilterBankMatchesBiquads) {
+  // An odd number of channels, to cover the vector and the scalar paths.
+  constexpr size_t kChannels = 13;
+  FilterBank<Temperature, kChannels> bank(
+      BiquadLowPass(FrequencyInHertz(5.0f), FrequencyInHertz(100.0f)));
+  std::vector<Biquad<Temperature>> biquads(
+      kChannels,
+      Biquad<Temperature>(
+          BiquadLowPass(FrequencyInHertz(5.0f), FrequencyInHertz(100.0f))));
+  bank.setCoefficients(3, BiquadEma(0.5f));
+  biquads[3] = Biquad<Temperature>(BiquadEma(0.5f));
+  bank.setCoefficients(9, BiquadHighPass(FrequencyInHertz(5.0f),
+                                         FrequencyInHertz(100.0f), 2.0f));
+  biquads[9] = Biquad<Temperature>(
+      BiquadHighPass(FrequencyInHertz(5.0f), FrequencyInHertz(100.0f), 2.0f));
+  uint32_t seed = 1;
+  Temperature in[kChannels];
+  Temperature out[kChannels];
+  for (int step = 0; step < 200; ++step) {
+    for (size_t c = 0; c < kChannels; ++c) {
+      seed = seed * 1664525 + 1013904223;
+      // Channels start at different times, and have gaps.
+      bool unknown = (step < (int)c) || (seed >> 28) == 0;
+      in[c] = unknown ? UnknownTemperature()
+                      : TemperatureDegCelcius((float)(seed >> 16) * 0.001f);
+    }
+    bank.update(in, out);
+    for (size_t c = 0; c < kChannels; ++c) {
+      Temperature expected = biquads[c].update(in[c]);
+      if (expected.isUnknown()) {
+        EXPECT_TRUE(out[c].isUnknown());
+      } else {
+        // Bit-exact.
+        EXPECT_EQ(expected.degCelcius(), out[c].degCelcius())
+            << "step " << step << ", channel " << c;
+      }
+      EXPECT_EQ(out[c].isUnknown(), bank.value(c).isUnknown());
+      if (!out[c].isUnknown()) {
+        EXPECT_EQ(out[c], bank.value(c));
+      }
+    }
+  }
+  bank.reset();
+  EXPECT_TRUE(bank.value(0).isUnknown());
+}
+
+}  // namespace roo_quantity
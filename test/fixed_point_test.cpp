@@ -0,0 +1,161 @@
+#include "roo_quantity/fixed_point.h"
+
+#include <type_traits>
+
+#include "gtest/gtest.h"
+#include "roo_quantity.h"
+
+namespace roo_quantity {
+
+static_assert(sizeof(FixedVoltage) == sizeof(int32_t), "");
+static_assert(sizeof(FixedTime) == sizeof(int64_t), "");
+static_assert(
+    std::is_same<decltype(FixedVoltage() * FixedCurrent()), FixedPower>::value,
+    "");
+static_assert(std::is_same<decltype(FixedVoltage() / FixedCurrent()),
+                           FixedResistance>::value,
+              "");
+static_assert(
+    std::is_same<decltype(FixedCurrent() * FixedTime()), FixedCharge>::value,
+    "");
+
+TEST(FixedPoint, Construction) {
+  FixedVoltage v = FixedVoltage::FromScaled<-3>(3300);
+  EXPECT_EQ(3300000, v.count());
+  EXPECT_EQ(3300, v.inScaled<-3>());
+  EXPECT_EQ(3, v.inScaled<0>());
+  EXPECT_EQ(4, FixedVoltage::FromScaled<-3>(3500).inScaled<0>());
+  EXPECT_EQ(-4, FixedVoltage::FromScaled<-3>(-3500).inScaled<0>());
+
+  EXPECT_TRUE(FixedVoltage().isUnknown());
+  EXPECT_FALSE(v.isUnknown());
+}
+
+TEST(FixedPoint, FloatInterop) {
+  FixedCurrent i(CurrentInMilliAmperes(20.5f));
+  EXPECT_EQ(20500, i.count());
+  EXPECT_FLOAT_EQ(20.5f, i.toFloat().inMilliAmperes());
+  EXPECT_EQ(-1500, FixedCurrent(CurrentInMilliAmperes(-1.5f)).count());
+  EXPECT_TRUE(FixedCurrent(UnknownCurrent()).isUnknown());
+  EXPECT_TRUE(FixedCurrent().toFloat().isUnknown());
+  FixedCapacitance c(CapacitanceInNanoFarads(4.7f));
+  EXPECT_EQ(4700, c.count());
+}
+
+TEST(FixedPoint, Operators) {
+  FixedVoltage a = FixedVoltage::FromScaled<-3>(1500);
+  FixedVoltage b = FixedVoltage::FromScaled<-3>(2500);
+  EXPECT_EQ(4000000, (a + b).count());
+  EXPECT_EQ(1000000, (b - a).count());
+  EXPECT_EQ(-1500000, (-a).count());
+  EXPECT_EQ(3000000, (a * 2).count());
+  EXPECT_EQ(3000000, (2 * a).count());
+  EXPECT_EQ(750000, (a / 2).count());
+  a += b;
+  EXPECT_EQ(4000000, a.count());
+  a -= b;
+  a *= 3;
+  a /= 3;
+  EXPECT_EQ(1500000, a.count());
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(b > a);
+  EXPECT_TRUE(a <= a);
+  EXPECT_TRUE(a >= a);
+  EXPECT_TRUE(a == a);
+  EXPECT_TRUE(a != b);
+}
+
+TEST(FixedPoint, CrossProducts) {
+  FixedVoltage v = FixedVoltage::FromScaled<-3>(3300);
+  FixedCurrent i = FixedCurrent::FromScaled<-3>(20);
+  EXPECT_EQ(66000, (v * i).count());
+  EXPECT_EQ(66000, (i * v).count());
+  EXPECT_EQ(165000, (v / i).count());
+  EXPECT_EQ(20000, (FixedPower::FromScaled<-3>(66) / v).count());
+
+  FixedResistance r = FixedResistance::FromScaled<3>(10);
+  EXPECT_EQ(330, (v / r).count());
+  EXPECT_EQ(3300000, ((v / r) * r).count());
+
+  FixedTime t = FixedTime::FromScaled<0>(3600);
+  FixedCharge q = i * t;
+  EXPECT_EQ(72, q.inScaled<0>());
+  FixedWork w = (v * i) * t;
+  EXPECT_EQ(237600000, w.count());
+
+  // 1 µA / 3 µA = 0.333333.
+  auto ratio = FixedCurrent::FromCount(1) / FixedCurrent::FromCount(3);
+  EXPECT_EQ(333333, ratio.count());
+  EXPECT_EQ(-6, ratio.exp10);
+
+  // Rounds to nearest, with ties away from zero: 1.5 µW.
+  EXPECT_EQ(2, (FixedVoltage::FromCount(1500) * FixedCurrent::FromCount(1000))
+                   .count());
+  EXPECT_EQ(-2, (FixedVoltage::FromCount(-1500) * FixedCurrent::FromCount(1000))
+                    .count());
+  EXPECT_EQ(1, (FixedVoltage::FromCount(1400) * FixedCurrent::FromCount(1000))
+                   .count());
+}
+
+TEST(FixedPoint, DivisionByZero) {
+  EXPECT_TRUE((FixedVoltage::FromScaled<0>(1) / FixedCurrent::FromCount(0))
+                  .isUnknown());
+}
+
+TEST(FixedPoint, MainsPower) {
+  FixedVoltage v = FixedVoltage::FromScaled<0>(230);
+  FixedPower p = v * FixedCurrent::FromScaled<0>(10);
+  EXPECT_EQ(2300, p.inScaled<0>());
+  EXPECT_EQ("2.3 kW", p.asString());
+  // A three-phase 400 V, 63 A supply.
+  EXPECT_EQ("25.2 kW", (FixedVoltage::FromScaled<0>(400) *
+                        FixedCurrent::FromScaled<0>(63))
+                           .asString());
+  EXPECT_EQ(10, (p / v).inScaled<0>());
+  // An hour at 2.3 kW.
+  FixedWork w = p * FixedTime::FromScaled<0>(3600);
+  EXPECT_EQ(8280000, w.inScaled<0>());
+}
+
+TEST(FixedPoint, Overflow) {
+  // 2000 V / 1 µA = 2 GΩ, beyond the range of FixedResistance.
+  EXPECT_TRUE((FixedVoltage::FromScaled<0>(2000) / FixedCurrent::FromCount(1))
+                  .isUnknown());
+  // 1 MW for 10^7 s overflows the 64-bit product of the counts.
+  EXPECT_TRUE((FixedPower::FromScaled<6>(1) * FixedTime::FromScaled<7>(1))
+                  .isUnknown());
+}
+
+TEST(FixedPoint, UnknownPropagates) {
+  FixedVoltage v = FixedVoltage::FromScaled<0>(230);
+  FixedCurrent i = FixedCurrent::FromScaled<0>(10);
+  EXPECT_TRUE((FixedVoltage() * i).isUnknown());
+  EXPECT_TRUE((v * FixedCurrent()).isUnknown());
+  EXPECT_TRUE((FixedVoltage() / i).isUnknown());
+  EXPECT_TRUE((v / FixedCurrent()).isUnknown());
+  EXPECT_EQ("? W", (FixedVoltage() * i).asString());
+}
+
+TEST(FixedPoint, Format) {
+  EXPECT_EQ("3.3 V", FixedVoltage::FromScaled<-3>(3300).asString());
+  EXPECT_EQ("20 mA", FixedCurrent::FromScaled<-3>(20).asString());
+  EXPECT_EQ("-17.15 mW", FixedPower::FromScaled<-6>(-17150).asString());
+  EXPECT_EQ("343 kΩ", FixedResistance::FromScaled<3>(343).asString());
+  EXPECT_EQ("4.7 nF", FixedCapacitance::FromCount(4700).asString());
+  EXPECT_EQ("1.5 s", FixedTime::FromScaled<-3>(1500).asString());
+  EXPECT_EQ("0 V", FixedVoltage::FromCount(0).asString());
+  EXPECT_EQ("? A", FixedCurrent().asString());
+  char out[8];
+  EXPECT_EQ(7u, FixedVoltage::FromCount(1234567).formatTo(out, 8));
+  EXPECT_STREQ("1.23457", out);
+}
+
+TEST(FixedPoint, FormatMatchesFloat) {
+  for (int32_t count : {1, 7, 999, 1000, 1001, 123456, 999999, 1000000,
+                        1234567, 999999500, -42, 2147483647}) {
+    FixedVoltage v = FixedVoltage::FromCount(count);
+    EXPECT_EQ(v.toFloat().asString(), v.asString()) << count;
+  }
+}
+
+}  // namespace roo_quantity
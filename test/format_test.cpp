@@ -0,0 +1,123 @@
+#include "roo_quantity/format.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace roo_quantity {
+
+namespace {
+
+std::string Format(float val) {
+  char out[32];
+  size_t len = FormatFloat(val, out, 32);
+  EXPECT_EQ(strlen(out), len);
+  return out;
+}
+
+std::string Printf(float val) {
+  char out[32];
+  snprintf(out, 32, "%g", val);
+  return out;
+}
+
+}  // namespace
+
+TEST(Format, FormatFloat) {
+  EXPECT_EQ("0", Format(0.0f));
+  EXPECT_EQ("-0", Format(-0.0f));
+  EXPECT_EQ("1", Format(1.0f));
+  EXPECT_EQ("-2", Format(-2.0f));
+  EXPECT_EQ("1.5", Format(1.5f));
+  EXPECT_EQ("15.5", Format(15.5f));
+  EXPECT_EQ("1.2433", Format(1.2433f));
+  EXPECT_EQ("0.0155", Format(0.0155f));
+  EXPECT_EQ("0.0001503", Format(0.0001503f));
+  EXPECT_EQ("1.503e-05", Format(0.00001503f));
+  EXPECT_EQ("123456", Format(123456.0f));
+  EXPECT_EQ("1.23457e+06", Format(1234567.0f));
+  EXPECT_EQ("1e+06", Format(999999.6f));
+  EXPECT_EQ("0.333333", Format(1.0f / 3.0f));
+  EXPECT_EQ("3.40282e+38", Format(std::numeric_limits<float>::max()));
+  EXPECT_EQ("1.17549e-38", Format(std::numeric_limits<float>::min()));
+  EXPECT_EQ("1.4013e-45", Format(std::numeric_limits<float>::denorm_min()));
+}
+
+TEST(Format, FormatFloatNonFinite) {
+  EXPECT_EQ("nan", Format(std::nanf("")));
+  EXPECT_EQ("inf", Format(std::numeric_limits<float>::infinity()));
+  EXPECT_EQ("-inf", Format(-std::numeric_limits<float>::infinity()));
+}
+
+TEST(Format, FormatFloatTruncates) {
+  char out[5];
+  EXPECT_EQ(4u, FormatFloat(1.23456f, out, 5));
+  EXPECT_STREQ("1.23", out);
+  EXPECT_EQ(0u, FormatFloat(1.23456f, out, 1));
+  EXPECT_STREQ("", out);
+}
+
+TEST(Format, FormatFloatMatchesPrintf) {
+  // Powers of ten, and their neighbors, are the most likely to trip the
+  // decimal exponent estimation.
+  for (int e = -45; e <= 38; ++e) {
+    float p = std::pow(10.0f, (float)e);
+    for (float v : {p, std::nextafter(p, 0.0f),
+                    std::nextafter(p, std::numeric_limits<float>::max())}) {
+      ASSERT_EQ(Printf(v), Format(v)) << v;
+    }
+  }
+  // Values that round up at the 6th digit.
+  for (float v : {9.999995f, 99.99995f, 0.9999995f, 999999.5f, 1.0000005f}) {
+    ASSERT_EQ(Printf(v), Format(v)) << v;
+  }
+  // Pseudo-random bit patterns.
+  uint32_t bits = 12345;
+  for (int i = 0; i < 100000; ++i) {
+    bits = bits * 1664525 + 1013904223;
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    if (std::isnan(v)) continue;
+    ASSERT_EQ(Printf(v), Format(v)) << bits;
+  }
+}
+
+TEST(Format, WriteDecimal6) {
+  char out[internal::kMaxDecimal6Length];
+  EXPECT_EQ("1.5e+07", std::string(out, internal::WriteDecimal6(
+                                            {150000, 7}, 0, out)));
+  EXPECT_EQ("0.0123", std::string(out, internal::WriteDecimal6(
+                                           {123000, 1}, 3, out)));
+  EXPECT_EQ("0", std::string(out, internal::WriteDecimal6({0, 0}, 0, out)));
+}
+
+TEST(Format, FormatInUnits) {
+  static constexpr UnitFormat kUnits[] = {
+      {1000.0f, 0.001f, " km"},
+      {1.0f, 1.0f, " m"},
+      {0.0f, 1000.0f, " mm"},
+  };
+  char out[16];
+  EXPECT_EQ(6u, FormatInUnits(1500.0f, kUnits, " m", out, 16));
+  EXPECT_STREQ("1.5 km", out);
+  FormatInUnits(1000.0f, kUnits, " m", out, 16);
+  EXPECT_STREQ("1 km", out);
+  FormatInUnits(999.0f, kUnits, " m", out, 16);
+  EXPECT_STREQ("999 m", out);
+  FormatInUnits(-2.0f, kUnits, " m", out, 16);
+  EXPECT_STREQ("-2 m", out);
+  FormatInUnits(0.0025f, kUnits, " m", out, 16);
+  EXPECT_STREQ("2.5 mm", out);
+  FormatInUnits(0.0f, kUnits, " m", out, 16);
+  EXPECT_STREQ("0 m", out);
+  FormatInUnits(std::nanf(""), kUnits, " m", out, 16);
+  EXPECT_STREQ("? m", out);
+  FormatInUnits(-std::numeric_limits<float>::infinity(), kUnits, " m", out,
+                16);
+  EXPECT_STREQ("-inf km", out);
+}
+
+}  // namespace roo_quantity
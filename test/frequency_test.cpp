@@ -96,4 +96,12 @@ TEST(Frequency, String) {
   EXPECT_EQ("? Hz", Frequency().asString());
 }
 
+TEST(Frequency, FromDuration) {
+  EXPECT_FLOAT_EQ(50.0f, FrequencyFromPeriod(roo_time::Millis(20)).inHertz());
+  EXPECT_FLOAT_EQ(1000000.0f,
+                  FrequencyFromPeriod(roo_time::Micros(1)).inHertz());
+  EXPECT_FLOAT_EQ(
+      2.5f, FrequencyFromCount(150.0f, roo_time::Minutes(1)).inHertz());
+}
+
 }  // namespace roo_quantity
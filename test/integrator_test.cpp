@@ -0,0 +1,136 @@
+#include "roo_quantity/integrator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/charge.h"
+#include "roo_quantity/current.h"
+#include "roo_quantity/power.h"
+#include "roo_quantity/volume.h"
+#include "roo_quantity/volume_flow_rate.h"
+#include "roo_quantity/work.h"
+
+namespace roo_quantity {
+
+TEST(Integrator, Types) {
+  Integrator<Power> energy;
+  Work work = energy.total();
+  EXPECT_EQ(WorkInJoules(0.0f), work);
+
+  Integrator<Current, DoubleCharge> charge;
+  DoubleCharge coulombs = charge.total();
+  EXPECT_EQ(DoubleChargeInCoulombs(0.0), coulombs);
+
+  RectangleIntegrator<VolumeFlowRate> flow;
+  Volume volume = flow.total();
+  EXPECT_EQ(VolumeInCubicMeters(0.0f), volume);
+}
+
+TEST(Integrator, Trapezoidal) {
+  Integrator<Power> energy;
+  // The first sample only sets the starting point.
+  energy.addSample(PowerInWatts(10.0f), TimeInSeconds(100.0f));
+  EXPECT_EQ(WorkInJoules(0.0f), energy.total());
+  energy.addSample(PowerInWatts(20.0f), TimeInSeconds(2.0f));
+  EXPECT_EQ(WorkInJoules(30.0f), energy.total());
+  energy.addSample(PowerInWatts(20.0f), TimeInSeconds(0.5f));
+  EXPECT_EQ(WorkInJoules(40.0f), energy.total());
+
+  // Intervals adjacent to unknown samples are skipped.
+  energy.addSample(UnknownPower(), TimeInSeconds(1.0f));
+  energy.addSample(PowerInWatts(4.0f), TimeInSeconds(1.0f));
+  EXPECT_EQ(WorkInJoules(40.0f), energy.total());
+  energy.addSample(PowerInWatts(6.0f), TimeInSeconds(1.0f));
+  EXPECT_EQ(WorkInJoules(45.0f), energy.total());
+
+  energy.reset();
+  EXPECT_EQ(WorkInJoules(0.0f), energy.total());
+}
+
+TEST(Integrator, Rectangle) {
+  RectangleIntegrator<Current> charge;
+  charge.addSample(CurrentInAmperes(2.0f), TimeInSeconds(3.0f));
+  charge.addSample(UnknownCurrent(), TimeInSeconds(3.0f));
+  charge.addSample(CurrentInAmperes(1.0f), TimeInSeconds(0.5f));
+  EXPECT_EQ(ChargeInCoulombs(6.5f), charge.total());
+}
+
+template <typename I>
+void ExpectBatchMatchesSamples(const std::vector<float>& samples) {
+  QuantitySpan<const Power> span(samples.data(), samples.size());
+  I batch, single;
+  // Split into uneven batches, to cover joining them.
+  batch.addSamples(span.subspan(0, 3), TimeInMilliseconds(10.0f));
+  batch.addSamples(span.subspan(3, samples.size() - 3),
+                   TimeInMilliseconds(10.0f));
+  for (size_t i = 0; i < samples.size(); ++i) {
+    single.addSample(span[i], TimeInMilliseconds(10.0f));
+  }
+  EXPECT_NEAR(single.total().inJoules(), batch.total().inJoules(),
+              std::fabs(single.total().inJoules()) * 1e-6f);
+}
+
+TEST(Integrator, BatchMatchesSamples) {
+  std::vector<float> samples;
+  for (int i = 0; i < 1000; ++i) samples.push_back(100.0f + (float)(i % 13));
+  ExpectBatchMatchesSamples<Integrator<Power>>(samples);
+  ExpectBatchMatchesSamples<RectangleIntegrator<Power>>(samples);
+  samples[500] = NAN;
+  samples[1] = NAN;
+  ExpectBatchMatchesSamples<Integrator<Power>>(samples);
+  ExpectBatchMatchesSamples<RectangleIntegrator<Power>>(samples);
+}
+
+TEST(Integrator, BatchKeepsDoublePrecision) {
+  // In float, 2^24 + 1 rounds to 2^24.
+  std::vector<float> samples(1000, 1.0f);
+  samples[0] = 16777216.0f;
+  QuantitySpan<const Power> span(samples.data(), samples.size());
+  RectangleIntegrator<Power, DoubleWork> rectangle;
+  rectangle.addSamples(span, TimeInSeconds(1.0f));
+  EXPECT_EQ(16777216.0 + 999.0, rectangle.total().inJoules());
+  Integrator<Power, DoubleWork> batch, single;
+  batch.addSamples(span, TimeInSeconds(1.0f));
+  for (size_t i = 0; i < samples.size(); ++i) {
+    single.addSample(span[i], TimeInSeconds(1.0f));
+  }
+  EXPECT_EQ(single.total().inJoules(), batch.total().inJoules());
+}
+
+TEST(Integrator, KeepsAccumulatingPast2To24Steps) {
+  // Naive float accumulation of 1 J steps stops at 2^24 J.
+  constexpr int kSteps = 20 * 1000 * 1000;
+  float naive = 0.0f;
+  Integrator<Power> energy;
+  for (int i = 0; i <= kSteps; ++i) {
+    naive += 1.0f;
+    energy.addSample(PowerInWatts(1.0f), TimeInSeconds(1.0f));
+  }
+  EXPECT_EQ(16777216.0f, naive);
+  EXPECT_EQ(WorkInJoules(20000000.0f), energy.total());
+}
+
+TEST(Integrator, BillionSamples) {
+  // 10^9 samples of a noisy ~230 W load at 1 kHz (about 11.6 days).
+  constexpr size_t kBlock = 1000 * 1000;
+  constexpr int kBlocks = 1000;
+  std::vector<float> block(kBlock);
+  uint32_t seed = 1;
+  double block_sum = 0.0;
+  for (size_t i = 0; i < kBlock; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    block[i] = 230.0f + (float)(seed >> 16) * 1e-4f;
+    block_sum += block[i];
+  }
+  QuantitySpan<const Power> span(block.data(), kBlock);
+  RectangleIntegrator<Power> energy;
+  for (int i = 0; i < kBlocks; ++i) {
+    energy.addSamples(span, TimeInMilliseconds(1.0f));
+  }
+  double expected = block_sum * kBlocks * 0.001;
+  EXPECT_NEAR(expected, energy.total().inJoules(), expected * 1e-6);
+}
+
+}  // namespace roo_quantity
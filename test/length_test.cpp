@@ -96,4 +96,53 @@ TEST(Length, AsString) {
   EXPECT_EQ("0 m", LengthInMeters(0).asString());
 }
 
+TEST(Length, FormatTo) {
+  char out[16];
+  EXPECT_EQ(5u, LengthInMeters(0.5f).formatTo(out, 16));
+  EXPECT_STREQ("50 cm", out);
+  EXPECT_EQ(3u, UnknownLength().formatTo(out, 16));
+  EXPECT_STREQ("? m", out);
+  EXPECT_EQ(2u, LengthInMeters(-2).formatTo(out, 3));
+  EXPECT_STREQ("-2", out);
+}
+
+TEST(Length, ConstexprUnknown) {
+  constexpr Length kDefault;
+  constexpr Length kUnknown = UnknownLength();
+  EXPECT_TRUE(kDefault.isUnknown());
+  EXPECT_TRUE(kUnknown.isUnknown());
+}
+
+TEST(DoubleLength, Precision) {
+  // Float meters have a resolution of 6 cm at 1000 km.
+  DoubleLength d = DoubleLengthInKilometers(1000.0);
+  d += LengthInMillimeters(1.0f);
+  EXPECT_NEAR(1000000.001, d.inMeters(), 1e-9);
+  EXPECT_NEAR(1.0, (d - DoubleLengthInKilometers(1000.0)).inMillimeters(),
+              1e-6);
+  EXPECT_FLOAT_EQ(1000.0f, d.toFloat().inKilometers());
+  EXPECT_DOUBLE_EQ(9460730472580800.0,
+                   DoubleLengthInLightYears(1.0).inMeters());
+}
+
+TEST(DoubleLength, MixedPrecision) {
+  Length f = LengthInMeters(1.5f);
+  DoubleLength d = DoubleLengthInKilometers(2.0);
+  DoubleLength sum = f + d;
+  EXPECT_DOUBLE_EQ(2001.5, sum.inMeters());
+  sum = d - f;
+  EXPECT_DOUBLE_EQ(1998.5, sum.inMeters());
+  EXPECT_TRUE(f < d);
+  EXPECT_TRUE(d > f);
+  EXPECT_TRUE(DoubleLength(f) == f);
+  EXPECT_DOUBLE_EQ(2000.0 / 1.5, d / f);
+  EXPECT_TRUE(UnknownDoubleLength().isUnknown());
+  EXPECT_TRUE(DoubleLength(UnknownLength()).isUnknown());
+}
+
+TEST(DoubleLength, AsString) {
+  EXPECT_EQ("2.5 km", DoubleLengthInMeters(2500.0).asString());
+  EXPECT_EQ("? m", UnknownDoubleLength().asString());
+}
+
 }  // namespace roo_quantity
@@ -0,0 +1,69 @@
+#include "roo_quantity/literals.h"
+
+#include "gtest/gtest.h"
+#include "roo_quantity/fixed_point.h"
+
+namespace roo_quantity {
+
+using namespace roo_quantity::literals;
+
+// Factories, accessors, arithmetic and comparisons all fold at compile time.
+constexpr Voltage kSupply = VoltageInMilliVolts(3300.0f);
+constexpr Current kLoad = CurrentInMilliAmperes(20.0f);
+constexpr Power kPower = kSupply * kLoad;
+constexpr Pressure kThreshold = PressureInBars(0.1f);
+constexpr Temperature kRoom = TemperatureDegCelcius(25.0f);
+
+static_assert(kSupply.inVolts() > 3.29f && kSupply.inVolts() < 3.31f, "");
+static_assert(kPower > PowerInMilliWatts(65.0f), "");
+static_assert(kPower < PowerInMilliWatts(67.0f), "");
+static_assert(kThreshold == PressureInKiloPascals(10.0f), "");
+static_assert((kSupply - VoltageInVolts(0.3f)) / 2.0f < VoltageInVolts(1.6f),
+              "");
+static_assert(kRoom.degKelvin() == 298.15f, "");
+static_assert((kRoom + TemperatureDeltaDegCelcius(5.0f)).degCelcius() == 30.0f,
+              "");
+static_assert(UnknownVoltage().isUnknown(), "");
+static_assert(!kSupply.isUnknown(), "");
+static_assert(DoubleLength(LengthInMeters(2.0f)).inMillimeters() == 2000.0,
+              "");
+
+constexpr Voltage Accumulate() {
+  Voltage v = VoltageInVolts(1.0f);
+  v += VoltageInVolts(2.0f);
+  v *= 2.0f;
+  return v;
+}
+static_assert(Accumulate() == VoltageInVolts(6.0f), "");
+
+static_assert(FixedVoltage(VoltageInMilliVolts(3300.0f)).count() == 3300000,
+              "");
+
+TEST(Literals, Values) {
+  EXPECT_EQ(VoltageInVolts(3.3f), 3.3_V);
+  EXPECT_EQ(VoltageInMilliVolts(3300.0f), 3300_mV);
+  EXPECT_EQ(CurrentInMilliAmperes(20.0f), 20_mA);
+  EXPECT_EQ(TemperatureDegCelcius(25.0f), 25_degC);
+  EXPECT_EQ(TemperatureDegFahrenheit(77.0f), 77_degF);
+  EXPECT_EQ(TimeInMilliseconds(10.0f), 10_ms);
+  EXPECT_EQ(TimeInHours(1.5f), 1.5_h);
+  EXPECT_EQ(ResistanceInKiloOhms(4.7f), 4.7_kOhm);
+  EXPECT_EQ(CapacitanceInNanoFarads(100.0f), 100_nF);
+  EXPECT_EQ(FrequencyInKiloHertz(50.0f), 50_kHz);
+  EXPECT_EQ(LengthInCentimeters(2.5f), 2.5_cm);
+  EXPECT_EQ(MassInGrams(250.0f), 250_g);
+  EXPECT_EQ(PressureInHectoPascals(1013.25f), 1013.25_hPa);
+  EXPECT_EQ(PowerInWatts(60.0f), 60_W);
+  EXPECT_EQ(WorkInKiloJoules(4.2f), 4.2_kJ);
+  EXPECT_EQ(ChargeInCoulombs(1.0f), 1_C);
+}
+
+TEST(Literals, Constexpr) {
+  constexpr Power kBudget = 3.3_V * 20_mA;
+  static_assert(kBudget > 65_mW && kBudget < 67_mW, "");
+  constexpr Time kTimeout = 10_ms;
+  static_assert(kTimeout > 9999_us && kTimeout < 10001_us, "");
+  EXPECT_FLOAT_EQ(66.0f, kBudget.inMilliWatts());
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,131 @@
+#include "roo_quantity/median_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/volume_flow_rate.h"
+
+namespace roo_quantity {
+
+namespace {
+
+// Median of the known values, by sorting.
+float NaiveMedian(std::vector<float> v) {
+  v.erase(std::remove_if(v.begin(), v.end(), [](float x) { return x != x; }),
+          v.end());
+  if (v.empty()) return NAN;
+  std::sort(v.begin(), v.end());
+  size_t n = v.size();
+  return n % 2 == 1 ? v[n / 2] : v[n / 2 - 1] + (v[n / 2] - v[n / 2 - 1]) / 2;
+}
+
+}  // namespace
+
+TEST(MedianFilter, Basic) {
+  MedianFilter<Pressure, 3> filter;
+  EXPECT_TRUE(filter.value().isUnknown());
+  EXPECT_EQ(PressureInPascals(100.0f), filter.update(PressureInPascals(100)));
+  EXPECT_EQ(PressureInPascals(101.0f), filter.update(PressureInPascals(102)));
+  EXPECT_EQ(PressureInPascals(101.0f), filter.update(PressureInPascals(101)));
+  // A spike is rejected.
+  EXPECT_EQ(PressureInPascals(102.0f), filter.update(PressureInPascals(9999)));
+  EXPECT_EQ(PressureInPascals(101.0f), filter.update(PressureInPascals(100)));
+  // A step is preserved.
+  filter.update(PressureInPascals(200));
+  EXPECT_EQ(PressureInPascals(200.0f), filter.update(PressureInPascals(200)));
+  // Unknown samples are skipped.
+  EXPECT_EQ(PressureInPascals(200.0f), filter.update(UnknownPressure()));
+  EXPECT_EQ(PressureInPascals(200.0f), filter.update(UnknownPressure()));
+  EXPECT_TRUE(filter.update(UnknownPressure()).isUnknown());
+  filter.update(PressureInPascals(5));
+  filter.reset();
+  EXPECT_TRUE(filter.value().isUnknown());
+}
+
+TEST(MedianFilter, Temperature) {
+  MedianFilter<Temperature, 5> filter;
+  for (float c : {20.0f, 21.0f, -40.0f, 22.0f, 23.0f}) {
+    filter.update(TemperatureDegCelcius(c));
+  }
+  EXPECT_EQ(TemperatureDegCelcius(21.0f), filter.value());
+}
+
+TEST(MedianFilter, MatchesNaive) {
+  constexpr size_t kWindow = 8;
+  MedianFilter<Pressure, kWindow> filter;
+  std::vector<float> history;
+  uint32_t seed = 3;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    // Few distinct values, to cover duplicates.
+    float x = (seed >> 28) == 0 ? NAN : (float)((seed >> 16) % 20);
+    history.push_back(x);
+    float median = filter.update(PressureInPascals(x)).inPascals();
+    std::vector<float> window(
+        history.end() - std::min(history.size(), kWindow), history.end());
+    float expected = NaiveMedian(window);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(median)) << i;
+    } else {
+      EXPECT_EQ(expected, median) << i;
+    }
+  }
+}
+
+TEST(MedianFilter, MedianAbsoluteDeviation) {
+  uint32_t seed = 5;
+  for (int trial = 0; trial < 200; ++trial) {
+    internal::SortedWindow<float, 9> window;
+    std::vector<float> values;
+    size_t n = 1 + trial % 9;
+    for (size_t i = 0; i < n; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      float x = (float)((seed >> 16) % 50);
+      window.push(x);
+      values.push_back(x);
+    }
+    float m = NaiveMedian(values);
+    EXPECT_EQ(m, window.median());
+    std::vector<float> deviations;
+    for (float x : values) deviations.push_back(std::fabs(x - m));
+    EXPECT_EQ(NaiveMedian(deviations), window.medianAbsoluteDeviation(m))
+        << trial;
+  }
+}
+
+TEST(HampelFilter, RejectsOutliers) {
+  HampelFilter<VolumeFlowRate, 7> filter;
+  float values[] = {10.0f, 10.2f, 9.9f, 10.1f, 50.0f, 10.0f, 9.8f, 10.3f};
+  for (float v : values) {
+    VolumeFlowRate out = filter.update(VolumeFlowRateInLitersPerSecond(v));
+    if (v == 50.0f) {
+      EXPECT_TRUE(filter.lastWasOutlier());
+      // The median of 10.0, 10.2, 9.9, 10.1, and 50.0.
+      EXPECT_NEAR(10.1f, out.inLitersPerSecond(), 1e-4f);
+    } else {
+      // Inliers are passed through unchanged.
+      EXPECT_FALSE(filter.lastWasOutlier()) << v;
+      EXPECT_EQ(VolumeFlowRateInLitersPerSecond(v), out);
+    }
+  }
+  EXPECT_TRUE(filter.update(UnknownVolumeFlowRate()).isUnknown());
+  EXPECT_FALSE(filter.lastWasOutlier());
+}
+
+TEST(HampelFilter, Threshold) {
+  HampelFilter<Pressure, 5> strict(1.0f);
+  HampelFilter<Pressure, 5> lenient(10.0f);
+  for (float v : {100.0f, 102.0f, 98.0f, 101.0f, 99.0f, 106.0f}) {
+    strict.update(PressureInPascals(v));
+    lenient.update(PressureInPascals(v));
+  }
+  EXPECT_TRUE(strict.lastWasOutlier());
+  EXPECT_FALSE(lenient.lastWasOutlier());
+}
+
+}  // namespace roo_quantity
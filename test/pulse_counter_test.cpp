@@ -0,0 +1,113 @@
+#include "roo_quantity/pulse_counter.h"
+
+#include "gtest/gtest.h"
+
+namespace roo_quantity {
+
+namespace {
+
+roo_time::Uptime At(int64_t micros) {
+  return roo_time::Uptime::Start() + roo_time::Micros(micros);
+}
+
+}  // namespace
+
+TEST(PulseRate, Conversions) {
+  PulseRate rate{150, roo_time::Seconds(2)};
+  EXPECT_FLOAT_EQ(75.0f, rate.frequency().inHertz());
+  EXPECT_FLOAT_EQ(2250.0f, rate.rotationalFrequency(2).inRPM());
+  // YF-S201: 450 pulses per liter.
+  EXPECT_FLOAT_EQ(1.0f / 6.0f, rate.flowRate(450.0f).inLitersPerSecond());
+  EXPECT_FLOAT_EQ(1.0f / 3.0f, rate.volume(450.0f).inLiters());
+}
+
+TEST(PulseRate, Empty) {
+  EXPECT_EQ(0.0f, (PulseRate{0, roo_time::Seconds(1)}).frequency().inHertz());
+  EXPECT_TRUE((PulseRate{0, roo_time::Micros(0)}).frequency().isUnknown());
+  EXPECT_TRUE((PulseRate{5, roo_time::Micros(0)}).frequency().isUnknown());
+}
+
+TEST(PulseCounter, Windows) {
+  PulseCounter counter(At(1000000));
+  for (int i = 0; i < 40; ++i) counter.pulse();
+  PulseRate rate = counter.sample(At(1500000));
+  EXPECT_EQ(40u, rate.pulses);
+  EXPECT_EQ(500000, rate.interval.inMicros());
+  EXPECT_FLOAT_EQ(80.0f, rate.frequency().inHertz());
+
+  counter.add(1000);
+  counter.pulse();
+  rate = counter.sample(At(2500000));
+  EXPECT_EQ(1001u, rate.pulses);
+  EXPECT_EQ(1000000, rate.interval.inMicros());
+
+  rate = counter.sample(At(3500000));
+  EXPECT_EQ(0u, rate.pulses);
+  EXPECT_EQ(0.0f, rate.frequency().inHertz());
+}
+
+TEST(PulseCounter, Reset) {
+  PulseCounter counter;
+  counter.add(10);
+  counter.reset(At(200));
+  counter.pulse();
+  PulseRate rate = counter.sample(At(300));
+  EXPECT_EQ(1u, rate.pulses);
+  EXPECT_EQ(100, rate.interval.inMicros());
+}
+
+TEST(PulsePeriodMeter, Periods) {
+  PulsePeriodMeter meter;
+  // 4 Hz, starting at an arbitrary time.
+  for (int i = 0; i < 5; ++i) meter.pulse(At(7000000 + i * 250000));
+  PulseRate rate = meter.sample(At(8100000));
+  EXPECT_EQ(4u, rate.pulses);
+  EXPECT_EQ(1000000, rate.interval.inMicros());
+  EXPECT_FLOAT_EQ(4.0f, rate.frequency().inHertz());
+
+  // The next sample starts at the last pulse.
+  meter.pulse(At(8250000));
+  rate = meter.sample(At(8300000));
+  EXPECT_EQ(1u, rate.pulses);
+  EXPECT_EQ(250000, rate.interval.inMicros());
+}
+
+TEST(PulsePeriodMeter, SlowPulses) {
+  PulsePeriodMeter meter;
+  EXPECT_TRUE(meter.sample(At(0)).frequency().isUnknown());
+  meter.pulse(At(1000000));
+  // No complete period yet: zero pulses since the last one.
+  PulseRate rate = meter.sample(At(2000000));
+  EXPECT_EQ(0u, rate.pulses);
+  EXPECT_EQ(1000000, rate.interval.inMicros());
+  EXPECT_EQ(0.0f, rate.frequency().inHertz());
+  // The first pulse is kept.
+  meter.pulse(At(4000000));
+  rate = meter.sample(At(4000000));
+  EXPECT_EQ(1u, rate.pulses);
+  EXPECT_FLOAT_EQ(1.0f / 3.0f, rate.frequency().inHertz());
+}
+
+TEST(PulsePeriodMeter, TimestampWraparound) {
+  PulsePeriodMeter meter;
+  // Straddles 2^32 microseconds.
+  meter.pulse(At(4294967000LL));
+  meter.pulse(At(4294967000LL + 1000));
+  PulseRate rate = meter.sample(At(4294967000LL + 1500));
+  EXPECT_EQ(1u, rate.pulses);
+  EXPECT_EQ(1000, rate.interval.inMicros());
+}
+
+TEST(PulsePeriodMeter, Reset) {
+  PulsePeriodMeter meter;
+  meter.pulse(At(0));
+  meter.pulse(At(100));
+  meter.reset();
+  meter.pulse(At(1000));
+  meter.pulse(At(1400));
+  PulseRate rate = meter.sample(At(1500));
+  EXPECT_EQ(1u, rate.pulses);
+  EXPECT_EQ(400, rate.interval.inMicros());
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,110 @@
+#include "roo_quantity/quantity.h"
+
+#include <type_traits>
+
+#include "gtest/gtest.h"
+#include "roo_quantity.h"
+
+namespace roo_quantity {
+
+static_assert(std::is_same<Quantity<dimension::Force>, Force>::value, "");
+static_assert(std::is_same<Quantity<Dimensionless>, float>::value, "");
+static_assert(
+    std::is_same<Quantity<dimension::Force, double>,
+                 GenericQuantity<dimension::Force, double>>::value,
+    "");
+
+static_assert(sizeof(Voltage) == sizeof(float), "");
+static_assert(sizeof(GenericQuantity<dimension::Force, double>) ==
+                  sizeof(double),
+              "");
+static_assert(std::is_trivially_copyable<Length>::value, "");
+static_assert(std::is_trivially_copyable<TemperatureDelta>::value, "");
+
+static_assert(std::is_same<decltype(Pressure() * Area()), Force>::value, "");
+static_assert(std::is_same<decltype(Power() / Velocity()), Force>::value, "");
+static_assert(std::is_same<decltype(Length() / Length()), float>::value, "");
+static_assert(std::is_same<decltype(1.0f / Time()), Frequency>::value, "");
+
+// 1/m^3 * m = 1/m^2. (Before the generic operators, this was LineicNumber.)
+static_assert(
+    std::is_same<decltype(Length() * VolumicNumber()), AreicNumber>::value,
+    "");
+static_assert(
+    std::is_same<decltype(VolumicNumber() * Length()), AreicNumber>::value,
+    "");
+
+TEST(Quantity, LengthTimesVolumicNumber) {
+  AreicNumber density =
+      LengthInMeters(2.0f) * VolumicNumberInUnitsPerCubicMeter(3.0f);
+  EXPECT_FLOAT_EQ(6.0f, density.inUnitsPerSquareMeter());
+}
+
+TEST(Quantity, FromSiUnits) {
+  constexpr Length l = Length::FromSiUnits(2.5f);
+  static_assert(l.inSiUnits() == 2.5f, "");
+  EXPECT_FLOAT_EQ(2.5f, l.inMeters());
+  EXPECT_FLOAT_EQ(1.5f, CurrentInMilliAmperes(1500.0f).inSiUnits());
+}
+
+TEST(Quantity, NewCrossProducts) {
+  Force f = PressureInPascals(1000.0f) * AreaInSquareMeters(0.5f);
+  EXPECT_FLOAT_EQ(500.0f, f.inNewtons());
+
+  f = PowerInWatts(100.0f) / VelocityInMetersPerSecond(4.0f);
+  EXPECT_FLOAT_EQ(25.0f, f.inNewtons());
+
+  Power p = f * VelocityInMetersPerSecond(2.0f);
+  EXPECT_FLOAT_EQ(50.0f, p.inWatts());
+
+  Charge q = CapacitanceInMicroFarads(10.0f) * VoltageInVolts(5.0f);
+  EXPECT_FLOAT_EQ(50.0f, q.inMicroCoulombs());
+
+  Velocity v = LengthInMeters(10.0f) * FrequencyInHertz(3.0f);
+  EXPECT_FLOAT_EQ(30.0f, v.inMetersPerSecond());
+
+  Frequency rate = VolumeFlowRateInCubicMetersPerSecond(2.0f) /
+                   VolumeInCubicMeters(8.0f);
+  EXPECT_FLOAT_EQ(0.25f, rate.inHertz());
+}
+
+TEST(Quantity, Dimensionless) {
+  float ratio = LengthInMeters(3.0f) / LengthInMeters(2.0f);
+  EXPECT_FLOAT_EQ(1.5f, ratio);
+  float cycles = FrequencyInHertz(50.0f) * TimeInSeconds(0.5f);
+  EXPECT_FLOAT_EQ(25.0f, cycles);
+  float count =
+      AreaInSquareMeters(2.0f) * AreicNumberInUnitsPerSquareMeter(3.0f);
+  EXPECT_FLOAT_EQ(6.0f, count);
+}
+
+TEST(Quantity, Generic) {
+  // Force * Current has no named class.
+  auto x = ForceInNewtons(2.0f) * CurrentInAmperes(3.0f);
+  static_assert(
+      std::is_same<decltype(x),
+                   GenericQuantity<Dimension<1, 1, -2, 1, 0>, float>>::value,
+      "");
+  EXPECT_FLOAT_EQ(6.0f, x.inSiUnits());
+  x += x;
+  EXPECT_FLOAT_EQ(12.0f, x.inSiUnits());
+  Force f = x / CurrentInAmperes(4.0f);
+  EXPECT_FLOAT_EQ(3.0f, f.inNewtons());
+
+  GenericQuantity<dimension::Force, double> unknown;
+  EXPECT_TRUE(unknown.isUnknown());
+}
+
+TEST(Quantity, ImplicitConversion) {
+  Time t = TimeInSeconds(1.0f) + roo_time::Millis(500);
+  EXPECT_FLOAT_EQ(1.5f, t.inSeconds());
+}
+
+TEST(Quantity, TemperatureDelta) {
+  TemperatureDelta dt = TemperatureDeltaDegCelcius(10.0f);
+  EXPECT_FLOAT_EQ(2.0f, dt / TemperatureDeltaDegCelcius(5.0f));
+  Temperature t = TemperatureDegCelcius(20.0f) + dt * 0.5f;
+  EXPECT_FLOAT_EQ(25.0f, t.degCelcius());
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,133 @@
+#include "roo_quantity/rollup_history.h"
+
+#include "gtest/gtest.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+
+namespace {
+
+roo_time::Uptime At(int64_t seconds) {
+  return roo_time::Uptime::Start() + roo_time::Micros(seconds * 1000000);
+}
+
+using History = RollupHistory<Temperature, 3, 60>;
+
+History MakeHistory() {
+  return History(
+      {roo_time::Seconds(1), roo_time::Minutes(1), roo_time::Hours(1)});
+}
+
+}  // namespace
+
+TEST(RollupHistory, Empty) {
+  History history = MakeHistory();
+  Rollup<Temperature> out[4];
+  EXPECT_EQ(0u, history.query(0, At(0), At(100), out, 4));
+  Rollup<Temperature> summary = history.summary(At(0), At(100));
+  EXPECT_EQ(0u, summary.count);
+  EXPECT_TRUE(summary.mean.isUnknown());
+}
+
+TEST(RollupHistory, FinestLevel) {
+  History history = MakeHistory();
+  history.add(At(10), TemperatureDegCelcius(20.0f));
+  history.add(At(10), TemperatureDegCelcius(22.0f));
+  history.add(At(12), TemperatureDegCelcius(25.0f));
+  history.add(At(12), Temperature());
+  Rollup<Temperature> out[10];
+  ASSERT_EQ(3u, history.query(0, At(0), At(100), out, 10));
+  EXPECT_EQ(10000000, out[0].start.inMicros());
+  EXPECT_EQ(2u, out[0].count);
+  EXPECT_EQ(20.0f, out[0].min.degCelcius());
+  EXPECT_EQ(22.0f, out[0].max.degCelcius());
+  EXPECT_EQ(21.0f, out[0].mean.degCelcius());
+  // A bucket without samples.
+  EXPECT_EQ(0u, out[1].count);
+  EXPECT_TRUE(out[1].mean.isUnknown());
+  EXPECT_EQ(1u, out[2].count);
+  EXPECT_EQ(25.0f, out[2].mean.degCelcius());
+  // Limited by the output size.
+  EXPECT_EQ(2u, history.query(0, At(0), At(100), out, 2));
+}
+
+TEST(RollupHistory, Cascade) {
+  History history = MakeHistory();
+  // Two hours and a bit, one sample per second: the temperature is the
+  // minute of the hour.
+  for (int64_t s = 0; s < 2 * 3600 + 90; ++s) {
+    history.add(At(s), TemperatureDegCelcius((s / 60) % 60));
+  }
+  Rollup<Temperature> minutes[60];
+  ASSERT_EQ(60u, history.query(1, At(0), At(3 * 3600), minutes, 60));
+  // The last 60 minutes: 1:31 to 2:01 (2:01 still in progress).
+  EXPECT_EQ((2 * 60 + 1 - 59) * 60000000LL, minutes[0].start.inMicros());
+  EXPECT_EQ(60u, minutes[0].count);
+  EXPECT_EQ(2.0f, minutes[0].mean.degCelcius());
+  EXPECT_EQ(30u, minutes[59].count);
+  EXPECT_EQ(1.0f, minutes[59].mean.degCelcius());
+
+  Rollup<Temperature> hours[3];
+  ASSERT_EQ(3u, history.query(2, At(0), At(3 * 3600), hours, 3));
+  EXPECT_EQ(3600u, hours[0].count);
+  EXPECT_EQ(0.0f, hours[0].min.degCelcius());
+  EXPECT_EQ(59.0f, hours[0].max.degCelcius());
+  EXPECT_FLOAT_EQ(29.5f, hours[0].mean.degCelcius());
+  EXPECT_EQ(3600u, hours[1].count);
+  // The hour in progress includes the samples not yet cascaded.
+  EXPECT_EQ(90u, hours[2].count);
+  EXPECT_EQ(0.0f, hours[2].min.degCelcius());
+  EXPECT_EQ(1.0f, hours[2].max.degCelcius());
+}
+
+TEST(RollupHistory, Summary) {
+  History history = MakeHistory();
+  for (int64_t s = 0; s < 3 * 3600; ++s) {
+    history.add(At(s), TemperatureDegCelcius(s < 3600 ? 10.0f : 20.0f));
+  }
+  // The last minute: from the seconds level.
+  Rollup<Temperature> summary = history.summary(At(3 * 3600 - 60),
+                                                At(3 * 3600));
+  EXPECT_EQ(60u, summary.count);
+  EXPECT_EQ(20.0f, summary.mean.degCelcius());
+  // The whole history: from the hours level.
+  summary = history.summary(At(0), At(3 * 3600));
+  EXPECT_EQ(3u * 3600, summary.count);
+  EXPECT_EQ(10.0f, summary.min.degCelcius());
+  EXPECT_EQ(20.0f, summary.max.degCelcius());
+  EXPECT_NEAR(50.0f / 3.0f, summary.mean.degCelcius(), 1e-3f);
+}
+
+TEST(RollupHistory, Gaps) {
+  History history = MakeHistory();
+  history.add(At(5), TemperatureDegCelcius(1.0f));
+  // Silent for over a day.
+  history.add(At(100000), TemperatureDegCelcius(2.0f));
+  Rollup<Temperature> out[60];
+  size_t n = history.query(0, At(0), At(200000), out, 60);
+  ASSERT_EQ(60u, n);
+  EXPECT_EQ(0u, out[0].count);
+  EXPECT_EQ(1u, out[59].count);
+  EXPECT_EQ(2.0f, out[59].mean.degCelcius());
+  n = history.query(2, At(0), At(200000), out, 60);
+  ASSERT_EQ(28u, n);
+  EXPECT_EQ(1u, out[0].count);
+  EXPECT_EQ(1.0f, out[0].mean.degCelcius());
+  EXPECT_EQ(0u, out[1].count);
+  EXPECT_EQ(1u, out[27].count);
+  EXPECT_EQ(2.0f, out[27].mean.degCelcius());
+}
+
+TEST(RollupHistory, Clear) {
+  RollupHistory<Pressure, 1, 4> history({roo_time::Seconds(10)});
+  history.add(At(0), PressureInPascals(100.0f));
+  history.clear();
+  history.add(At(1000), PressureInPascals(200.0f));
+  Rollup<Pressure> out[4];
+  ASSERT_EQ(1u, history.query(0, At(0), At(2000), out, 4));
+  EXPECT_EQ(200.0f, out[0].mean.inPascals());
+  EXPECT_EQ(10000000, history.resolution(0).inMicros());
+}
+
+}  // namespace roo_quantity
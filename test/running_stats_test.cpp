@@ -0,0 +1,117 @@
+#include "roo_quantity/running_stats.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/area.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/temperature.h"
+
+namespace roo_quantity {
+
+TEST(RunningStats, Empty) {
+  RunningStats<Length> stats;
+  EXPECT_EQ(0u, stats.count());
+  EXPECT_TRUE(stats.mean().isUnknown());
+  EXPECT_TRUE(stats.min().isUnknown());
+  EXPECT_TRUE(stats.max().isUnknown());
+  EXPECT_TRUE(stats.variance().isUnknown());
+  EXPECT_TRUE(stats.populationVariance().isUnknown());
+  EXPECT_TRUE(stats.stddev().isUnknown());
+  stats.add(UnknownLength());
+  EXPECT_EQ(0u, stats.count());
+  stats.add(LengthInMeters(3.0f));
+  EXPECT_EQ(LengthInMeters(3.0f), stats.mean());
+  EXPECT_TRUE(stats.stddev().isUnknown());
+  EXPECT_EQ(0.0f, stats.populationVariance().inSquareMeters());
+}
+
+TEST(RunningStats, Basic) {
+  RunningStats<Length> stats;
+  for (float x : {2.0f, 4.0f, 4.0f, 4.0f, 5.0f, 5.0f, 7.0f, 9.0f}) {
+    stats.add(LengthInMeters(x));
+    stats.add(UnknownLength());
+  }
+  EXPECT_EQ(8u, stats.count());
+  EXPECT_EQ(LengthInMeters(5.0f), stats.mean());
+  EXPECT_EQ(LengthInMeters(2.0f), stats.min());
+  EXPECT_EQ(LengthInMeters(9.0f), stats.max());
+  Area variance = stats.variance();
+  EXPECT_FLOAT_EQ(32.0f / 7.0f, variance.inSquareMeters());
+  EXPECT_FLOAT_EQ(4.0f, stats.populationVariance().inSquareMeters());
+  EXPECT_FLOAT_EQ(std::sqrt(32.0f / 7.0f), stats.stddev().inMeters());
+  stats.reset();
+  EXPECT_EQ(0u, stats.count());
+}
+
+TEST(RunningStats, Temperature) {
+  RunningStats<Temperature> stats;
+  stats.add(TemperatureDegCelcius(20.0f));
+  stats.add(TemperatureDegCelcius(22.0f));
+  stats.add(UnknownTemperature());
+  Temperature mean = stats.mean();
+  TemperatureDelta stddev = stats.stddev();
+  EXPECT_EQ(TemperatureDegCelcius(21.0f), mean);
+  EXPECT_FLOAT_EQ(std::sqrt(2.0f), stddev.degCelcius());
+  EXPECT_FLOAT_EQ(std::sqrt(2.0f) * 1.8f, stddev.degFahrenheit());
+
+  // Deltas are ordinary quantities.
+  RunningStats<TemperatureDelta> deltas;
+  deltas.add(TemperatureDeltaDegCelcius(-1.0f));
+  deltas.add(TemperatureDeltaDegCelcius(1.0f));
+  EXPECT_EQ(TemperatureDeltaDegCelcius(0.0f), deltas.mean());
+}
+
+TEST(RunningStats, MatchesSummarize) {
+  std::vector<float> values;
+  uint32_t seed = 7;
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    values.push_back(i % 97 == 0 ? NAN
+                                 : 101325.0f + (float)(seed >> 16) * 0.01f);
+  }
+  QuantitySpan<const Pressure> span(values.data(), values.size());
+  RunningStats<Pressure> stats;
+  stats.addAll(span);
+  Summary<Pressure> summary = Summarize(span);
+  EXPECT_EQ(summary.count, stats.count());
+  EXPECT_EQ(summary.min, stats.min());
+  EXPECT_EQ(summary.max, stats.max());
+  EXPECT_NEAR(summary.mean.inPascals(), stats.mean().inPascals(), 0.05f);
+  EXPECT_NEAR(summary.stddev.inPascals(), stats.stddev().inPascals(), 0.05f);
+}
+
+TEST(RunningStats, Merge) {
+  RunningStats<Pressure> all, even, odd, empty;
+  for (int i = 0; i < 1000; ++i) {
+    Pressure p = PressureInHectoPascals(1000.0f + (float)(i % 37));
+    all.add(p);
+    (i % 2 == 0 ? even : odd).add(p);
+  }
+  RunningStats<Pressure> merged = even;
+  merged.merge(odd);
+  merged.merge(empty);
+  EXPECT_EQ(all.count(), merged.count());
+  EXPECT_EQ(all.min(), merged.min());
+  EXPECT_EQ(all.max(), merged.max());
+  EXPECT_FLOAT_EQ(all.mean().inPascals(), merged.mean().inPascals());
+  EXPECT_NEAR(all.stddev().inPascals(), merged.stddev().inPascals(), 0.01f);
+
+  empty.merge(all);
+  EXPECT_EQ(all.count(), empty.count());
+  EXPECT_EQ(all.mean(), empty.mean());
+}
+
+TEST(RunningStats, DoublePrecision) {
+  RunningStats<DoubleLength> stats;
+  stats.add(DoubleLengthInKilometers(1000.0));
+  stats.add(DoubleLengthInKilometers(1000.0) + LengthInMillimeters(2.0f));
+  EXPECT_NEAR(1.0, (stats.mean() - DoubleLengthInKilometers(1000.0))
+                       .inMillimeters(),
+              1e-6);
+}
+
+}  // namespace roo_quantity
@@ -0,0 +1,138 @@
+#include "roo_quantity/sample_store.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/statistics.h"
+#include "roo_quantity/temperature.h"
+#include "roo_quantity/voltage.h"
+
+namespace roo_quantity {
+
+namespace {
+
+roo_time::Uptime At(int64_t micros) {
+  return roo_time::Uptime::Start() + roo_time::Micros(micros);
+}
+
+struct Collected {
+  std::vector<int64_t> micros;
+  std::vector<float> volts;
+};
+
+template <typename Store>
+Collected Collect(const Store& store, int64_t from, int64_t to) {
+  Collected result;
+  store.forEach(At(from), At(to), [&](roo_time::Uptime t, const Voltage& v) {
+    result.micros.push_back(t.inMicros());
+    result.volts.push_back(v.inVolts());
+  });
+  return result;
+}
+
+}  // namespace
+
+static_assert(sizeof(Sample<Voltage>) == 8, "");
+static_assert(sizeof(Sample<Temperature>) == 8, "");
+
+TEST(Sample, Time) {
+  roo_time::Uptime base = At(5000000000LL);
+  Sample<Voltage> sample(base, At(5000001234LL), VoltageInVolts(3.3f));
+  EXPECT_EQ(1234u, sample.offset);
+  EXPECT_EQ(5000001234LL, sample.time(base).inMicros());
+  EXPECT_EQ(3.3f, sample.value.inVolts());
+  EXPECT_TRUE(Sample<Voltage>().value.isUnknown());
+}
+
+TEST(SampleStore, Empty) {
+  SampleStore<Voltage, 4, 3> store;
+  EXPECT_TRUE(store.empty());
+  EXPECT_EQ(0u, store.size());
+  EXPECT_TRUE(Collect(store, 0, 1000).micros.empty());
+}
+
+TEST(SampleStore, RangeQuery) {
+  SampleStore<Voltage, 4, 3> store;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(store.append(At(1000 + i * 100), VoltageInVolts(i)));
+  }
+  EXPECT_EQ(10u, store.size());
+  // Spans three blocks.
+  Collected c = Collect(store, 1250, 1750);
+  EXPECT_EQ((std::vector<int64_t>{1300, 1400, 1500, 1600, 1700}), c.micros);
+  EXPECT_EQ((std::vector<float>{3, 4, 5, 6, 7}), c.volts);
+  EXPECT_EQ(10u, Collect(store, 0, 5000).micros.size());
+  EXPECT_TRUE(Collect(store, 2000, 3000).micros.empty());
+  EXPECT_TRUE(Collect(store, 1710, 1790).micros.empty());
+
+  Sample<Voltage> samples[8];
+  ASSERT_EQ(3u, store.query(At(1300), At(2000), samples, 3));
+  EXPECT_EQ(0u, samples[0].offset);
+  EXPECT_EQ(200u, samples[2].offset);
+  EXPECT_EQ(5.0f, samples[2].value.inVolts());
+}
+
+TEST(SampleStore, Runs) {
+  SampleStore<Voltage, 4, 3> store;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(store.append(At(i * 100), VoltageInVolts(i)));
+  }
+  std::vector<size_t> sizes;
+  float sum = 0.0f;
+  store.forEachRun(At(150), At(850), [&](QuantitySpan<const Voltage> run) {
+    sizes.push_back(run.size());
+    sum += Sum(run).inVolts();
+  });
+  EXPECT_EQ((std::vector<size_t>{2, 4, 1}), sizes);
+  EXPECT_EQ(2.0f + 3 + 4 + 5 + 6 + 7 + 8, sum);
+}
+
+TEST(SampleStore, DropsOldestBlock) {
+  SampleStore<Voltage, 4, 3> store;
+  for (int i = 0; i < 14; ++i) {
+    ASSERT_TRUE(store.append(At(i), VoltageInVolts(i)));
+  }
+  // Blocks: [8..11], [12, 13]; and [4..7], the oldest retained.
+  EXPECT_EQ(10u, store.size());
+  Collected c = Collect(store, 0, 100);
+  ASSERT_EQ(10u, c.micros.size());
+  EXPECT_EQ(4, c.micros.front());
+  EXPECT_EQ(13, c.micros.back());
+}
+
+TEST(SampleStore, LongGaps) {
+  SampleStore<Voltage, 100, 4> store;
+  ASSERT_TRUE(store.append(At(0), VoltageInVolts(1.0f)));
+  // More than 2^32 microseconds later: starts a new block.
+  ASSERT_TRUE(store.append(At(5000000000LL), VoltageInVolts(2.0f)));
+  ASSERT_TRUE(store.append(At(5000000001LL), VoltageInVolts(3.0f)));
+  Collected c = Collect(store, 0, 6000000000LL);
+  EXPECT_EQ((std::vector<int64_t>{0, 5000000000LL, 5000000001LL}), c.micros);
+  EXPECT_EQ((std::vector<float>{1, 2, 3}), c.volts);
+}
+
+TEST(SampleStore, RejectsOutOfOrder) {
+  SampleStore<Voltage, 4, 2> store;
+  ASSERT_TRUE(store.append(At(100), VoltageInVolts(1.0f)));
+  EXPECT_FALSE(store.append(At(99), VoltageInVolts(2.0f)));
+  EXPECT_TRUE(store.append(At(100), VoltageInVolts(3.0f)));
+  EXPECT_EQ(2u, store.size());
+  store.clear();
+  EXPECT_TRUE(store.empty());
+  EXPECT_TRUE(store.append(At(0), VoltageInVolts(4.0f)));
+}
+
+TEST(SampleStore, Temperature) {
+  SampleStore<Temperature, 8, 2> store;
+  store.append(At(0), TemperatureDegCelcius(21.5f));
+  store.append(At(1), Temperature());
+  std::vector<Temperature> out;
+  store.forEach(At(0), At(2), [&](roo_time::Uptime, const Temperature& t) {
+    out.push_back(t);
+  });
+  ASSERT_EQ(2u, out.size());
+  EXPECT_EQ(21.5f, out[0].degCelcius());
+  EXPECT_TRUE(out[1].isUnknown());
+}
+
+}  // namespace roo_quantity
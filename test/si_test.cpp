@@ -1,5 +1,7 @@
 #include "roo_quantity/si.h"
 
+#include <limits>
+
 #include "gtest/gtest.h"
 
 namespace roo_quantity {
@@ -73,4 +75,68 @@ TEST(Si, FormatSimpleValueInf) {
   EXPECT_STREQ("-∞ A", out);
 }
 
-}  // namespace roo_quantity
\ No newline at end of file
+TEST(Si, FormatSimpleValueRounding) {
+  char out[64];
+  FormatSimpleSiValue(999.9996f, "V", out, 64);
+  EXPECT_STREQ("1000 V", out);
+
+  FormatSimpleSiValue(0.33333333f, "V", out, 64);
+  EXPECT_STREQ("333.333 mV", out);
+
+  FormatSimpleSiValue(3e30f, "W", out, 64);
+  EXPECT_STREQ("3e+15 PW", out);
+
+  FormatSimpleSiValue(2e-20f, "F", out, 64);
+  EXPECT_STREQ("2e-08 pF", out);
+}
+
+TEST(Si, FormatSimpleValueTruncates) {
+  char out[6];
+  FormatSimpleSiValue(0.0324f, "A", out, 6);
+  EXPECT_STREQ("32.4 ", out);
+}
+
+TEST(Si, FormatFixedValue) {
+  char out[64];
+  FormatFixedSiValue(0, -6, "A", out, 64);
+  EXPECT_STREQ("0 A", out);
+
+  FormatFixedSiValue(32400, -6, "A", out, 64);
+  EXPECT_STREQ("32.4 mA", out);
+
+  FormatFixedSiValue(-12433, -1, "V", out, 64);
+  EXPECT_STREQ("-1.2433 kV", out);
+
+  FormatFixedSiValue(22, -13, "F", out, 64);
+  EXPECT_STREQ("2.2 pF", out);
+
+  FormatFixedSiValue(543, 8, "J", out, 64);
+  EXPECT_STREQ("54.3 GJ", out);
+
+  FormatFixedSiValue(std::numeric_limits<int64_t>::min(), -6, "A", out, 64);
+  EXPECT_STREQ("? A", out);
+
+  FormatFixedSiValue(std::numeric_limits<int64_t>::max(), -6, "J", out, 64);
+  EXPECT_STREQ("9.22337 TJ", out);
+
+  // Beyond the smallest and the largest prefix.
+  FormatFixedSiValue(5, -15, "F", out, 64);
+  EXPECT_STREQ("0.005 pF", out);
+  FormatFixedSiValue(2, 18, "J", out, 64);
+  EXPECT_STREQ("2000 PJ", out);
+}
+
+TEST(Si, FormatFixedValueRounding) {
+  char out[64];
+  // Ties round to even.
+  FormatFixedSiValue(1234565, -6, "V", out, 64);
+  EXPECT_STREQ("1.23456 V", out);
+  FormatFixedSiValue(1234575, -6, "V", out, 64);
+  EXPECT_STREQ("1.23458 V", out);
+
+  // The prefix is chosen before rounding, as in FormatSimpleSiValue.
+  FormatFixedSiValue(9999996, -4, "V", out, 64);
+  EXPECT_STREQ("1000 V", out);
+}
+
+}  // namespace roo_quantity
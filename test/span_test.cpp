@@ -0,0 +1,196 @@
+#include "roo_quantity/span.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/capacitance.h"
+#include "roo_quantity/charge.h"
+#include "roo_quantity/current.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/power.h"
+#include "roo_quantity/pressure.h"
+#include "roo_quantity/resistance.h"
+#include "roo_quantity/voltage.h"
+#include "roo_quantity/volume.h"
+
+namespace roo_quantity {
+namespace {
+
+uint32_t Bits(float f) {
+  uint32_t b;
+  memcpy(&b, &f, sizeof(b));
+  return b;
+}
+
+// Values of widely varying magnitudes, including unknown, zero, and negative
+// zero. An odd count exercises the scalar tails of the vector kernels.
+std::vector<float> TestValues() {
+  std::vector<float> values = {0.0f, -0.0f, internal::kUnknownValue};
+  uint32_t seed = 1;
+  for (int i = 0; i < 997; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    float mantissa = (float)(int32_t)seed / 2147483648.0f;
+    values.push_back(mantissa * (float)(1 << (i % 24)) / (float)(1 << 12));
+  }
+  return values;
+}
+
+template <auto Accessor, typename Q>
+void ExpectSameAsScalar(const std::vector<float>& raw) {
+  std::vector<float> in = raw;
+  QuantitySpan<Q> span(in.data(), in.size());
+  std::vector<float> out(in.size());
+  ConvertTo<Accessor>(span, out.data());
+  for (size_t i = 0; i < in.size(); ++i) {
+    EXPECT_EQ(Bits((span[i].*Accessor)()), Bits(out[i])) << raw[i];
+  }
+}
+
+template <auto Factory>
+void ExpectSameAsScalarFrom(const std::vector<float>& in) {
+  using Q = decltype(Factory(0.0f));
+  std::vector<Q> out(in.size());
+  ConvertFrom<Factory>(in.data(), QuantitySpan<Q>(out.data(), out.size()));
+  for (size_t i = 0; i < in.size(); ++i) {
+    Q expected = Factory(in[i]);
+    EXPECT_EQ(Bits(internal::RawTraits<Q>::ToRaw(expected)),
+              Bits(internal::RawTraits<Q>::ToRaw(out[i])))
+        << in[i];
+  }
+}
+
+}  // namespace
+
+TEST(QuantitySpan, Access) {
+  Length lengths[3] = {LengthInMeters(1.0f), LengthInMeters(2.0f),
+                       UnknownLength()};
+  QuantitySpan<Length> span(lengths);
+  EXPECT_EQ(3u, span.size());
+  EXPECT_EQ(2.0f, span.data()[1]);
+  EXPECT_EQ(LengthInMeters(2.0f), span[1]);
+  EXPECT_TRUE(span[2].isUnknown());
+  span.set(0, LengthInCentimeters(50.0f));
+  EXPECT_EQ(LengthInCentimeters(50.0f), lengths[0]);
+
+  QuantitySpan<const Length> view = span;
+  EXPECT_EQ(LengthInCentimeters(50.0f), view[0]);
+  EXPECT_EQ(1u, view.subspan(1, 1).size());
+  EXPECT_EQ(LengthInMeters(2.0f), view.subspan(1, 1)[0]);
+  EXPECT_TRUE(QuantitySpan<Length>().empty());
+}
+
+TEST(QuantitySpan, ConvertToMatchesScalar) {
+  std::vector<float> values = TestValues();
+  ExpectSameAsScalar<&Length::inMillimeters, Length>(values);
+  ExpectSameAsScalar<&Length::inMeters, Length>(values);
+  ExpectSameAsScalar<&Length::inInches, Length>(values);
+  ExpectSameAsScalar<&Pressure::inBars, Pressure>(values);
+  ExpectSameAsScalar<&Volume::inCubicMicrometers, Volume>(values);
+  ExpectSameAsScalar<&Temperature::degCelcius, Temperature>(values);
+  ExpectSameAsScalar<&Temperature::degKelvin, Temperature>(values);
+  ExpectSameAsScalar<&Temperature::degFahrenheit, Temperature>(values);
+}
+
+TEST(QuantitySpan, ConvertFromMatchesScalar) {
+  std::vector<float> values = TestValues();
+  ExpectSameAsScalarFrom<&LengthInMillimeters>(values);
+  ExpectSameAsScalarFrom<&LengthInFeet>(values);
+  ExpectSameAsScalarFrom<&PressureInHectoPascals>(values);
+  ExpectSameAsScalarFrom<&TemperatureDegCelcius>(values);
+  ExpectSameAsScalarFrom<&TemperatureDegKelvin>(values);
+  // Not of the form x * scale + offset; takes the scalar path.
+  ExpectSameAsScalarFrom<&TemperatureDegFahrenheit>(values);
+}
+
+TEST(QuantitySpan, AffineFit) {
+  constexpr internal::AffineFit mm = internal::FitAffine(
+      [](float x) { return LengthInMeters(x).inMillimeters(); });
+  static_assert(mm.exact && mm.scale == 1000.0f && mm.offset == 0.0f, "");
+  constexpr internal::AffineFit fahrenheit = internal::FitAffine(
+      [](float x) { return TemperatureDegCelcius(x).degFahrenheit(); });
+  static_assert(fahrenheit.exact && fahrenheit.scale == 1.8f &&
+                    fahrenheit.offset == 32.0f,
+                "");
+  constexpr internal::AffineFit from_fahrenheit = internal::FitAffine(
+      [](float x) { return TemperatureDegFahrenheit(x).degCelcius(); });
+  static_assert(!from_fahrenheit.exact, "");
+}
+
+TEST(QuantitySpan, InPlace) {
+  std::vector<float> values = {1.0f, 2.5f, -3.0f, 4.0f, 5.0f};
+  ConvertFrom<&LengthInKilometers>(
+      values.data(), QuantitySpan<Length>(values.data(), values.size()));
+  EXPECT_EQ(2500.0f, values[1]);
+  ConvertTo<&Length::inKilometers>(
+      QuantitySpan<const Length>(values.data(), values.size()),
+      values.data());
+  EXPECT_FLOAT_EQ(-3.0f, values[2]);
+}
+
+TEST(QuantitySpan, CrossQuantityMatchesScalar) {
+  std::vector<float> u = TestValues();
+  std::vector<float> i = TestValues();
+  std::reverse(i.begin(), i.end());
+  size_t n = u.size();
+  QuantitySpan<const Voltage> voltage(u.data(), n);
+  QuantitySpan<const Current> current(i.data(), n);
+  std::vector<float> p(n), r(n), q(n);
+  Multiply(voltage, current, QuantitySpan<Power>(p.data(), n));
+  Divide(voltage, current, QuantitySpan<Resistance>(r.data(), n));
+  Multiply(QuantitySpan<const Capacitance>(i.data(), n), voltage,
+           QuantitySpan<Charge>(q.data(), n));
+  for (size_t k = 0; k < n; ++k) {
+    EXPECT_EQ(Bits((voltage[k] * current[k]).inWatts()), Bits(p[k]));
+    EXPECT_EQ(Bits((voltage[k] / current[k]).inOhms()), Bits(r[k]));
+    EXPECT_EQ(Bits((Capacitance::FromSiUnits(i[k]) * voltage[k]).inCoulombs()),
+              Bits(q[k]));
+  }
+  // Unknown operands, and division by zero.
+  EXPECT_TRUE(std::isnan(p[2]));
+  EXPECT_TRUE(std::isnan(r[n - 3]));
+  EXPECT_TRUE(std::isinf(r[n - 1]));
+}
+
+TEST(QuantitySpan, CrossQuantityBroadcast) {
+  std::vector<float> u = TestValues();
+  size_t n = u.size();
+  QuantitySpan<const Voltage> voltage(u.data(), n);
+  Resistance load = ResistanceInKiloOhms(4.7f);
+  std::vector<float> i(n), p(n);
+  Divide(voltage, load, QuantitySpan<Current>(i.data(), n));
+  Multiply(voltage, QuantitySpan<const Current>(i.data(), n),
+           QuantitySpan<Power>(p.data(), n));
+  std::vector<float> q(n);
+  Multiply(voltage, CapacitanceInMicroFarads(10.0f),
+           QuantitySpan<Charge>(q.data(), n));
+  for (size_t k = 0; k < n; ++k) {
+    Current expected = voltage[k] / load;
+    EXPECT_EQ(Bits(expected.inAmperes()), Bits(i[k]));
+    EXPECT_EQ(Bits((voltage[k] * expected).inWatts()), Bits(p[k]));
+    EXPECT_EQ(
+        Bits((voltage[k] * CapacitanceInMicroFarads(10.0f)).inCoulombs()),
+        Bits(q[k]));
+  }
+}
+
+TEST(QuantitySpan, CrossQuantityInPlace) {
+  Voltage u[] = {VoltageInVolts(3.0f), VoltageInVolts(5.0f)};
+  Current i[] = {CurrentInAmperes(2.0f), CurrentInAmperes(0.5f)};
+  float buf[2];
+  QuantitySpan<Power> p(buf, 2);
+  Multiply(QuantitySpan<const Voltage>(u), QuantitySpan<const Current>(i), p);
+  EXPECT_EQ(PowerInWatts(6.0f), p[0]);
+  // Reuse the power buffer for resistance, R = P / I^2.
+  Divide(QuantitySpan<const Power>(p), QuantitySpan<const Current>(i),
+         QuantitySpan<Voltage>(buf, 2));
+  Divide(QuantitySpan<const Voltage>(buf, 2), QuantitySpan<const Current>(i),
+         QuantitySpan<Resistance>(buf, 2));
+  EXPECT_EQ(ResistanceInOhms(1.5f), QuantitySpan<const Resistance>(buf, 2)[0]);
+  EXPECT_EQ(ResistanceInOhms(10.0f), QuantitySpan<const Resistance>(buf, 2)[1]);
+}
+
+}  // namespace roo_quantity
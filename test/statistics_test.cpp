@@ -0,0 +1,98 @@
+#include "roo_quantity/statistics.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "roo_quantity/area.h"
+#include "roo_quantity/length.h"
+#include "roo_quantity/pressure.h"
+
+namespace roo_quantity {
+
+TEST(Statistics, Basic) {
+  Length lengths[] = {LengthInMeters(2.0f), UnknownLength(),
+                      LengthInMeters(4.0f), LengthInMeters(4.0f),
+                      LengthInMeters(4.0f), LengthInMeters(5.0f),
+                      UnknownLength(),      LengthInMeters(5.0f),
+                      LengthInMeters(7.0f), LengthInMeters(9.0f)};
+  QuantitySpan<const Length> span(lengths);
+  EXPECT_EQ(8u, CountKnown(span));
+  EXPECT_EQ(LengthInMeters(2.0f), Min(span));
+  EXPECT_EQ(LengthInMeters(9.0f), Max(span));
+  EXPECT_EQ(LengthInMeters(40.0f), Sum(span));
+  EXPECT_EQ(LengthInMeters(5.0f), Mean(span));
+  Area variance = Variance(span);
+  EXPECT_FLOAT_EQ(32.0f / 7.0f, variance.inSquareMeters());
+  EXPECT_FLOAT_EQ(std::sqrt(32.0f / 7.0f), StdDev(span).inMeters());
+
+  Summary<Length> summary = Summarize(span);
+  EXPECT_EQ(8u, summary.count);
+  EXPECT_EQ(LengthInMeters(2.0f), summary.min);
+  EXPECT_EQ(LengthInMeters(9.0f), summary.max);
+  EXPECT_EQ(LengthInMeters(5.0f), summary.mean);
+  EXPECT_FLOAT_EQ(std::sqrt(32.0f / 7.0f), summary.stddev.inMeters());
+}
+
+TEST(Statistics, Empty) {
+  Pressure readings[] = {UnknownPressure(), UnknownPressure()};
+  QuantitySpan<Pressure> span(readings);
+  EXPECT_EQ(0u, CountKnown(span));
+  EXPECT_TRUE(Min(span).isUnknown());
+  EXPECT_TRUE(Max(span).isUnknown());
+  EXPECT_EQ(PressureInPascals(0.0f), Sum(span));
+  EXPECT_TRUE(Mean(span).isUnknown());
+  EXPECT_TRUE(StdDev(span).isUnknown());
+  EXPECT_TRUE(StdDev(QuantitySpan<Pressure>(readings, 1)).isUnknown());
+  EXPECT_TRUE(Summarize(span).mean.isUnknown());
+  EXPECT_TRUE(Mean(QuantitySpan<Pressure>()).isUnknown());
+}
+
+TEST(Statistics, Temperature) {
+  std::vector<Temperature> readings;
+  for (int i = 0; i < 1001; ++i) {
+    bool unknown = (i % 10 == 3 || i % 10 == 4);
+    readings.push_back(unknown ? UnknownTemperature()
+                               : TemperatureDegCelcius(20.0f + (i % 2)));
+  }
+  QuantitySpan<const Temperature> span(readings.data(), readings.size());
+  Temperature mean = Mean(span);
+  TemperatureDelta stddev = StdDev(span);
+  EXPECT_NEAR(20.5f, mean.degCelcius(), 0.01f);
+  EXPECT_NEAR(0.5f, stddev.degCelcius(), 0.01f);
+  EXPECT_EQ(TemperatureDegCelcius(20.0f), Min(span));
+  EXPECT_EQ(TemperatureDegCelcius(21.0f), Max(span));
+}
+
+TEST(Statistics, CompensatedSummation) {
+  // A naive float sum of ten million 0.1's is off by several percent.
+  std::vector<float> values(10000000, 0.1f);
+  QuantitySpan<const Pressure> span(values.data(), values.size());
+  EXPECT_NEAR(1000000.0f, Sum(span).inPascals(), 1.0f);
+  EXPECT_NEAR(0.1f, Mean(span).inPascals(), 1e-7f);
+  EXPECT_EQ(0.0f, StdDev(span).inPascals());
+
+  // Large offset, small spread.
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = 101325.0f + ((i % 2) ? 0.5f : -0.5f);
+  }
+  EXPECT_NEAR(101325.0f, Mean(span).inPascals(), 0.01f);
+  EXPECT_NEAR(0.5f, StdDev(span).inPascals(), 1e-4f);
+}
+
+TEST(Statistics, Tails) {
+  // Every length from 0 to 40, so that all the vector tails are exercised.
+  std::vector<float> values;
+  for (int n = 0; n < 40; ++n) {
+    QuantitySpan<const Length> span(values.data(), values.size());
+    EXPECT_EQ((size_t)n, CountKnown(span));
+    if (n > 0) {
+      EXPECT_EQ(LengthInMeters((float)(n - 1)), Max(span));
+      EXPECT_EQ(LengthInMeters(0.0f), Min(span));
+      EXPECT_FLOAT_EQ((float)(n - 1) / 2.0f, Mean(span).inMeters());
+    }
+    values.push_back((float)n);
+  }
+}
+
+}  // namespace roo_quantity
@@ -101,4 +101,25 @@ TEST(Temperature, String) {
   EXPECT_EQ("25°C", TemperatureDegCelcius(25.0f).asString());
 }
 
+TEST(Temperature, FormatTo) {
+  char out[16];
+  EXPECT_EQ(5u, TemperatureDegCelcius(25.0f).formatTo(out, 16));
+  EXPECT_STREQ("25°C", out);
+  EXPECT_EQ(4u, UnknownTemperature().formatTo(out, 16));
+  EXPECT_STREQ("?°C", out);
+  EXPECT_EQ(8u, TemperatureDeltaDegCelcius(-1.25f).formatTo(out, 16));
+  EXPECT_STREQ("-1.25°C", out);
+  EXPECT_EQ(3u, TemperatureDegCelcius(-12.5f).formatTo(out, 4));
+  EXPECT_STREQ("-12", out);
+}
+
+TEST(Temperature, ConstexprUnknown) {
+  constexpr Temperature kUnknown = UnknownTemperature();
+  constexpr TemperatureDelta kUnknownDelta = UnknownTemperatureDelta();
+  EXPECT_TRUE(kUnknown.isUnknown());
+  EXPECT_TRUE(kUnknownDelta.isUnknown());
+  Temperature readings[4];
+  for (const Temperature& t : readings) EXPECT_TRUE(t.isUnknown());
+}
+
 }  // namespace roo_quantity
\ No newline at end of file
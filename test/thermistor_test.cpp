@@ -0,0 +1,88 @@
+#include "roo_quantity/thermistor.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace roo_quantity {
+
+namespace {
+
+constexpr BetaThermistor kBeta(ResistanceInKiloOhms(10.0f),
+                               TemperatureDegCelcius(25.0f), 3950.0f);
+
+// Typical coefficients of a 10 kOhm NTC thermistor.
+constexpr SteinhartHartThermistor kSteinhartHart(1.009249522e-03f,
+                                                 2.378405444e-04f,
+                                                 2.019202697e-07f);
+
+constexpr ThermistorTable<67> kBetaTable(kBeta, TemperatureDegCelcius(-40.0f),
+                                         TemperatureDegCelcius(125.0f));
+
+constexpr ThermistorTable<34> kSteinhartHartTable(
+    kSteinhartHart, TemperatureDegCelcius(-40.0f),
+    TemperatureDegCelcius(125.0f));
+
+// The table is computed at compile time.
+static_assert(kBetaTable.temperature(ResistanceInKiloOhms(10.0f))
+                      .degCelcius() > 24.99f,
+              "");
+
+}  // namespace
+
+TEST(Thermistor, ConstexprExp) {
+  for (double x : {-30.0, -2.5, -0.1, 0.0, 0.3, 1.0, 7.7, 40.0}) {
+    EXPECT_NEAR(1.0, internal::ConstexprExp(x) / std::exp(x), 1e-14) << x;
+  }
+}
+
+TEST(Thermistor, Beta) {
+  EXPECT_NEAR(25.0f,
+              kBeta.temperature(ResistanceInKiloOhms(10.0f)).degCelcius(),
+              1e-4f);
+  // R(0 C) = 10k * exp(3950 * (1 / 273.15 - 1 / 298.15)).
+  EXPECT_NEAR(33621.0f,
+              kBeta.resistance(TemperatureDegCelcius(0.0f)).inOhms(), 1.0f);
+  EXPECT_NEAR(0.0f,
+              kBeta.temperature(ResistanceInOhms(33621.0f)).degCelcius(),
+              1e-3f);
+  EXPECT_TRUE(kBeta.temperature(UnknownResistance()).isUnknown());
+}
+
+TEST(Thermistor, SteinhartHart) {
+  for (float c = -40.0f; c <= 125.0f; c += 5.0f) {
+    Resistance r = kSteinhartHart.resistance(TemperatureDegCelcius(c));
+    EXPECT_NEAR(c, kSteinhartHart.temperature(r).degCelcius(), 1e-3f) << c;
+  }
+  // Close to the Beta model near 25 C.
+  EXPECT_NEAR(kBeta.resistance(TemperatureDegCelcius(25.0f)).inOhms(),
+              kSteinhartHart.resistance(TemperatureDegCelcius(25.0f)).inOhms(),
+              200.0f);
+}
+
+TEST(Thermistor, Table) {
+  float max_error = 0.0f;
+  for (float c = -40.0f; c <= 125.0f; c += 0.1f) {
+    Resistance r = kBeta.resistance(TemperatureDegCelcius(c));
+    float error = std::fabs(kBetaTable.temperature(r).degCelcius() -
+                            kBeta.temperature(r).degCelcius());
+    max_error = std::max(max_error, error);
+  }
+  EXPECT_LT(max_error, 0.07f);
+
+  max_error = 0.0f;
+  for (float c = -40.0f; c <= 125.0f; c += 0.1f) {
+    Resistance r = kSteinhartHart.resistance(TemperatureDegCelcius(c));
+    float error = std::fabs(kSteinhartHartTable.temperature(r).degCelcius() -
+                            kSteinhartHart.temperature(r).degCelcius());
+    max_error = std::max(max_error, error);
+  }
+  EXPECT_LT(max_error, 0.2f);
+
+  // Extrapolated outside of the range.
+  EXPECT_LT(kBetaTable.temperature(ResistanceInMegaOhms(1.0f)).degCelcius(),
+            -40.0f);
+  EXPECT_TRUE(kBetaTable.temperature(UnknownResistance()).isUnknown());
+}
+
+}  // namespace roo_quantity
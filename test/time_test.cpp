@@ -1,5 +1,8 @@
 #include "roo_quantity/time.h"
 
+#include <cstdint>
+#include <limits>
+
 #include "gtest/gtest.h"
 
 namespace roo_quantity {
@@ -89,4 +92,77 @@ TEST(Time, WithRooTime) {
   EXPECT_FLOAT_EQ(3.75f, t.inSeconds());
 }
 
+TEST(Time, FromDurationRoundsToNearest) {
+  // Compare against a correctly-rounded double reference, across magnitudes.
+  for (int64_t micros = 1; micros < (int64_t{1} << 60);
+       micros = micros * 3 + 7) {
+    for (int64_t m : {micros, -micros, micros + 1, micros * 2 + 1}) {
+      float expected = static_cast<float>(static_cast<double>(m) / 1000000.0);
+      EXPECT_EQ(expected, Time(roo_time::Micros(m)).inSeconds()) << m;
+    }
+  }
+  EXPECT_EQ(0.0f, Time(roo_time::Micros(0)).inSeconds());
+}
+
+TEST(Time, DurationRoundTrip) {
+  // Durations shorter than 16 s survive the round trip.
+  for (int64_t micros = -16000000; micros <= 16000000; micros += 999) {
+    EXPECT_EQ(micros, Time(roo_time::Micros(micros)).toDuration().inMicros())
+        << micros;
+  }
+  // Times of 16 s or more survive the round trip the other way.
+  for (float s = 16.0f; s < 1e9f; s = s * 1.01f + 0.37f) {
+    Time t = TimeInSeconds(s);
+    EXPECT_EQ(s, Time(t.toDuration()).inSeconds()) << s;
+    EXPECT_EQ(-s, Time((-t).toDuration()).inSeconds()) << s;
+  }
+  EXPECT_EQ(1500, TimeInMilliseconds(1.5f).toDuration().inMicros());
+  EXPECT_EQ(0, TimeInNanoseconds(499.0f).toDuration().inMicros());
+  EXPECT_EQ(1, TimeInNanoseconds(501.0f).toDuration().inMicros());
+  EXPECT_EQ(0, UnknownTime().toDuration().inMicros());
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(),
+            TimeInSeconds(1e30f).toDuration().inMicros());
+}
+
+TEST(Time, Elapsed) {
+  roo_time::Uptime start = roo_time::Uptime::Start();
+  roo_time::Uptime end = start + roo_time::Millis(2500);
+  EXPECT_EQ(2.5f, TimeElapsed(start, end).inSeconds());
+  EXPECT_EQ(-2.5f, TimeElapsed(end, start).inSeconds());
+  EXPECT_LE(0.0f, TimeSince(roo_time::Uptime::Now()).inSeconds());
+}
+
+TEST(DoubleTime, ToDuration) {
+  // A century, to the microsecond.
+  DoubleTime t = roo_time::Micros(3153600000000001);
+  EXPECT_EQ(3153600000000001, t.toDuration().inMicros());
+  EXPECT_EQ(0, UnknownDoubleTime().toDuration().inMicros());
+}
+
+TEST(DoubleTime, FromDurationIsCorrectlyRounded) {
+  EXPECT_EQ(0.1, DoubleTime(roo_time::Micros(100000)).inSeconds());
+  EXPECT_EQ(1e-6, DoubleTime(roo_time::Micros(1)).inSeconds());
+  EXPECT_EQ(-86400.000001,
+            DoubleTime(roo_time::Micros(-86400000001)).inSeconds());
+}
+
+TEST(DoubleTime, Precision) {
+  // After 30 days of uptime, float seconds have a resolution of 0.25 s.
+  DoubleTime uptime = roo_time::Hours(24 * 30);
+  uptime += roo_time::Millis(1);
+  EXPECT_DOUBLE_EQ(2592000.001, uptime.inSeconds());
+  EXPECT_NEAR(1.0, (uptime - DoubleTimeInHours(24 * 30)).inMilliseconds(),
+              1e-6);
+  EXPECT_DOUBLE_EQ(2592000001000.0, uptime.inMicroseconds());
+}
+
+TEST(DoubleTime, MixedPrecision) {
+  DoubleTime t = DoubleTimeInMinutes(1.0);
+  t += TimeInMilliseconds(500.0f);
+  EXPECT_DOUBLE_EQ(60.5, t.inSeconds());
+  EXPECT_FLOAT_EQ(60.5f, t.toFloat().inSeconds());
+  EXPECT_TRUE(TimeInSeconds(1.0f) < t);
+  EXPECT_EQ("60.5 s", t.asString());
+}
+
 }  // namespace roo_quantity
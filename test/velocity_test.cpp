@@ -105,4 +105,14 @@ TEST(Velocity, AsString) {
   EXPECT_EQ("0 m/s", VelocityInMetersPerSecond(0).asString());
 }
 
+TEST(Velocity, FromDuration) {
+  EXPECT_FLOAT_EQ(
+      2.5f,
+      VelocityFromDistance(LengthInMeters(5.0f), roo_time::Seconds(2))
+          .inMetersPerSecond());
+  EXPECT_FLOAT_EQ(
+      36.0f, VelocityFromDistance(LengthInMeters(100.0f), roo_time::Seconds(10))
+                 .inKilometersPerHour());
+}
+
 }  // namespace roo_quantity
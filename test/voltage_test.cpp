@@ -103,4 +103,14 @@ TEST(Voltage, AsString) {
   EXPECT_EQ("0 V", VoltageInVolts(0).asString());
 }
 
+TEST(Voltage, FormatTo) {
+  char out[16];
+  EXPECT_EQ(7u, VoltageInKiloVolts(15.5f).formatTo(out, 16));
+  EXPECT_STREQ("15.5 kV", out);
+  EXPECT_EQ(3u, UnknownVoltage().formatTo(out, 16));
+  EXPECT_STREQ("? V", out);
+  EXPECT_EQ(3u, VoltageInVolts(1.5f).formatTo(out, 4));
+  EXPECT_STREQ("1.5", out);
+}
+
 }  // namespace roo_quantity
@@ -1,6 +1,10 @@
 #include "roo_quantity/work.h"
 
+#include <cmath>
+
 #include "gtest/gtest.h"
+#include "roo_quantity/power.h"
+#include "roo_quantity/time.h"
 
 namespace roo_quantity {
 
@@ -76,4 +80,24 @@ TEST(Work, AsString) {
   EXPECT_EQ("-2 J", WorkInJoules(-2).asString());
 }
 
+TEST(DoubleWork, Accumulation) {
+  // Integrating a 1 W load, sampled every millisecond, for an hour.
+  Work step = PowerInWatts(1.0f) * TimeInMilliseconds(1.0f);
+  DoubleWork total = DoubleWorkInJoules(0.0);
+  Work float_total = WorkInJoules(0.0f);
+  for (int i = 0; i < 3600000; ++i) {
+    total += step;
+    float_total += step;
+  }
+  EXPECT_NEAR(3600.0, total.inJoules(), 0.001);
+  // Float accumulation drifts visibly.
+  EXPECT_GT(std::abs(float_total.inJoules() - 3600.0f), 1.0f);
+  EXPECT_EQ("3.6 kJ", total.asString());
+}
+
+TEST(DoubleWork, MixedPrecision) {
+  DoubleWork w = DoubleTime(TimeInSeconds(2.0f)) * PowerInWatts(1.5f);
+  EXPECT_DOUBLE_EQ(3.0, w.inJoules());
+}
+
 }  // namespace roo_quantity